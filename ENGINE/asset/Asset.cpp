@@ -2,15 +2,18 @@
 #include "controller_factory.hpp"
 #include "animation.hpp"
 #include "core/AssetsManager.hpp"
-#include "core/asset_list.hpp"
 #include "render/camera.hpp"
 #include "utils/light_utils.hpp"
 #include "asset/asset_types.hpp"
+#include "utils/frame_profiler.hpp"
+#include "render/composite_cache.hpp"
 #include <filesystem>
 #include <iostream>
 #include <random>
 #include <algorithm>
 #include <cmath>
+#include <mutex>
+#include <unordered_map>
 #include <SDL.h>
 
 namespace {
@@ -72,11 +75,7 @@ Asset::~Asset() {
         for (Asset* c : children) {
                 if (c && c->parent == this) c->parent = nullptr;
         }
-        clear_downscale_cache();
-        if (final_texture) {
-                SDL_DestroyTexture(final_texture);
-                final_texture = nullptr;
-        }
+        final_texture.reset();
 }
 
 Asset::Asset(const Asset& o)
@@ -115,17 +114,11 @@ Asset::Asset(const Asset& o)
 , spawn_method(o.spawn_method)
 , controller_(nullptr)
 , anim_(nullptr)
-, last_scaled_texture_(nullptr)
-, last_scaled_source_(nullptr)
-, last_scaled_w_(0)
-, last_scaled_h_(0)
-, last_scaled_camera_scale_(-1.0f)
 {
 }
 
 Asset& Asset::operator=(const Asset& o) {
         if (this == &o) return *this;
-        clear_downscale_cache();
         parent               = o.parent;
         info                 = o.info;
         current_animation    = o.current_animation;
@@ -161,11 +154,6 @@ Asset& Asset::operator=(const Asset& o) {
         spawn_method         = o.spawn_method;
         controller_.reset();
         anim_.reset();
-        last_scaled_texture_      = nullptr;
-        last_scaled_source_       = nullptr;
-        last_scaled_w_            = 0;
-        last_scaled_h_            = 0;
-        last_scaled_camera_scale_ = -1.0f;
         return *this;
 }
 
@@ -214,7 +202,7 @@ void Asset::finalize_setup() {
         NeighborSearchRadius = info->NeighborSearchRadius;
 }
 
-SDL_Texture* Asset::get_current_frame() const {
+const AtlasFrame* Asset::get_current_frame() const {
         if (!info) return nullptr;
         auto iti = info->animations.find(current_animation);
         if (iti == info->animations.end()) return nullptr;
@@ -233,12 +221,7 @@ SDL_Texture* Asset::get_current_frame() const {
 
 void Asset::update() {
     if (!info) return;
-
-    SDL_Point previous_pos = pos;
-
-    if (info->moving_asset) {
-        update_neighbor_lists(!neighbor_lists_initialized_);
-    }
+    PROFILE_SCOPE("Asset::update");
 
     if (controller_ && assets_) {
         if (Input* in = assets_->get_input()) {
@@ -271,11 +254,31 @@ void Asset::update() {
     if (!dead && anim_) {
         anim_->update();
     }
+}
+
+void Asset::think() {
+    if (!anim_) {
+        update();
+        return;
+    }
+    anim_->begin_think();
+    update();
+}
 
-    if (info->moving_asset) {
-        const bool moved = (pos.x != previous_pos.x || pos.y != previous_pos.y);
-        if (moved) {
-            update_neighbor_lists(true);
+void Asset::commit() {
+    if (anim_) anim_->commit();
+}
+
+void Asset::prepare_shared_reads() const {
+    if (!info) return;
+    static const AreaId kObstacleAreaIds[] = {
+        area_id("impassable_area"),
+        area_id("passability"),
+        area_id("collision_area"),
+};
+    for (AreaId id : kObstacleAreaIds) {
+        if (const Area* area = get_world_area(id)) {
+            area->get_bounds();
         }
     }
 }
@@ -331,103 +334,6 @@ void Asset::set_assets(Assets* a) {
             ControllerFactory cf(assets_);
             controller_ = cf.create_for_asset(this);
     }
-    neighbors.reset();
-    impassable_naighbors = nullptr;
-    neighbor_lists_initialized_ = false;
-    last_neighbor_origin_ = SDL_Point{ std::numeric_limits<int>::min(), std::numeric_limits<int>::min() };
-}
-
-AssetList* Asset::get_neighbors_list() { return neighbors.get(); }
-const AssetList* Asset::get_neighbors_list() const { return neighbors.get(); }
-AssetList* Asset::get_impassable_naighbors() { return impassable_naighbors; }
-const AssetList* Asset::get_impassable_naighbors() const { return impassable_naighbors; }
-
-void Asset::update_neighbor_lists(bool force_update) {
-    if (!assets_ || !info || !info->moving_asset) {
-        return;
-    }
-
-    AssetList* active = assets_->active_asset_list_.get();
-    if (!active) {
-        return;
-    }
-
-    auto base_filter = [this](const Asset* candidate) {
-        if (!candidate || candidate == this || !candidate->info) {
-            return false;
-        }
-        if (candidate->info->type == asset_types::texture) {
-            return false;
-        }
-        return true;
-    };
-
-    auto impassable_filter = [this](const Asset* candidate) {
-        if (!candidate || candidate == this || !candidate->info) {
-            return false;
-        }
-        if (candidate->info->type == asset_types::texture) {
-            return false;
-        }
-        return !candidate->info->passable;
-    };
-
-    const bool rebuild_neighbors = force_update || !neighbors;
-
-    if (!rebuild_neighbors && !force_update) {
-        if (neighbor_lists_initialized_ && last_neighbor_origin_.x == pos.x && last_neighbor_origin_.y == pos.y) {
-            // Nothing changed since last refresh.
-            return;
-        }
-    }
-
-    if (rebuild_neighbors) {
-        neighbors = std::make_unique<AssetList>(
-            *active,
-            this,
-            info->NeighborSearchRadius,
-            std::vector<std::string>{},
-            std::vector<std::string>{},
-            std::vector<std::string>{},
-            SortMode::ZIndexAsc,
-            base_filter);
-
-        if (neighbors) {
-            auto imp_child = std::make_unique<AssetList>(
-                *neighbors,
-                this,
-                info->NeighborSearchRadius,
-                std::vector<std::string>{},
-                std::vector<std::string>{},
-                std::vector<std::string>{},
-                SortMode::ZIndexAsc,
-                impassable_filter,
-                true /* inherit parent view */);
-            impassable_naighbors = imp_child.get();
-            neighbors->add_child(std::move(imp_child));
-        }
-    } else if (neighbors) {
-        neighbors->set_center(this);
-        neighbors->set_search_radius(info->NeighborSearchRadius);
-        neighbors->update();
-        if (!impassable_naighbors) {
-            auto imp_child = std::make_unique<AssetList>(
-                *neighbors,
-                this,
-                info->NeighborSearchRadius,
-                std::vector<std::string>{},
-                std::vector<std::string>{},
-                std::vector<std::string>{},
-                SortMode::ZIndexAsc,
-                impassable_filter,
-                true /* inherit parent view */);
-            impassable_naighbors = imp_child.get();
-            neighbors->add_child(std::move(imp_child));
-        }
-    }
-
-    last_neighbor_origin_ = pos;
-    neighbor_lists_initialized_ = true;
 }
 
 void Asset::set_z_index() {
@@ -444,7 +350,7 @@ void Asset::set_z_index() {
                 std::cerr << "[Asset::set_z_index] Exception: " << e.what() << "\n";
         }
         if (assets_ && z_index != old_z) {
-                assets_->mark_active_assets_dirty();
+                assets_->on_asset_z_changed(this);
         }
 }
 
@@ -455,21 +361,27 @@ void Asset::set_z_offset(int z) {
 }
 
 void Asset::set_flip() {
-	if (!info || !info->flipable) return;
 	std::mt19937 rng{ std::random_device{}() };
+	set_flip(rng);
+}
+
+void Asset::set_flip(std::mt19937& rng) {
+	if (!info || !info->flipable) return;
 	std::uniform_int_distribution<int> dist(0, 1);
 	flipped = (dist(rng) == 1);
 }
 
 void Asset::set_final_texture(SDL_Texture* tex) {
-        clear_downscale_cache();
-        if (final_texture) SDL_DestroyTexture(final_texture);
-        final_texture = tex;
-        if (tex) SDL_QueryTexture(tex, nullptr, nullptr, &cached_w, &cached_h);
-        else     cached_w = cached_h = 0;
+        set_final_texture(tex ? std::make_shared<CompositeTexture>(tex) : nullptr);
+}
+
+void Asset::set_final_texture(std::shared_ptr<CompositeTexture> tex) {
+        final_texture  = std::move(tex);
+        if (final_texture) SDL_QueryTexture(final_texture->texture, nullptr, nullptr, &cached_w, &cached_h);
+        else               cached_w = cached_h = 0;
 }
 
-SDL_Texture* Asset::get_final_texture() const { return final_texture; }
+SDL_Texture* Asset::get_final_texture() const { return final_texture ? final_texture->texture : nullptr; }
 int  Asset::get_shading_group() const { return shading_group; }
 bool Asset::is_shading_group_set() const { return shading_group_set; }
 
@@ -491,30 +403,37 @@ void Asset::add_static_light_source(LightSource* light, SDL_Point world, Asset*
 void Asset::set_render_player_light(bool value) { render_player_light = value; }
 bool Asset::get_render_player_light() const { return render_player_light; }
 
-Area Asset::get_area(const std::string& name) const {
-        if (!info) {
-                return Area(name);
-        }
+namespace {
+        std::mutex              g_area_id_mutex;
+        std::unordered_map<std::string, Asset::AreaId> g_area_ids;
+        std::vector<std::string> g_area_names;
 
-        Area* base = info->find_area(name);
-        if (!base) {
-                base = info->find_area(name + "_area");
-        }
-        if (!base) {
-                return Area(name);
+        std::string area_name_for(Asset::AreaId id) {
+                std::lock_guard<std::mutex> lock(g_area_id_mutex);
+                return g_area_names[id];
         }
+}
 
-        const auto& local_pts = base->get_points();
-        if (local_pts.empty()) {
-                return Area(base->get_name());
+Asset::AreaId Asset::area_id(const std::string& name) {
+        std::lock_guard<std::mutex> lock(g_area_id_mutex);
+        auto it = g_area_ids.find(name);
+        if (it != g_area_ids.end()) {
+                return it->second;
         }
+        const AreaId id = static_cast<AreaId>(g_area_names.size());
+        g_area_names.push_back(name);
+        g_area_ids.emplace(name, id);
+        return id;
+}
 
+void Asset::build_world_points(const Area& base, std::vector<SDL_Point>& out) const {
+        const auto& local_pts = base.get_points();
         const float scale_factor = (info->scale_factor > 0.0f) ? info->scale_factor : 1.0f;
         const int pivot_x = static_cast<int>(std::lround(info->original_canvas_width * scale_factor * 0.5f));
         const int pivot_y = static_cast<int>(std::lround(info->original_canvas_height * scale_factor));
 
-        std::vector<SDL_Point> world_pts;
-        world_pts.reserve(local_pts.size());
+        out.clear();
+        out.reserve(local_pts.size());
         for (const auto& lp : local_pts) {
                 int local_dx = lp.x - pivot_x;
                 if (flipped) {
@@ -522,33 +441,87 @@ Area Asset::get_area(const std::string& name) const {
                 }
                 const int world_x = pos.x + local_dx;
                 const int world_y = pos.y + (lp.y - pivot_y);
-                world_pts.push_back(SDL_Point{ world_x, world_y });
+                out.push_back(SDL_Point{ world_x, world_y });
         }
+}
 
+Area Asset::get_area(const std::string& name) const {
+        if (!info) {
+                return Area(name);
+        }
+
+        Area* base = info->find_area(name);
+        if (!base) {
+                base = info->find_area(name + "_area");
+        }
+        if (!base) {
+                return Area(name);
+        }
+
+        if (base->get_points().empty()) {
+                return Area(base->get_name());
+        }
+
+        std::vector<SDL_Point> world_pts;
+        build_world_points(*base, world_pts);
         return Area(base->get_name(), world_pts);
 }
 
-void Asset::deactivate() {
-        clear_downscale_cache();
-        if (final_texture) {
-                SDL_DestroyTexture(final_texture);
-                final_texture = nullptr;
+const Area* Asset::get_world_area(AreaId id) const {
+        if (!info) {
+                return nullptr;
         }
-}
 
-void Asset::clear_downscale_cache() {
-        for (auto& entry : downscale_cache_) {
-                if (entry.texture) {
-                        SDL_DestroyTexture(entry.texture);
-                        entry.texture = nullptr;
+        auto it = std::find_if(world_area_cache_.begin(), world_area_cache_.end(),
+                               [id](const WorldAreaCacheEntry& e) { return e.id == id; });
+        if (it == world_area_cache_.end()) {
+                world_area_cache_.push_back(WorldAreaCacheEntry{});
+                it = world_area_cache_.end() - 1;
+                it->id = id;
+        }
+        WorldAreaCacheEntry& entry = *it;
+
+        const bool shape_valid = entry.owner == info.get() &&
+                                 entry.revision == info->areas_revision &&
+                                 entry.flipped == flipped &&
+                                 entry.scale == info->scale_factor;
+        if (shape_valid) {
+                // Only write on change: warmed entries are read from several
+                // threads during the parallel think phase.
+                if (entry.pos.x != pos.x || entry.pos.y != pos.y) {
+                        if (entry.area) {
+                                // Pure translation: shift the cached points in place.
+                                entry.area->apply_offset(pos.x - entry.pos.x, pos.y - entry.pos.y);
+                        }
+                        entry.pos = pos;
                 }
+                return entry.area ? &*entry.area : nullptr;
+        }
+
+        entry.owner = info.get();
+        entry.revision = info->areas_revision;
+        entry.flipped = flipped;
+        entry.scale = info->scale_factor;
+        entry.pos = pos;
+        entry.area.reset();
+
+        const std::string name = area_name_for(id);
+        Area* base = info->find_area(name);
+        if (!base) {
+                base = info->find_area(name + "_area");
+        }
+        if (!base || base->get_points().empty()) {
+                return nullptr;
         }
-        downscale_cache_.clear();
-        last_scaled_texture_      = nullptr;
-        last_scaled_source_       = nullptr;
-        last_scaled_w_            = 0;
-        last_scaled_h_            = 0;
-        last_scaled_camera_scale_ = -1.0f;
+
+        std::vector<SDL_Point> world_pts;
+        build_world_points(*base, world_pts);
+        entry.area.emplace(base->get_name(), world_pts);
+        return &*entry.area;
+}
+
+void Asset::deactivate() {
+        final_texture.reset();
 }
 
 void Asset::set_hidden(bool state){ hidden = state; }
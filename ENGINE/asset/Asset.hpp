@@ -6,6 +6,8 @@
 #include <memory>
 #include <SDL.h>
 #include <limits>
+#include <cstdint>
+#include <optional>
 
 #include "utils/area.hpp"
 #include "asset_info.hpp"
@@ -20,7 +22,7 @@ class Input;
 class AnimationFrame;
 class AssetInfoUI;
 class RenderAsset;
-class AssetList;
+struct CompositeTexture;
 
 struct StaticLight {
     LightSource* source = nullptr;
@@ -31,7 +33,15 @@ struct StaticLight {
 class Asset {
 
 	public:
+    using AreaId = std::uint16_t;
+    static AreaId area_id(const std::string& name);
+
     Area get_area(const std::string& name) const;
+    // World-space copy of the named area (falling back to "<name>_area"), or
+    // nullptr when the asset has none. The result is cached per asset and is
+    // only rebuilt when pos, flipped, the scale or the info's areas change, so
+    // steady-state lookups do not allocate. Valid until the asset next changes.
+    const Area* get_world_area(AreaId id) const;
     Asset(std::shared_ptr<AssetInfo> info,
           const Area& spawn_area,
           SDL_Point start_pos,
@@ -47,7 +57,15 @@ class Asset {
     void finalize_setup();
 
     void update();
-    SDL_Texture* get_current_frame() const;
+    // Parallel half of a two-phase update: may run on a worker thread and
+    // only writes this asset; see AnimationUpdate::begin_think.
+    void think();
+    // Serial half: applies the moves, audio and removal think() recorded.
+    void commit();
+    // Fills the lazily built caches other assets read from this one during
+    // think() (world areas and their bounds), so the parallel phase only reads.
+    void prepare_shared_reads() const;
+    const AtlasFrame* get_current_frame() const;
     std::string get_current_animation() const;
     bool is_current_animation_locked_in_progress() const;
     bool is_current_animation_last_frame() const;
@@ -58,19 +76,20 @@ class Asset {
     void set_render_player_light(bool value);
     bool get_render_player_light() const;
     void set_z_offset(int z);
+    // Re-rolls `flipped` from the caller's generator (seeded map generation).
+    void set_flip(std::mt19937& rng);
     void set_shading_group(int x);
     bool is_shading_group_set() const;
     int  get_shading_group() const;
     class AnimationFrame* current_frame = nullptr;
     SDL_Texture* get_final_texture() const;
+    // Takes ownership of tex (nullptr forces the next render to recomposite).
     void set_final_texture(SDL_Texture* tex);
+    // Adopts a composite that may be shared with other assets.
+    void set_final_texture(std::shared_ptr<CompositeTexture> tex);
     void set_camera(camera* v) { window = v; }
     void set_assets(Assets* a);
     Assets* get_assets() const { return assets_; }
-    AssetList* get_neighbors_list();
-    const AssetList* get_neighbors_list() const;
-    AssetList* get_impassable_naighbors();
-    const AssetList* get_impassable_naighbors() const;
     void deactivate();
     int NeighborSearchRadius;
     void set_hidden(bool state);
@@ -84,6 +103,9 @@ class Asset {
     std::shared_ptr<AssetInfo> info;
     std::string current_animation;
     SDL_Point pos{0, 0};
+    // pos at the start of simulation tick prev_pos_tick, for render interpolation.
+    SDL_Point prev_pos{0, 0};
+    std::uint64_t prev_pos_tick = 0;
     int z_index = 0;
     int z_offset = 0;
     bool active = false;
@@ -120,31 +142,23 @@ class Asset {
     float frame_progress = 0.0f;
     int  shading_group = 0;
     bool shading_group_set = false;
-    SDL_Texture* final_texture = nullptr;
+    std::shared_ptr<CompositeTexture> final_texture;
     Assets* assets_ = nullptr;
     std::unique_ptr<AssetController>   controller_;
-    std::unique_ptr<AssetList> neighbors;
-    AssetList* impassable_naighbors = nullptr; // non-owning child of neighbors
-    SDL_Point last_neighbor_origin_{ std::numeric_limits<int>::min(), std::numeric_limits<int>::min() };
-    bool neighbor_lists_initialized_ = false;
-    void update_neighbor_lists(bool force_update);
-
-    struct DownscaleCacheEntry {
-        float        scale   = 1.0f;
-        int          width   = 0;
-        int          height  = 0;
-        SDL_Texture* texture = nullptr;
-};
 
-    void clear_downscale_cache();
+    struct WorldAreaCacheEntry {
+        AreaId             id       = 0;
+        const AssetInfo*   owner    = nullptr;
+        std::uint32_t      revision = 0;
+        SDL_Point          pos{0, 0};
+        bool               flipped  = false;
+        float              scale    = 1.0f;
+        std::optional<Area> area;
+};
 
-    std::vector<DownscaleCacheEntry> downscale_cache_;
+    void build_world_points(const Area& base, std::vector<SDL_Point>& out) const;
 
-    SDL_Texture* last_scaled_texture_      = nullptr;
-    SDL_Texture* last_scaled_source_       = nullptr;
-    int          last_scaled_w_            = 0;
-    int          last_scaled_h_            = 0;
-    float        last_scaled_camera_scale_ = -1.0f;
+    mutable std::vector<WorldAreaCacheEntry> world_area_cache_;
 };
 
 #endif
@@ -1,7 +1,6 @@
 #include "animation.hpp"
 #include "asset/asset_info.hpp"
-#include "utils/cache_manager.hpp"
-#include <SDL_image.h>
+#include "asset/frame_decoder.hpp"
 #include <SDL_mixer.h>
 #include <algorithm>
 #include <cstdint>
@@ -9,13 +8,8 @@
 #include <iostream>
 #include <memory>
 #include <unordered_map>
-namespace fs = std::filesystem;
 
 namespace {
-#if SDL_VERSION_ATLEAST(2,0,12)
-void apply_scale_mode(SDL_Texture* tex, const AssetInfo& info);
-#endif
-
 using AudioCache = std::unordered_map<std::string, std::weak_ptr<Mix_Chunk>>;
 
 AudioCache& get_audio_cache() {
@@ -45,16 +39,6 @@ std::shared_ptr<Mix_Chunk> load_audio_clip(const std::string& path) {
         cache[path] = chunk;
         return chunk;
 }
-
-#if SDL_VERSION_ATLEAST(2,0,12)
-void apply_scale_mode(SDL_Texture* tex, const AssetInfo& info) {
-        if (tex) {
-                SDL_SetTextureScaleMode(tex, info.smooth_scaling ? SDL_ScaleModeBest : SDL_ScaleModeNearest);
-        }
-}
-#else
-void apply_scale_mode(SDL_Texture*, const AssetInfo&) {}
-#endif
 }
 
 Animation::Animation() = default;
@@ -65,14 +49,12 @@ void Animation::load(const std::string& trigger,
                      const std::string& dir_path,
                      const std::string& root_cache,
                      float scale_factor,
-                     SDL_Renderer* renderer,
-                     SDL_Texture*& base_sprite,
+                     TextureAtlasBuilder& atlas,
                      int& scaled_sprite_w,
                      int& scaled_sprite_h,
                      int& original_canvas_width,
                      int& original_canvas_height)
 {
-        CacheManager cache;
         if (anim_json.contains("source")) {
                 const auto& s = anim_json["source"];
 		try {
@@ -135,25 +117,10 @@ void Animation::load(const std::string& trigger,
 	if (source.kind == "animation" && !source.name.empty()) {
 		auto it = info.animations.find(source.name);
 		if (it != info.animations.end()) {
-			const auto& src_frames = it->second.frames;
-			for (SDL_Texture* src : src_frames) {
-					if (!src) continue;
-					Uint32 fmt; int access, w, h;
-					if (SDL_QueryTexture(src, &fmt, &access, &w, &h) != 0) {
-								continue;
-					}
-					SDL_Texture* dst = SDL_CreateTexture(renderer, fmt, SDL_TEXTUREACCESS_TARGET, w, h);
-					if (!dst) continue;
-                                        SDL_SetTextureBlendMode(dst, SDL_BLENDMODE_BLEND);
-                                        apply_scale_mode(dst, info);
-					SDL_SetRenderTarget(renderer, dst);
-					SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
-					SDL_RenderClear(renderer);
-					SDL_Rect r{0, 0, w, h};
-					SDL_RendererFlip flip = flipped_source ? SDL_FLIP_HORIZONTAL : SDL_FLIP_NONE;
-					SDL_RenderCopyEx(renderer, src, nullptr, &r, 0.0, nullptr, flip);
-					SDL_SetRenderTarget(renderer, nullptr);
-					frames.push_back(dst);
+			// Aliases share the source's atlas regions; flipping is applied at draw time.
+			for (AtlasFrame f : it->second.frames) {
+					f.flipped = (f.flipped != flipped_source);
+					frames.push_back(f);
 			}
 			if (reverse_source) {
 					std::reverse(frames.begin(), frames.end());
@@ -162,100 +129,31 @@ void Animation::load(const std::string& trigger,
 	} else {
 		std::string src_folder   = dir_path + "/" + source.path;
 		std::string cache_folder = root_cache + "/" + trigger;
-		std::string meta_file    = cache_folder + "/metadata.json";
-		int expected_frames = 0;
-		int orig_w = 0, orig_h = 0;
-		while (true) {
-			std::string f = src_folder + "/" + std::to_string(expected_frames) + ".png";
-			if (!fs::exists(f)) break;
-			if (expected_frames == 0) {
-					if (SDL_Surface* s = IMG_Load(f.c_str())) {
-								orig_w = s->w;
-								orig_h = s->h;
-								SDL_FreeSurface(s);
-					}
-			}
-			++expected_frames;
+		DecodedFrames decoded;
+		auto pre = info.prefetched_frames.find(trigger);
+		if (pre != info.prefetched_frames.end()) {
+			decoded = std::move(pre->second);
+			info.prefetched_frames.erase(pre);
+		} else {
+			FrameDecoder::decode(FrameDecoder::Job{ src_folder, cache_folder, scale_factor, &decoded });
 		}
-		if (expected_frames == 0) return;
-		bool use_cache = false;
-		nlohmann::json meta;
-		if (cache.load_metadata(meta_file, meta)) {
-			if (meta.value("frame_count", -1) == expected_frames &&
-			meta.value("scale_factor", -1.0f) == scale_factor &&
-			meta.value("original_width", -1) == orig_w &&
-			meta.value("original_height", -1) == orig_h)
-			{
-					use_cache = true;
-			}
-		}
-		std::vector<SDL_Surface*> surfaces;
-		if (use_cache) {
-			use_cache = cache.load_surface_sequence(cache_folder, expected_frames, surfaces);
-		}
-		if (!use_cache) {
-			surfaces.clear();
-			for (int i = 0; i < expected_frames; ++i) {
-					std::string f = src_folder + "/" + std::to_string(i) + ".png";
-					int new_w = 0, new_h = 0;
-					SDL_Surface* scaled = cache.load_and_scale_surface(f, scale_factor, new_w, new_h);
-					if (!scaled) {
-								std::cerr << "[Animation] Failed to load or scale: " << f << "\n";
-								continue;
-					}
-					if (i == 0) {
-								original_canvas_width  = orig_w;
-								original_canvas_height = orig_h;
-								scaled_sprite_w = new_w;
-								scaled_sprite_h = new_h;
-					}
-					surfaces.push_back(scaled);
-			}
-			cache.save_surface_sequence(cache_folder, surfaces);
-			nlohmann::json new_meta;
-			new_meta["frame_count"]     = expected_frames;
-			new_meta["scale_factor"]    = scale_factor;
-			new_meta["original_width"]  = orig_w;
-			new_meta["original_height"] = orig_h;
-			cache.save_metadata(meta_file, new_meta);
+		if (decoded.surfaces.empty()) return;
+		if (decoded.rebuilt && decoded.scaled_w > 0) {
+			original_canvas_width  = decoded.original_w;
+			original_canvas_height = decoded.original_h;
+			scaled_sprite_w = decoded.scaled_w;
+			scaled_sprite_h = decoded.scaled_h;
 		}
+		std::vector<SDL_Surface*> surfaces = std::move(decoded.surfaces);
+		decoded.surfaces.clear();
 		for (SDL_Surface* surf : surfaces) {
-                        SDL_Texture* tex = cache.surface_to_texture(renderer, surf);
-                        SDL_FreeSurface(surf);
-                        if (!tex) {
-                                        std::cerr << "[Animation] Failed to create texture for '" << trigger << "'\n";
-                                        continue;
-                        }
-                        apply_scale_mode(tex, info);
-                        frames.push_back(tex);
+                        if (!surf) continue;
+                        AtlasFrame f;
+                        f.src = SDL_Rect{ 0, 0, surf->w, surf->h };
+                        f.flipped = flipped_source;
+                        f.slot = atlas.add(surf);
+                        frames.push_back(f);
                 }
-		if (flipped_source && !frames.empty()) {
-			std::vector<SDL_Texture*> flipped;
-			flipped.reserve(frames.size());
-			for (SDL_Texture* src : frames) {
-					if (!src) { flipped.push_back(nullptr); continue; }
-					Uint32 fmt; int access, w, h;
-					if (SDL_QueryTexture(src, &fmt, &access, &w, &h) != 0) {
-								flipped.push_back(nullptr);
-								continue;
-					}
-					SDL_Texture* dst = SDL_CreateTexture(renderer, fmt, SDL_TEXTUREACCESS_TARGET, w, h);
-					if (!dst) { flipped.push_back(nullptr); continue; }
-                                        SDL_SetTextureBlendMode(dst, SDL_BLENDMODE_BLEND);
-                                        SDL_SetRenderTarget(renderer, dst);
-                                        SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
-                                        SDL_RenderClear(renderer);
-                                        SDL_Rect r{0, 0, w, h};
-                                        SDL_RenderCopyEx(renderer, src, nullptr, &r, 0.0, nullptr, SDL_FLIP_HORIZONTAL);
-                                        SDL_SetRenderTarget(renderer, nullptr);
-                                        apply_scale_mode(dst, info);
-                                        flipped.push_back(dst);
-			}
-			for (SDL_Texture* t : frames) {
-					if (t) SDL_DestroyTexture(t);
-			}
-			frames.swap(flipped);
-		}
 		if (reverse_source && !frames.empty()) {
 			std::reverse(frames.begin(), frames.end());
 		}
@@ -332,9 +230,6 @@ void Animation::load(const std::string& trigger,
         }
         movment = !(total_dx == 0 && total_dy == 0);
         number_of_frames = static_cast<int>(frames.size());
-        if (trigger == "default" && !frames.empty()) {
-                base_sprite = frames[0];
-        }
 
         if (frames_data.size() < frames.size()) {
                 frames_data.resize(frames.size());
@@ -348,11 +243,21 @@ void Animation::load(const std::string& trigger,
         }
 }
 
-SDL_Texture* Animation::get_frame(const AnimationFrame* frame) const {
+void Animation::resolve_atlas(const std::vector<AtlasFrame>& slots) {
+        for (AtlasFrame& f : frames) {
+                if (f.slot < 0 || f.slot >= static_cast<int>(slots.size())) continue;
+                const AtlasFrame& packed = slots[static_cast<std::size_t>(f.slot)];
+                f.texture = packed.texture;
+                f.src = packed.src;
+        }
+}
+
+const AtlasFrame* Animation::get_frame(const AnimationFrame* frame) const {
         if (!frame) return nullptr;
         int index = index_of(frame);
         if (index < 0 || index >= static_cast<int>(frames.size())) return nullptr;
-        return frames[index];
+        const AtlasFrame& f = frames[index];
+        return f.texture ? &f : nullptr;
 }
 
 AnimationFrame* Animation::get_first_frame() {
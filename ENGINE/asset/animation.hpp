@@ -7,6 +7,7 @@
 #include <SDL.h>
 #include <nlohmann/json.hpp>
 #include "animation_frame.hpp"
+#include "texture_atlas.hpp"
 
 class AssetInfo;
 struct Mix_Chunk;
@@ -24,8 +25,11 @@ public:
 
 public:
     Animation();
-    void load(const std::string& trigger, const nlohmann::json& anim_json, class AssetInfo& info, const std::string& dir_path, const std::string& root_cache, float scale_factor, SDL_Renderer* renderer, SDL_Texture*& base_sprite, int& scaled_sprite_w, int& scaled_sprite_h, int& original_canvas_width, int& original_canvas_height);
-    SDL_Texture* get_frame(const AnimationFrame* frame) const;
+    // Frame surfaces are queued on `atlas`; frames hold atlas slots until the
+    // loader resolves them to page textures with resolve_atlas().
+    void load(const std::string& trigger, const nlohmann::json& anim_json, class AssetInfo& info, const std::string& dir_path, const std::string& root_cache, float scale_factor, TextureAtlasBuilder& atlas, int& scaled_sprite_w, int& scaled_sprite_h, int& original_canvas_width, int& original_canvas_height);
+    void resolve_atlas(const std::vector<AtlasFrame>& slots);
+    const AtlasFrame* get_frame(const AnimationFrame* frame) const;
     AnimationFrame* get_first_frame();
     int index_of(const AnimationFrame* frame) const;
     void change(AnimationFrame*& frame, bool& static_flag) const;
@@ -52,7 +56,7 @@ public:
     bool rnd_start = false;
     std::string on_end_mapping;
     std::string on_end_animation;
-    std::vector<SDL_Texture*> frames;
+    std::vector<AtlasFrame> frames;
     bool randomize = false;
     bool loop = true;
     bool frozen = false;
@@ -4,7 +4,7 @@
 #include "asset/asset_types.hpp"
 #include "animation.hpp"
 #include "core/AssetsManager.hpp"
-#include "core/asset_list.hpp"
+#include "core/neighbor_index.hpp"
 #include "audio/audio_engine.hpp"
 #include "utils/area.hpp"
 #include "utils/range_util.hpp"
@@ -16,6 +16,7 @@
 #include <string>
 #include <vector>
 #include <iostream>
+#include <mutex>
 #include <unordered_map>
 
 namespace {
@@ -51,12 +52,16 @@ struct ManualState {
     bool active = false;
 };
 
+// Looked up from the parallel think phase; map nodes stay put across rehashes,
+// so the returned reference is safe to use after the lock is released.
 ManualState& manual_state(AnimationUpdate* updater) {
+    static std::mutex mutex;
     static std::unordered_map<AnimationUpdate*, ManualState> states;
+    std::lock_guard<std::mutex> lock(mutex);
     return states[updater];
 }
 
-// No extraction helpers: iterate AssetList sections directly where needed.
+// No extraction helpers: neighbor lookups go through Assets::neighbor_index().
 }
 
 AnimationUpdate::AnimationUpdate(Asset* self, Assets* assets)
@@ -69,9 +74,6 @@ AnimationUpdate::AnimationUpdate(Asset* self, Assets* assets)
     rng_.seed(seed);
     path_bias_ = 0.75;
     int def_max = 100;
-    if (self_ && self_->get_neighbors_list()) {
-        def_max = std::max(1, self_->get_neighbors_list()->search_radius());
-    }
     max_current_target_dist = def_max;
     min_current_target_dist = std::max(1, static_cast<int>(std::floor(min_factor * def_max)));
 }
@@ -87,9 +89,6 @@ AnimationUpdate::AnimationUpdate(Asset* self, Assets* assets,
         assets_owner_ = self_->get_assets();
     }
     int def_max = 100;
-    if (self_ && self_->get_neighbors_list()) {
-        def_max = std::max(1, self_->get_neighbors_list()->search_radius());
-    }
     max_current_target_dist = def_max;
     min_current_target_dist = std::max(1, static_cast<int>(std::floor(min_factor * def_max)));
 }
@@ -253,7 +252,6 @@ bool AnimationUpdate::point_in_impassable(SDL_Point pt, const Asset* ignored) co
     Asset* closest = nullptr;
     double best_d2 = std::numeric_limits<double>::infinity();
 
-    const AssetList* impassable = self_ ? self_->get_impassable_naighbors() : nullptr;
     auto consider = [&](Asset* a) {
         if (!a || a == self_ || a == ignored || !a->info) return;
         if (a->info->type == asset_types::texture) return;
@@ -267,23 +265,25 @@ bool AnimationUpdate::point_in_impassable(SDL_Point pt, const Asset* ignored) co
         }
     };
 
-    if (impassable) {
-        for (Asset* a : impassable->top_unsorted()) consider(a);
-        for (Asset* a : impassable->middle_sorted()) consider(a);
-        for (Asset* a : impassable->bottom_unsorted()) consider(a);
-    } else if (assets_owner_) {
-        const auto& active = assets_owner_->getActive();
-        for (Asset* a : active) {
-            consider(a);
-        }
+    if (assets_owner_ && self_ && self_->info) {
+        assets_owner_->neighbor_index().query(self_->pos,
+                                              self_->info->NeighborSearchRadius,
+                                              NeighborIndex::Layer::Impassable,
+                                              self_,
+                                              neighbor_scratch_);
+        for (Asset* a : neighbor_scratch_) consider(a);
     }
 
     if (!closest) return false;
 
-    static const char* kNames[] = { "impassable_area", "passability", "collision_area" };
-    for (const char* nm : kNames) {
-        Area obstacle = closest->get_area(nm);
-        if (obstacle.get_points().size() >= 3 && obstacle.contains_point(pt)) {
+    static const Asset::AreaId kAreaIds[] = {
+        Asset::area_id("impassable_area"),
+        Asset::area_id("passability"),
+        Asset::area_id("collision_area"),
+};
+    for (Asset::AreaId id : kAreaIds) {
+        const Area* obstacle = closest->get_world_area(id);
+        if (obstacle && obstacle->get_points().size() >= 3 && obstacle->contains_point(pt)) {
             return true;
         }
     }
@@ -396,27 +396,21 @@ bool AnimationUpdate::can_move_by(int dx, int dy) const {
 bool AnimationUpdate::would_overlap_same_or_player(int dx, int dy) const {
     if (!self_ || !self_->info) return true;
     const SDL_Point new_pos{ self_->pos.x + dx, self_->pos.y + dy };
-    const AssetList* neighbor_list = self_->get_neighbors_list();
-    if (neighbor_list) {
-        auto check = [&](Asset* a) {
-            if (!a || a == self_ || !a->info) return false;
-            const bool is_enemy  = (a->info->type == asset_types::enemy);
-            const bool is_player = (a->info->type == asset_types::player);
-            if (!is_enemy && !is_player) return false;
-            return Range::get_distance(new_pos, a) < 40.0;
-        };
-        for (Asset* a : neighbor_list->top_unsorted()) { if (check(a)) return true; }
-        for (Asset* a : neighbor_list->middle_sorted()) { if (check(a)) return true; }
-        for (Asset* a : neighbor_list->bottom_unsorted()) { if (check(a)) return true; }
-    } else if (assets_owner_) {
-        const auto& active = assets_owner_->getActive();
-        for (Asset* a : active) {
-            if (!a || a == self_ || !a->info) continue;
-            const bool is_enemy  = (a->info->type == asset_types::enemy);
-            const bool is_player = (a->info->type == asset_types::player);
-            if (!is_enemy && !is_player) continue;
-            if (Range::get_distance(new_pos, a) < 40.0) return true;
-        }
+    if (!assets_owner_) return false;
+    // Only assets within the overlap distance of the candidate position matter,
+    // so query that small circle rather than the full neighbor radius.
+    constexpr int kOverlapRadius = 40;
+    assets_owner_->neighbor_index().query(new_pos,
+                                          kOverlapRadius,
+                                          NeighborIndex::Layer::All,
+                                          self_,
+                                          neighbor_scratch_);
+    for (Asset* a : neighbor_scratch_) {
+        if (!a || !a->info) continue;
+        const bool is_enemy  = (a->info->type == asset_types::enemy);
+        const bool is_player = (a->info->type == asset_types::player);
+        if (!is_enemy && !is_player) continue;
+        if (Range::get_distance(new_pos, a) < 40.0) return true;
     }
     return false;
 }
@@ -717,18 +711,23 @@ bool AnimationUpdate::advance(AnimationFrame*& frame) {
                 blocked_last_step_ = true;
             }
         }
-        if (attempted_move && !blocked && !suppress_movement_) {
+        if (attempted_move && !blocked && !suppress_movement_ && deferring_) {
+            intent_.move = true;
+            intent_.dx += move_dx;
+            intent_.dy += move_dy;
+            intent_.z_resort = intent_.z_resort || frame->z_resort;
+        } else if (attempted_move && !blocked && !suppress_movement_) {
             self_->pos.x += move_dx;
             self_->pos.y += move_dy;
+            Assets* as = assets_owner_;
+            if (!as && self_) {
+                as = self_->get_assets();
+            }
+            if (as) {
+                as->on_asset_moved(self_);
+            }
             if (frame->z_resort) {
                 self_->set_z_index();
-                Assets* as = assets_owner_;
-                if (!as && self_) {
-                    as = self_->get_assets();
-                }
-                if (as) {
-                    as->mark_active_assets_dirty();
-                }
             }
         }
         override_movement = false;
@@ -799,7 +798,7 @@ void AnimationUpdate::switch_to(const std::string& id) {
         slow_frame_interval_ = 1;
         slow_frame_counter_ = 0;
         if (anim.has_audio()) {
-            AudioEngine::instance().play_now(anim, *self_);
+            play_audio(anim);
         }
     } catch (const std::exception& e) {
         std::cerr << "[AnimationUpdate::switch_to] " << e.what() << "\n";
@@ -808,6 +807,51 @@ void AnimationUpdate::switch_to(const std::string& id) {
     }
 }
 
+void AnimationUpdate::play_audio(Animation& anim) {
+    if (deferring_) {
+        intent_.sounds.push_back(&anim);
+        return;
+    }
+    AudioEngine::instance().play_now(anim, *self_);
+}
+
+void AnimationUpdate::begin_think() {
+    intent_ = Intent{};
+    deferring_ = true;
+}
+
+void AnimationUpdate::commit() {
+    if (!deferring_) return;
+    deferring_ = false;
+    Intent intent = std::move(intent_);
+    intent_ = Intent{};
+    if (!self_) return;
+    if (intent.move) {
+        // Other assets have committed their moves since the think phase read
+        // the scene; re-check the step against where they are now.
+        if (can_move_by(intent.dx, intent.dy)) {
+            self_->pos.x += intent.dx;
+            self_->pos.y += intent.dy;
+            Assets* as = assets_owner_ ? assets_owner_ : self_->get_assets();
+            if (as) {
+                as->on_asset_moved(self_);
+            }
+            if (intent.z_resort) {
+                self_->set_z_index();
+            }
+        } else {
+            moving = false;
+            have_target_ = false;
+        }
+    }
+    for (Animation* anim : intent.sounds) {
+        AudioEngine::instance().play_now(*anim, *self_);
+    }
+    if (intent.remove) {
+        self_->Delete();
+    }
+}
+
 void AnimationUpdate::get_animation() {
     try {
         if (!self_ || !self_->info) return;
@@ -815,7 +859,11 @@ void AnimationUpdate::get_animation() {
         if (it == self_->info->animations.end()) return;
         std::string next = it->second.on_end_mapping;
         if (next.empty()) next = "default";
-        if (next == "end") { self_->Delete(); return; }
+        if (next == "end") {
+            if (deferring_) intent_.remove = true;
+            else self_->Delete();
+            return;
+        }
         if (next == "freeze_on_last") { self_->static_frame = true; return; }
         auto nit = self_->info->animations.find(next);
         if (nit != self_->info->animations.end()) {
@@ -827,7 +875,7 @@ void AnimationUpdate::get_animation() {
             self_->static_frame = anim.is_static();
             self_->frame_progress = 0.0f;
             if (anim.has_audio()) {
-                AudioEngine::instance().play_now(anim, *self_);
+                play_audio(anim);
             }
         }
     } catch (const std::exception& e) {
@@ -10,6 +10,7 @@
 class Asset;
 class Assets;
 class AnimationFrame;
+class Animation;
 
 class AnimationUpdate {
 public:
@@ -17,6 +18,11 @@ public:
     AnimationUpdate(Asset* self, Assets* assets, double path_bias);
 
     void update();
+    // Two-phase update for the parallel asset pass: between begin_think() and
+    // commit(), update() only touches this asset. Moves, animation audio and
+    // removal are recorded and applied by commit() on the calling thread.
+    void begin_think();
+    void commit();
     void set_animation_now(const std::string& anim_id);
     void set_animation_qued(const std::string& anim_id);
     void move(int x, int y);
@@ -38,6 +44,17 @@ public:
 private:
     enum class Mode { None, Idle, Pursue, Run, Orbit, Patrol, Serpentine, ToPoint };
 
+    struct Intent {
+        bool move = false;
+        int dx = 0;
+        int dy = 0;
+        bool z_resort = false;
+        bool remove = false;
+        std::vector<Animation*> sounds;
+};
+
+    void play_audio(Animation& anim);
+
     bool can_move_by(int dx, int dy) const;
     bool would_overlap_same_or_player(int dx, int dy) const;
     std::string pick_best_animation_towards(SDL_Point target);
@@ -69,6 +86,7 @@ private:
     bool have_target_ = false;
     SDL_Point target_{0, 0};
     mutable int cached_min_move_len2_ = -1;
+    mutable std::vector<Asset*> neighbor_scratch_;
     std::mt19937 rng_;
     double path_bias_ = 0.75;
     int    orbit_dir_ = +1;
@@ -112,4 +130,6 @@ private:
     int slow_frame_interval_ = 1;
     int slow_frame_counter_ = 0;
     bool mode_suspended_ = false;
+    bool deferring_ = false;
+    Intent intent_;
 };
@@ -47,6 +47,7 @@ AssetInfo::AssetInfo(const std::string &asset_folder_name)
                         }
                 }
         }
+        refresh_tag_masks();
         if (data.contains("animations") && data["animations"].is_object()) {
                 nlohmann::json new_anim = nlohmann::json::object();
                 for (auto it = data["animations"].begin(); it != data["animations"].end(); ++it) {
@@ -126,17 +127,23 @@ AssetInfo::~AssetInfo() {
 	oss << "[AssetInfo] Destructor for '" << name << "'\r";
 	std::cout << std::left << std::setw(60) << oss.str() << std::flush;
 	for (auto &[key, anim] : animations) {
-		for (SDL_Texture *tex : anim.frames) {
-			if (tex)
-			SDL_DestroyTexture(tex);
-		}
 		anim.frames.clear();
 	}
 	animations.clear();
+	release_atlas_pages();
+}
+
+void AssetInfo::release_atlas_pages() {
+	for (SDL_Texture *page : atlas_pages) {
+		if (page)
+		SDL_DestroyTexture(page);
+	}
+	atlas_pages.clear();
 }
 
 void AssetInfo::loadAnimations(SDL_Renderer *renderer) {
 	AnimationLoader::load(*this, renderer);
+	++animations_revision;
 }
 
 void AssetInfo::load_base_properties(const nlohmann::json &data) {
@@ -154,9 +161,19 @@ void AssetInfo::load_base_properties(const nlohmann::json &data) {
 }
 
 bool AssetInfo::has_tag(const std::string &tag) const {
+    if (tag_mask_complete) {
+        const TagId id = TagInterner::instance().find(tag);
+        return id != kInvalidTagId && tag_mask.test(id);
+    }
     return std::find(tags.begin(), tags.end(), tag) != tags.end();
 }
 
+void AssetInfo::refresh_tag_masks() {
+    TagInterner& interner = TagInterner::instance();
+    tag_mask_complete = interner.build_mask(tags, tag_mask);
+    anti_tag_mask_complete = interner.build_mask(anti_tags, anti_tag_mask);
+}
+
 void AssetInfo::generate_lights(SDL_Renderer *renderer) {
 	LightingLoader::generate_textures(*this, renderer);
 }
@@ -230,6 +247,7 @@ void AssetInfo::set_scale_filter(bool smooth) {
 
 void AssetInfo::set_tags(const std::vector<std::string> &t) {
 	tags = t;
+	refresh_tag_masks();
 	nlohmann::json arr = nlohmann::json::array();
 	for (const auto &s : tags)
 	arr.push_back(s);
@@ -251,6 +269,7 @@ void AssetInfo::remove_tag(const std::string &tag) {
 
 void AssetInfo::set_anti_tags(const std::vector<std::string> &t) {
         anti_tags = t;
+        refresh_tag_masks();
         nlohmann::json arr = nlohmann::json::array();
         for (const auto &s : anti_tags)
                 arr.push_back(s);
@@ -298,6 +317,7 @@ void AssetInfo::upsert_area_from_editor(const Area& area) {
 		na.area = std::make_unique<Area>(area);
 		areas.push_back(std::move(na));
 	}
+	++areas_revision;
 
 	if (!info_json_.contains("areas") || !info_json_["areas"].is_array()) {
 		info_json_["areas"] = nlohmann::json::array();
@@ -398,6 +418,7 @@ std::string AssetInfo::pick_next_animation(const std::string& mapping_id) const
 void AssetInfo::load_areas(const nlohmann::json& data, float scale, int offset_x,
                            int offset_y) {
 	AreaLoader::load(*this, data, scale, offset_x, offset_y);
+	++areas_revision;
 }
 
 void AssetInfo::load_children(const nlohmann::json& data) {
@@ -510,6 +531,7 @@ bool AssetInfo::remove_area(const std::string& name) {
     bool removed = false;
 
     areas.erase(std::remove_if(areas.begin(), areas.end(), [&](const NamedArea& na){ return na.name == name; }), areas.end());
+    ++areas_revision;
 
     try {
         if (info_json_.contains("areas") && info_json_["areas"].is_array()) {
@@ -1,11 +1,15 @@
 #pragma once
 
 #include "animation.hpp"
+#include "frame_decoder.hpp"
 #include "utils/area.hpp"
 #include "utils/light_source.hpp"
+#include "utils/tag_interner.hpp"
 #include <map>
 #include <nlohmann/json.hpp>
+#include <cstdint>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 struct ChildInfo {
@@ -52,6 +56,12 @@ class AssetInfo {
     bool flipable;
     std::vector<std::string> tags;
     std::vector<std::string> anti_tags;
+    // Interned views of tags/anti_tags. When a mask is incomplete (interner
+    // full) callers must fall back to the string vectors.
+    TagMask tag_mask;
+    TagMask anti_tag_mask;
+    bool tag_mask_complete = false;
+    bool anti_tag_mask_complete = false;
     bool is_light_source = false;
     bool moving_asset = false;
     struct NamedArea {
@@ -59,7 +69,19 @@ class AssetInfo {
     std::unique_ptr<Area> area;
 };
     std::vector<NamedArea> areas;
+    // Bumped whenever `areas` is reloaded or edited so per-asset world-space
+    // caches know to rebuild.
+    std::uint32_t areas_revision = 0;
     std::map<std::string, Animation> animations;
+    // Bumped on every animation (re)load; frame textures from an older
+    // revision must not be matched in render caches.
+    std::uint32_t animations_revision = 0;
+    // Atlas pages backing every Animation::frames entry; owned here.
+    std::vector<SDL_Texture*> atlas_pages;
+    void release_atlas_pages();
+    // Frames decoded ahead of time by AssetLibrary's worker pool, keyed by
+    // trigger; Animation::load consumes them instead of decoding inline.
+    std::unordered_map<std::string, DecodedFrames> prefetched_frames;
     std::map<std::string, Mapping> mappings;
     std::vector<ChildInfo> children;
     std::string custom_controller_key;
@@ -108,6 +130,7 @@ class AssetInfo {
     void set_start_animation_name(const std::string& name);
 
 	private:
+    void refresh_tag_masks();
     void load_base_properties(const nlohmann::json &data);
     void generate_lights(SDL_Renderer *renderer);
     void load_areas(const nlohmann::json &data, float scale, int offset_x, int offset_y);
@@ -1,4 +1,6 @@
 #include "asset_library.hpp"
+#include "asset_info_methods/animation_loader.hpp"
+#include <algorithm>
 #include <filesystem>
 #include <iostream>
 #include <iomanip>
@@ -47,17 +49,52 @@ AssetLibrary::all() const {
 	return info_by_name_;
 }
 
-void AssetLibrary::loadAllAnimations(SDL_Renderer* renderer) {
+void AssetLibrary::loadAllAnimations(SDL_Renderer* renderer, const LoadProgress& progress) {
+    std::vector<AssetInfo*> infos;
+    infos.reserve(info_by_name_.size());
     for (auto& [name, info] : info_by_name_) {
-        info->loadAnimations(renderer);
+        if (info) infos.push_back(info.get());
     }
+    load_animations(renderer, infos, progress);
 }
 
-void AssetLibrary::loadAnimationsFor(SDL_Renderer* renderer, const std::unordered_set<std::string>& names) {
+void AssetLibrary::loadAnimationsFor(SDL_Renderer* renderer, const std::unordered_set<std::string>& names, const LoadProgress& progress) {
+    std::vector<AssetInfo*> infos;
+    infos.reserve(names.size());
     for (const auto& name : names) {
         auto it = info_by_name_.find(name);
         if (it != info_by_name_.end() && it->second) {
-            it->second->loadAnimations(renderer);
+            infos.push_back(it->second.get());
+        }
+    }
+    load_animations(renderer, infos, progress);
+}
+
+// Decoding, scaling and cache writes run on a worker pool across every asset
+// and frame; only the atlas upload in AnimationLoader::load stays on the
+// render thread, fed one asset at a time from the prefetched surfaces.
+void AssetLibrary::load_animations(SDL_Renderer* renderer, std::vector<AssetInfo*>& infos, const LoadProgress& progress) {
+    constexpr float kDecodeShare = 0.8f;
+    std::sort(infos.begin(), infos.end(), [](const AssetInfo* a, const AssetInfo* b) { return a->name < b->name; });
+
+    std::vector<FrameDecoder::Job> jobs;
+    for (AssetInfo* info : infos) {
+        AnimationLoader::collect_decode_jobs(*info, jobs);
+    }
+    const unsigned workers = FrameDecoder::default_worker_count();
+    std::cout << "[AssetLibrary] Decoding " << jobs.size() << " animations for " << infos.size()
+              << " assets on " << workers << " threads\n";
+    FrameDecoder::decode_all(jobs, workers, [&](std::size_t done, std::size_t total) {
+        if (progress && total > 0) {
+            progress(kDecodeShare * static_cast<float>(done) / static_cast<float>(total), "Decoding frames");
+        }
+    });
+
+    for (std::size_t i = 0; i < infos.size(); ++i) {
+        infos[i]->loadAnimations(renderer);
+        if (progress) {
+            progress(kDecodeShare + (1.0f - kDecodeShare) * static_cast<float>(i + 1) / static_cast<float>(infos.size()),
+                     "Uploading textures");
         }
     }
 }
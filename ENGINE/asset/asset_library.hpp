@@ -1,10 +1,12 @@
 #pragma once
 
 #include "asset_info.hpp"
+#include <functional>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
 #include <memory>
+#include <vector>
 
 class AssetLibrary {
 
@@ -13,10 +15,13 @@ class AssetLibrary {
     void load_all_from_SRC();
     std::shared_ptr<AssetInfo> get(const std::string& name) const;
     const std::unordered_map<std::string, std::shared_ptr<AssetInfo>>& all() const;
-    void loadAllAnimations(SDL_Renderer* renderer);
-    void loadAnimationsFor(SDL_Renderer* renderer, const std::unordered_set<std::string>& names);
+    // fraction in [0, 1] plus a short stage label; always invoked on the calling thread.
+    using LoadProgress = std::function<void(float fraction, const std::string& stage)>;
+    void loadAllAnimations(SDL_Renderer* renderer, const LoadProgress& progress = {});
+    void loadAnimationsFor(SDL_Renderer* renderer, const std::unordered_set<std::string>& names, const LoadProgress& progress = {});
 
 	private:
+    void load_animations(SDL_Renderer* renderer, std::vector<AssetInfo*>& infos, const LoadProgress& progress);
     std::unordered_map<std::string, std::shared_ptr<AssetInfo>> info_by_name_;
 };
 
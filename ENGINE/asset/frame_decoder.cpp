@@ -0,0 +1,216 @@
+#include "frame_decoder.hpp"
+
+#include "utils/cache_manager.hpp"
+
+#include <SDL_image.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <thread>
+#include <nlohmann/json.hpp>
+
+namespace fs = std::filesystem;
+
+namespace {
+struct DecodeState {
+    int            expected = 0;
+    nlohmann::json meta;
+    bool           needs_scale = false;
+};
+
+// Stage 1: count source frames and try the packed cache, then the PNG cache.
+void probe_job(const FrameDecoder::Job& job, DecodeState& st) {
+    DecodedFrames& out = *job.out;
+    out.release();
+    while (fs::exists(job.src_folder + "/" + std::to_string(st.expected) + ".png")) {
+        ++st.expected;
+    }
+    if (st.expected == 0) return;
+
+    const std::string first_src = job.src_folder + "/0.png";
+    const std::string pack_file = job.cache_folder + "/frames.pack";
+    const std::string meta_file = job.cache_folder + "/metadata.json";
+    const std::string stamp     = CacheManager::source_stamp(first_src);
+
+    nlohmann::json meta;
+    if (CacheManager::load_packed_sequence(pack_file, meta, out.surfaces)) {
+        if (meta.value("frame_count", -1) == st.expected &&
+            meta.value("scale_factor", -1.0f) == job.scale_factor &&
+            meta.value("source_stamp", std::string{}) == stamp &&
+            static_cast<int>(out.surfaces.size()) == st.expected) {
+            return;
+        }
+        out.release();
+    }
+
+    if (SDL_Surface* s = IMG_Load(first_src.c_str())) {
+        out.original_w = s->w;
+        out.original_h = s->h;
+        SDL_FreeSurface(s);
+    }
+    st.meta["frame_count"]     = st.expected;
+    st.meta["scale_factor"]    = job.scale_factor;
+    st.meta["original_width"]  = out.original_w;
+    st.meta["original_height"] = out.original_h;
+    st.meta["source_stamp"]    = stamp;
+
+    meta = nlohmann::json{};
+    if (CacheManager::load_metadata(meta_file, meta) &&
+        meta.value("frame_count", -1) == st.expected &&
+        meta.value("scale_factor", -1.0f) == job.scale_factor &&
+        meta.value("original_width", -1) == out.original_w &&
+        meta.value("original_height", -1) == out.original_h &&
+        CacheManager::load_surface_sequence(job.cache_folder, st.expected, out.surfaces)) {
+        if (!CacheManager::save_packed_sequence(pack_file, st.meta, out.surfaces)) {
+            std::cerr << "[FrameDecoder] Failed to write packed cache: " << pack_file << "\n";
+        }
+        return;
+    }
+
+    out.surfaces.assign(static_cast<std::size_t>(st.expected), nullptr);
+    out.rebuilt = true;
+    st.needs_scale = true;
+}
+
+// Stage 2: decode and scale one source frame. Each call writes only its own slot.
+void scale_frame(const FrameDecoder::Job& job, int index) {
+    DecodedFrames& out = *job.out;
+    const std::string f = job.src_folder + "/" + std::to_string(index) + ".png";
+    int new_w = 0, new_h = 0;
+    SDL_Surface* scaled = CacheManager::load_and_scale_surface(f, job.scale_factor, new_w, new_h);
+    if (!scaled) {
+        std::cerr << "[FrameDecoder] Failed to load or scale: " << f << "\n";
+        return;
+    }
+    if (index == 0) {
+        out.scaled_w = new_w;
+        out.scaled_h = new_h;
+    }
+    out.surfaces[static_cast<std::size_t>(index)] = scaled;
+}
+
+// Stage 3: drop failed frames and write the PNG export, metadata and pack.
+void finish_job(const FrameDecoder::Job& job, const DecodeState& st) {
+    DecodedFrames& out = *job.out;
+    out.surfaces.erase(std::remove(out.surfaces.begin(), out.surfaces.end(), nullptr), out.surfaces.end());
+    CacheManager::save_surface_sequence(job.cache_folder, out.surfaces);
+    CacheManager::save_metadata(job.cache_folder + "/metadata.json", st.meta);
+    const std::string pack_file = job.cache_folder + "/frames.pack";
+    if (!CacheManager::save_packed_sequence(pack_file, st.meta, out.surfaces)) {
+        std::cerr << "[FrameDecoder] Failed to write packed cache: " << pack_file << "\n";
+    }
+}
+
+// Runs fn(0..count-1) over up to `workers` threads. The calling thread only
+// waits and reports progress so it stays free to keep the window responsive.
+template <typename Fn>
+void run_parallel(std::size_t count, unsigned workers, Fn&& fn, const std::function<void(std::size_t)>& tick) {
+    if (count == 0) return;
+    const unsigned threads = static_cast<unsigned>(std::min<std::size_t>(std::max(1u, workers), count));
+    if (threads <= 1) {
+        for (std::size_t i = 0; i < count; ++i) {
+            fn(i);
+            if (tick) tick(i + 1);
+        }
+        return;
+    }
+    std::atomic<std::size_t> next{0};
+    std::atomic<std::size_t> done{0};
+    std::vector<std::thread> pool;
+    pool.reserve(threads);
+    for (unsigned t = 0; t < threads; ++t) {
+        pool.emplace_back([&]() {
+            for (std::size_t i = next.fetch_add(1); i < count; i = next.fetch_add(1)) {
+                fn(i);
+                done.fetch_add(1, std::memory_order_release);
+            }
+        });
+    }
+    while (done.load(std::memory_order_acquire) < count) {
+        if (tick) tick(done.load(std::memory_order_acquire));
+        std::this_thread::sleep_for(std::chrono::milliseconds(16));
+    }
+    for (std::thread& th : pool) th.join();
+    if (tick) tick(count);
+}
+}
+
+DecodedFrames::~DecodedFrames() {
+    release();
+}
+
+DecodedFrames::DecodedFrames(DecodedFrames&& other) noexcept {
+    *this = std::move(other);
+}
+
+DecodedFrames& DecodedFrames::operator=(DecodedFrames&& other) noexcept {
+    if (this != &other) {
+        release();
+        surfaces   = std::move(other.surfaces);
+        original_w = other.original_w;
+        original_h = other.original_h;
+        scaled_w   = other.scaled_w;
+        scaled_h   = other.scaled_h;
+        rebuilt    = other.rebuilt;
+        other.surfaces.clear();
+        other.rebuilt = false;
+    }
+    return *this;
+}
+
+void DecodedFrames::release() {
+    for (SDL_Surface* s : surfaces) {
+        if (s) SDL_FreeSurface(s);
+    }
+    surfaces.clear();
+    original_w = original_h = 0;
+    scaled_w = scaled_h = 0;
+    rebuilt = false;
+}
+
+void FrameDecoder::decode(const Job& job) {
+    if (!job.out) return;
+    DecodeState st;
+    probe_job(job, st);
+    if (!st.needs_scale) return;
+    for (int i = 0; i < st.expected; ++i) {
+        scale_frame(job, i);
+    }
+    finish_job(job, st);
+}
+
+void FrameDecoder::decode_all(std::vector<Job>& jobs, unsigned workers, const Progress& progress) {
+    jobs.erase(std::remove_if(jobs.begin(), jobs.end(), [](const Job& j) { return j.out == nullptr; }), jobs.end());
+    std::vector<DecodeState> states(jobs.size());
+
+    std::size_t base  = 0;
+    std::size_t total = jobs.size();
+    auto tick = [&](std::size_t done) {
+        if (progress) progress(base + done, total);
+    };
+
+    run_parallel(jobs.size(), workers, [&](std::size_t i) { probe_job(jobs[i], states[i]); }, tick);
+
+    std::vector<std::pair<std::size_t, int>> frames;
+    std::vector<std::size_t> rebuilt;
+    for (std::size_t i = 0; i < jobs.size(); ++i) {
+        if (!states[i].needs_scale) continue;
+        rebuilt.push_back(i);
+        for (int f = 0; f < states[i].expected; ++f) {
+            frames.emplace_back(i, f);
+        }
+    }
+    base   = jobs.size();
+    total += frames.size() + rebuilt.size();
+    run_parallel(frames.size(), workers, [&](std::size_t k) { scale_frame(jobs[frames[k].first], frames[k].second); }, tick);
+
+    base += frames.size();
+    run_parallel(rebuilt.size(), workers, [&](std::size_t k) { finish_job(jobs[rebuilt[k]], states[rebuilt[k]]); }, tick);
+}
+
+unsigned FrameDecoder::default_worker_count() {
+    const unsigned hw = std::thread::hardware_concurrency();
+    return hw > 1 ? hw - 1 : 1;
+}
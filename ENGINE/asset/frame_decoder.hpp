@@ -0,0 +1,52 @@
+#pragma once
+
+#include <SDL.h>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+// Scaled frame surfaces for one folder-sourced animation. Owns the surfaces
+// until they are handed to a TextureAtlasBuilder (or the object is destroyed).
+struct DecodedFrames {
+    DecodedFrames() = default;
+    ~DecodedFrames();
+    DecodedFrames(DecodedFrames&& other) noexcept;
+    DecodedFrames& operator=(DecodedFrames&& other) noexcept;
+    DecodedFrames(const DecodedFrames&) = delete;
+    DecodedFrames& operator=(const DecodedFrames&) = delete;
+
+    void release();
+
+    std::vector<SDL_Surface*> surfaces;
+    int  original_w = 0;
+    int  original_h = 0;
+    int  scaled_w   = 0;
+    int  scaled_h   = 0;
+    bool rebuilt    = false;   // frames were scaled from source rather than read from cache/
+};
+
+// CPU half of animation loading: cache probing, PNG decode, scaling and cache
+// writes. Nothing here touches the renderer, so it runs on worker threads; the
+// caller uploads the resulting surfaces on the render thread.
+class FrameDecoder {
+public:
+    struct Job {
+        std::string    src_folder;
+        std::string    cache_folder;
+        float          scale_factor = 1.0f;
+        DecodedFrames* out          = nullptr;
+    };
+
+    // Called on the calling thread while decode_all() waits on its workers.
+    using Progress = std::function<void(std::size_t done, std::size_t total)>;
+
+    static void decode(const Job& job);
+
+    // Probes every job's cache, scales the frames of every cache miss and
+    // writes the rebuilt caches, each stage spread over `workers` threads.
+    // Cold builds are parallel per frame rather than per animation.
+    static void decode_all(std::vector<Job>& jobs, unsigned workers, const Progress& progress = {});
+
+    static unsigned default_worker_count();
+};
@@ -0,0 +1,313 @@
+#include "texture_atlas.hpp"
+
+#include "utils/cache_manager.hpp"
+
+#include <algorithm>
+#include <climits>
+#include <filesystem>
+#include <iostream>
+#include <numeric>
+
+#include <nlohmann/json.hpp>
+
+namespace {
+constexpr int kAtlasLayoutVersion = 1;
+
+// Bottom-left skyline packer for a single page.
+class SkylinePage {
+public:
+    SkylinePage(int width, int height)
+        : width_(width), height_(height) {
+        nodes_.push_back(Node{ 0, 0, width });
+    }
+
+    bool insert(int w, int h, SDL_Point& out) {
+        int best_y = INT_MAX;
+        std::size_t best_index = nodes_.size();
+        for (std::size_t i = 0; i < nodes_.size(); ++i) {
+            int y = 0;
+            if (!fits(i, w, h, y)) continue;
+            if (y < best_y) {
+                best_y = y;
+                best_index = i;
+            }
+        }
+        if (best_index == nodes_.size()) {
+            return false;
+        }
+        out = SDL_Point{ nodes_[best_index].x, best_y };
+        add_level(best_index, out.x, out.y, w, h);
+        used_w_ = std::max(used_w_, out.x + w);
+        used_h_ = std::max(used_h_, out.y + h);
+        return true;
+    }
+
+    int used_width() const { return used_w_; }
+    int used_height() const { return used_h_; }
+
+private:
+    struct Node {
+        int x;
+        int y;
+        int w;
+};
+
+    bool fits(std::size_t index, int w, int h, int& out_y) const {
+        const int x = nodes_[index].x;
+        if (x + w > width_) return false;
+        int remaining = w;
+        int y = nodes_[index].y;
+        for (std::size_t i = index; remaining > 0 && i < nodes_.size(); ++i) {
+            y = std::max(y, nodes_[i].y);
+            if (y + h > height_) return false;
+            remaining -= nodes_[i].w;
+        }
+        out_y = y;
+        return remaining <= 0;
+    }
+
+    void add_level(std::size_t index, int x, int y, int w, int h) {
+        nodes_.insert(nodes_.begin() + static_cast<std::ptrdiff_t>(index), Node{ x, y + h, w });
+        for (std::size_t i = index + 1; i < nodes_.size();) {
+            const Node& prev = nodes_[i - 1];
+            Node& node = nodes_[i];
+            const int overlap = prev.x + prev.w - node.x;
+            if (overlap <= 0) break;
+            node.x += overlap;
+            node.w -= overlap;
+            if (node.w > 0) break;
+            nodes_.erase(nodes_.begin() + static_cast<std::ptrdiff_t>(i));
+        }
+        for (std::size_t i = 0; i + 1 < nodes_.size();) {
+            if (nodes_[i].y == nodes_[i + 1].y) {
+                nodes_[i].w += nodes_[i + 1].w;
+                nodes_.erase(nodes_.begin() + static_cast<std::ptrdiff_t>(i + 1));
+            } else {
+                ++i;
+            }
+        }
+    }
+
+    int width_;
+    int height_;
+    int used_w_ = 0;
+    int used_h_ = 0;
+    std::vector<Node> nodes_;
+};
+}
+
+int AtlasFrame::render(SDL_Renderer* renderer, const SDL_Rect* dst) const {
+    if (!renderer || !texture) return -1;
+    return SDL_RenderCopyEx(renderer, texture, &src, dst, 0.0, nullptr, flipped ? SDL_FLIP_HORIZONTAL : SDL_FLIP_NONE);
+}
+
+TextureAtlasBuilder::TextureAtlasBuilder(int page_size, int padding)
+    : page_size_(std::max(64, page_size)), padding_(std::max(0, padding)) {}
+
+TextureAtlasBuilder::~TextureAtlasBuilder() {
+    release_surfaces();
+}
+
+int TextureAtlasBuilder::add(SDL_Surface* surface) {
+    if (!surface) return -1;
+    surfaces_.push_back(surface);
+    return static_cast<int>(surfaces_.size()) - 1;
+}
+
+void TextureAtlasBuilder::release_surfaces() {
+    for (SDL_Surface* s : surfaces_) {
+        if (s) SDL_FreeSurface(s);
+    }
+    surfaces_.clear();
+}
+
+bool TextureAtlasBuilder::pack(int page_size, std::vector<Placement>& placements, std::vector<SDL_Point>& page_dims) const {
+    placements.assign(surfaces_.size(), Placement{});
+    page_dims.clear();
+
+    std::vector<std::size_t> order(surfaces_.size());
+    std::iota(order.begin(), order.end(), std::size_t{0});
+    std::stable_sort(order.begin(), order.end(), [this](std::size_t a, std::size_t b) {
+        if (surfaces_[a]->h != surfaces_[b]->h) return surfaces_[a]->h > surfaces_[b]->h;
+        return surfaces_[a]->w > surfaces_[b]->w;
+    });
+
+    std::vector<SkylinePage> pages;
+    std::vector<int> page_index;
+    for (std::size_t slot : order) {
+        const int w = surfaces_[slot]->w;
+        const int h = surfaces_[slot]->h;
+        const int pw = w + padding_;
+        const int ph = h + padding_;
+        if (pw > page_size || ph > page_size) {
+            // Oversized frames get a page of their own.
+            placements[slot] = Placement{ static_cast<int>(page_dims.size()), 0, 0 };
+            page_dims.push_back(SDL_Point{ w, h });
+            continue;
+        }
+        SDL_Point at{ 0, 0 };
+        bool placed = false;
+        for (std::size_t p = 0; p < pages.size() && !placed; ++p) {
+            if (pages[p].insert(pw, ph, at)) {
+                placements[slot] = Placement{ page_index[p], at.x, at.y };
+                placed = true;
+            }
+        }
+        if (!placed) {
+            pages.emplace_back(page_size, page_size);
+            page_index.push_back(static_cast<int>(page_dims.size()));
+            page_dims.push_back(SDL_Point{ 0, 0 });
+            if (!pages.back().insert(pw, ph, at)) {
+                return false;
+            }
+            placements[slot] = Placement{ page_index.back(), at.x, at.y };
+        }
+    }
+    for (std::size_t p = 0; p < pages.size(); ++p) {
+        page_dims[static_cast<std::size_t>(page_index[p])] = SDL_Point{ std::max(1, pages[p].used_width()),
+                                                                        std::max(1, pages[p].used_height()) };
+    }
+    return true;
+}
+
+bool TextureAtlasBuilder::load_layout(const std::string& path,
+                                      int page_size,
+                                      std::vector<Placement>& placements,
+                                      std::vector<SDL_Point>& page_dims) const {
+    nlohmann::json layout;
+    if (!CacheManager::load_metadata(path, layout)) return false;
+    try {
+        if (layout.value("version", 0) != kAtlasLayoutVersion ||
+            layout.value("page_size", 0) != page_size ||
+            layout.value("padding", -1) != padding_) {
+            return false;
+        }
+        const auto& frames = layout.at("frames");
+        const auto& pages = layout.at("pages");
+        if (!frames.is_array() || !pages.is_array() || frames.size() != surfaces_.size()) return false;
+
+        page_dims.clear();
+        for (const auto& p : pages) {
+            page_dims.push_back(SDL_Point{ p.at(0).get<int>(), p.at(1).get<int>() });
+        }
+        placements.assign(surfaces_.size(), Placement{});
+        for (std::size_t i = 0; i < surfaces_.size(); ++i) {
+            const auto& f = frames[i];
+            const int w = f.at(0).get<int>();
+            const int h = f.at(1).get<int>();
+            Placement pl{ f.at(2).get<int>(), f.at(3).get<int>(), f.at(4).get<int>() };
+            if (w != surfaces_[i]->w || h != surfaces_[i]->h) return false;
+            if (pl.page < 0 || pl.page >= static_cast<int>(page_dims.size())) return false;
+            const SDL_Point& dims = page_dims[static_cast<std::size_t>(pl.page)];
+            if (pl.x < 0 || pl.y < 0 || pl.x + w > dims.x || pl.y + h > dims.y) return false;
+            placements[i] = pl;
+        }
+    } catch (...) {
+        return false;
+    }
+    return true;
+}
+
+void TextureAtlasBuilder::save_layout(const std::string& path,
+                                      int page_size,
+                                      const std::vector<Placement>& placements,
+                                      const std::vector<SDL_Point>& page_dims) const {
+    nlohmann::json layout;
+    layout["version"] = kAtlasLayoutVersion;
+    layout["page_size"] = page_size;
+    layout["padding"] = padding_;
+    nlohmann::json pages = nlohmann::json::array();
+    for (const SDL_Point& d : page_dims) {
+        pages.push_back({ d.x, d.y });
+    }
+    nlohmann::json frames = nlohmann::json::array();
+    for (std::size_t i = 0; i < placements.size(); ++i) {
+        frames.push_back({ surfaces_[i]->w, surfaces_[i]->h, placements[i].page, placements[i].x, placements[i].y });
+    }
+    layout["pages"] = std::move(pages);
+    layout["frames"] = std::move(frames);
+
+    std::error_code ec;
+    std::filesystem::create_directories(std::filesystem::path(path).parent_path(), ec);
+    CacheManager::save_metadata(path, layout);
+}
+
+bool TextureAtlasBuilder::build(SDL_Renderer* renderer,
+                                const std::string& layout_path,
+                                bool smooth_scaling,
+                                std::vector<SDL_Texture*>& pages,
+                                std::vector<AtlasFrame>& frames) {
+    frames.clear();
+    if (!renderer) {
+        release_surfaces();
+        return false;
+    }
+    if (surfaces_.empty()) {
+        return true;
+    }
+
+    int page_size = page_size_;
+    SDL_RendererInfo info{};
+    if (SDL_GetRendererInfo(renderer, &info) == 0 && info.max_texture_width > 0 && info.max_texture_height > 0) {
+        page_size = std::min(page_size, std::min(info.max_texture_width, info.max_texture_height));
+    }
+
+    std::vector<Placement> placements;
+    std::vector<SDL_Point> page_dims;
+    const bool reused = !layout_path.empty() && load_layout(layout_path, page_size, placements, page_dims);
+    if (!reused) {
+        if (!pack(page_size, placements, page_dims)) {
+            std::cerr << "[TextureAtlas] Failed to pack " << surfaces_.size() << " frames\n";
+            release_surfaces();
+            return false;
+        }
+        if (!layout_path.empty()) {
+            save_layout(layout_path, page_size, placements, page_dims);
+        }
+    }
+
+    std::vector<SDL_Surface*> page_surfaces(page_dims.size(), nullptr);
+    for (std::size_t p = 0; p < page_dims.size(); ++p) {
+        page_surfaces[p] = SDL_CreateRGBSurfaceWithFormat(0, page_dims[p].x, page_dims[p].y, 32, SDL_PIXELFORMAT_RGBA32);
+        if (page_surfaces[p]) {
+            SDL_FillRect(page_surfaces[p], nullptr, 0);
+        }
+    }
+    for (std::size_t i = 0; i < surfaces_.size(); ++i) {
+        SDL_Surface* page = page_surfaces[static_cast<std::size_t>(placements[i].page)];
+        if (!page) continue;
+        SDL_SetSurfaceBlendMode(surfaces_[i], SDL_BLENDMODE_NONE);
+        SDL_Rect dst{ placements[i].x, placements[i].y, surfaces_[i]->w, surfaces_[i]->h };
+        SDL_BlitSurface(surfaces_[i], nullptr, page, &dst);
+    }
+
+    const std::size_t first_page = pages.size();
+    for (SDL_Surface* surf : page_surfaces) {
+        SDL_Texture* tex = nullptr;
+        if (surf) {
+            tex = SDL_CreateTextureFromSurface(renderer, surf);
+            SDL_FreeSurface(surf);
+        }
+        if (tex) {
+            SDL_SetTextureBlendMode(tex, SDL_BLENDMODE_BLEND);
+#if SDL_VERSION_ATLEAST(2,0,12)
+            SDL_SetTextureScaleMode(tex, smooth_scaling ? SDL_ScaleModeBest : SDL_ScaleModeNearest);
+#else
+            (void)smooth_scaling;
+#endif
+        } else {
+            std::cerr << "[TextureAtlas] Failed to create page texture: " << SDL_GetError() << "\n";
+        }
+        pages.push_back(tex);
+    }
+
+    frames.resize(surfaces_.size());
+    for (std::size_t i = 0; i < surfaces_.size(); ++i) {
+        AtlasFrame& f = frames[i];
+        f.texture = pages[first_page + static_cast<std::size_t>(placements[i].page)];
+        f.src = SDL_Rect{ placements[i].x, placements[i].y, surfaces_[i]->w, surfaces_[i]->h };
+        f.slot = static_cast<int>(i);
+    }
+    release_surfaces();
+    return true;
+}
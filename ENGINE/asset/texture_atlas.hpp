@@ -0,0 +1,61 @@
+#pragma once
+
+#include <SDL.h>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// One animation frame as a sub-rectangle of a shared atlas page.
+struct AtlasFrame {
+    SDL_Texture* texture = nullptr;
+    SDL_Rect     src{0, 0, 0, 0};
+    bool         flipped = false;
+    int          slot    = -1;
+
+    int width() const { return src.w; }
+    int height() const { return src.h; }
+    // Draws the frame's region (honouring `flipped`) into dst, or the whole target when dst is null.
+    int render(SDL_Renderer* renderer, const SDL_Rect* dst) const;
+};
+
+// Packs frame surfaces into a few large pages with a skyline packer. Frames are
+// registered with add() while an AssetInfo's animations load, then build()
+// uploads the pages once and resolves every slot to a page + source rect. The
+// chosen layout is written next to the animation cache so later loads with the
+// same frame sizes reuse it instead of re-packing.
+class TextureAtlasBuilder {
+public:
+    explicit TextureAtlasBuilder(int page_size = 2048, int padding = 2);
+    ~TextureAtlasBuilder();
+
+    TextureAtlasBuilder(const TextureAtlasBuilder&) = delete;
+    TextureAtlasBuilder& operator=(const TextureAtlasBuilder&) = delete;
+
+    // Takes ownership of surface. Returns the slot for it, or -1 when null.
+    int add(SDL_Surface* surface);
+    std::size_t size() const { return surfaces_.size(); }
+
+    // Uploads the packed pages, appends them to `pages` (caller owns them) and
+    // fills `frames` with one entry per slot. Consumes the queued surfaces.
+    bool build(SDL_Renderer* renderer,
+               const std::string& layout_path,
+               bool smooth_scaling,
+               std::vector<SDL_Texture*>& pages,
+               std::vector<AtlasFrame>& frames);
+
+private:
+    struct Placement {
+        int page = -1;
+        int x = 0;
+        int y = 0;
+};
+
+    bool pack(int page_size, std::vector<Placement>& placements, std::vector<SDL_Point>& page_dims) const;
+    bool load_layout(const std::string& path, int page_size, std::vector<Placement>& placements, std::vector<SDL_Point>& page_dims) const;
+    void save_layout(const std::string& path, int page_size, const std::vector<Placement>& placements, const std::vector<SDL_Point>& page_dims) const;
+    void release_surfaces();
+
+    std::vector<SDL_Surface*> surfaces_;
+    int page_size_;
+    int padding_;
+};
@@ -3,6 +3,7 @@
 #include "asset/asset_info.hpp"
 #include "utils/cache_manager.hpp"
 #include "asset/animation.hpp"
+#include "asset/texture_atlas.hpp"
 #include <nlohmann/json.hpp>
 #include <SDL.h>
 #include <SDL_image.h>
@@ -16,28 +17,43 @@
 #include "custom_controllers/default_controller.hpp"
 using nlohmann::json;
 
+namespace {
+std::string animation_cache_root(const AssetInfo& info) {
+	return "cache/" + info.name + "/animations";
+}
+
+// Entries whose source is another animation reuse that animation's frames
+// and are loaded after it; they have no frames of their own to decode.
+bool is_alias_source(const json& anim_json) {
+	if (!anim_json.contains("source") || !anim_json["source"].is_object()) return false;
+	const auto& src = anim_json["source"];
+	return src.contains("kind") && src["kind"].is_string() && src["kind"].get<std::string>() == "animation";
+}
+}
+
 void AnimationLoader::load(AssetInfo& info, SDL_Renderer* renderer) {
 	if (info.anims_json_.is_null()) return;
-	SDL_Texture* base_sprite = nullptr;
 	int scaled_sprite_w = 0;
 	int scaled_sprite_h = 0;
 	info.generate_lights(renderer);
 	CacheManager cache;
-	std::string root_cache = "cache/" + info.name + "/animations";
+	std::string root_cache = animation_cache_root(info);
+	if (!info.atlas_pages.empty()) {
+		info.animations.clear();
+		info.release_atlas_pages();
+	}
+	TextureAtlasBuilder atlas;
 	std::vector<std::pair<std::string, nlohmann::json>> alias_queue;
 	for (auto it = info.anims_json_.begin(); it != info.anims_json_.end(); ++it) {
 		const std::string& trigger = it.key();
 		const auto& anim_json = it.value();
 		if (anim_json.is_null()) continue;
-		if (anim_json.contains("source") && anim_json["source"].is_object()) {
-			std::string kind = anim_json["source"].value("kind", std::string{"folder"});
-			if (kind == "animation") {
-					alias_queue.emplace_back(trigger, anim_json);
-					continue;
-			}
+		if (is_alias_source(anim_json)) {
+			alias_queue.emplace_back(trigger, anim_json);
+			continue;
 		}
 		Animation anim;
-		anim.load(trigger, anim_json, info, info.dir_path_, root_cache, info.scale_factor, renderer, base_sprite, scaled_sprite_w, scaled_sprite_h, info.original_canvas_width, info.original_canvas_height);
+		anim.load(trigger, anim_json, info, info.dir_path_, root_cache, info.scale_factor, atlas, scaled_sprite_w, scaled_sprite_h, info.original_canvas_width, info.original_canvas_height);
 		anim.on_end_mapping = anim_json.value("on_end", std::string{"default"});
 		if (!anim.frames.empty()) {
 			info.animations[trigger] = std::move(anim);
@@ -47,21 +63,50 @@ void AnimationLoader::load(AssetInfo& info, SDL_Renderer* renderer) {
 		const std::string& trigger = item.first;
 		const auto& anim_json = item.second;
 		Animation anim;
-		anim.load(trigger, anim_json, info, info.dir_path_, root_cache, info.scale_factor, renderer, base_sprite, scaled_sprite_w, scaled_sprite_h, info.original_canvas_width, info.original_canvas_height);
+		anim.load(trigger, anim_json, info, info.dir_path_, root_cache, info.scale_factor, atlas, scaled_sprite_w, scaled_sprite_h, info.original_canvas_width, info.original_canvas_height);
 		anim.on_end_mapping = anim_json.value("on_end", std::string{});
 		if (!anim.frames.empty()) {
 			info.animations[trigger] = std::move(anim);
 		}
 	}
 
+	std::vector<AtlasFrame> packed;
+	if (atlas.size() > 0) {
+		atlas.build(renderer, root_cache + "/atlas.json", info.smooth_scaling, info.atlas_pages, packed);
+	}
+	for (auto& kv : info.animations) {
+		kv.second.resolve_atlas(packed);
+	}
+
 	info.moving_asset = false;
 	for (const auto& kv : info.animations) {
 		const Animation& a = kv.second;
 		if (a.movment || a.total_dx != 0 || a.total_dy != 0) { info.moving_asset = true; break; }
 	}
+	info.prefetched_frames.clear();
 	get_area_textures(info, renderer);
 }
 
+void AnimationLoader::collect_decode_jobs(AssetInfo& info, std::vector<FrameDecoder::Job>& jobs) {
+	info.prefetched_frames.clear();
+	if (info.anims_json_.is_null()) return;
+	const std::string root_cache = animation_cache_root(info);
+	for (auto it = info.anims_json_.begin(); it != info.anims_json_.end(); ++it) {
+		const std::string& trigger = it.key();
+		const auto& anim_json = it.value();
+		if (anim_json.is_null() || is_alias_source(anim_json)) continue;
+		std::string path;
+		if (anim_json.contains("source") && anim_json["source"].is_object()) {
+			const auto& src = anim_json["source"];
+			if (src.contains("path") && src["path"].is_string()) path = src["path"].get<std::string>();
+		}
+		jobs.push_back(FrameDecoder::Job{ info.dir_path_ + "/" + path,
+		                                  root_cache + "/" + trigger,
+		                                  info.scale_factor,
+		                                  &info.prefetched_frames[trigger] });
+	}
+}
+
 void AnimationLoader::get_area_textures(AssetInfo& info, SDL_Renderer* renderer) {
 	if (!renderer) return;
 	CacheManager cache;
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <SDL.h>
+#include <vector>
+#include "asset/frame_decoder.hpp"
 #include "custom_controllers/Davey_controller.hpp"
 
 #include "custom_controllers/Vibble_controller.hpp"
@@ -15,4 +17,6 @@ class AnimationLoader {
 	public:
     static void load(AssetInfo& info, SDL_Renderer* renderer);
     static void get_area_textures(AssetInfo& info, SDL_Renderer* renderer);
+    // Queues one decode job per folder-sourced animation, targeting info.prefetched_frames.
+    static void collect_decode_jobs(AssetInfo& info, std::vector<FrameDecoder::Job>& jobs);
 };
@@ -12,6 +12,8 @@
 #include "utils/area.hpp"
 #include "utils/input.hpp"
 #include "utils/range_util.hpp"
+#include "utils/frame_profiler.hpp"
+#include "utils/job_pool.hpp"
 
 #include <algorithm>
 #include <cmath>
@@ -35,7 +37,7 @@ Assets::Assets(std::vector<Asset>&& loaded,
                int screen_center_y,
                int map_radius,
                SDL_Renderer* renderer,
-               const std::string& map_path)
+               MapDocument& map_doc)
     : camera_(
           screen_width_,
           screen_height_,
@@ -52,10 +54,10 @@ Assets::Assets(std::vector<Asset>&& loaded,
       screen_width(screen_width_),
       screen_height(screen_height_),
       library_(library),
-      map_path_(map_path),
-      map_info_path_(map_path_.empty() ? std::string{} : (map_path_ + "/map_info.json"))
+      map_doc_(map_doc),
+      map_path_(map_doc.map_dir())
 {
-    load_map_info_json();
+    load_camera_settings_from_json();
 
     InitializeAssets::initialize(*this, std::move(loaded), std::move(rooms), screen_width_, screen_height_, screen_center_x, screen_center_y, map_radius);
 
@@ -64,7 +66,7 @@ Assets::Assets(std::vector<Asset>&& loaded,
         camera_.set_up_rooms(finder_);
     }
 
-    scene = new SceneRenderer(renderer, this, screen_width_, screen_height_, map_path);
+    scene = new SceneRenderer(renderer, this, screen_width_, screen_height_);
     apply_map_light_config();
 
     for (Asset* a : all) {
@@ -75,185 +77,17 @@ Assets::Assets(std::vector<Asset>&& loaded,
 
 }
 
-void Assets::load_map_info_json() {
-    map_info_json_ = nlohmann::json::object();
-    if (map_info_path_.empty()) {
-        return;
-    }
-
-    std::ifstream in(map_info_path_);
-    if (!in.is_open()) {
-        std::cerr << "[Assets] Failed to open map_info.json at " << map_info_path_ << "\n";
-        return;
-    }
-
-    try {
-        in >> map_info_json_;
-    } catch (const std::exception& e) {
-        std::cerr << "[Assets] Failed to parse map_info.json: " << e.what() << "\n";
-        map_info_json_ = nlohmann::json::object();
-    }
-
-    if (!map_info_json_.is_object()) {
-        map_info_json_ = nlohmann::json::object();
-    }
-
-    hydrate_map_info_sections();
-    load_camera_settings_from_json();
-}
-
 void Assets::save_map_info_json() {
-    if (map_info_path_.empty()) {
-        return;
-    }
     write_camera_settings_to_json();
-    std::ofstream out(map_info_path_);
-    if (!out.is_open()) {
-        std::cerr << "[Assets] Failed to write map_info.json at " << map_info_path_ << "\n";
-        return;
-    }
-    try {
-        out << map_info_json_.dump(2);
-    } catch (const std::exception& e) {
-        std::cerr << "[Assets] Failed to serialize map_info.json: " << e.what() << "\n";
-    }
-}
-
-void Assets::hydrate_map_info_sections() {
-    if (!map_info_json_.is_object()) {
-        return;
-    }
-    if (map_path_.empty()) {
-        return;
-    }
-
-    const auto hydrate_from_file = [&](const char* legacy_key, const char* merged_key) {
-        if (map_info_json_.contains(merged_key)) {
-            return;
-        }
-        auto it = map_info_json_.find(legacy_key);
-        if (it == map_info_json_.end() || !it->is_string()) {
-            return;
-        }
-        const std::string file_path = map_path_ + "/" + it->get<std::string>();
-        std::ifstream section(file_path);
-        if (!section.is_open()) {
-            std::cerr << "[Assets] Legacy map section missing: " << file_path << "\n";
-            return;
-        }
-        try {
-            nlohmann::json data;
-            section >> data;
-            map_info_json_[merged_key] = std::move(data);
-        } catch (const std::exception& ex) {
-            std::cerr << "[Assets] Failed to hydrate " << merged_key << " from "
-                      << file_path << ": " << ex.what() << "\n";
-        }
-};
-
-    hydrate_from_file("map_assets", "map_assets_data");
-    hydrate_from_file("map_boundary", "map_boundary_data");
-    hydrate_from_file("map_light", "map_light_data");
-
-    const auto hydrate_directory = [&](const char* merged_key, const char* directory_name) {
-        if (map_info_json_.contains(merged_key) && map_info_json_[merged_key].is_object()) {
-            return;
-        }
-
-        const std::filesystem::path dir = std::filesystem::path(map_path_) / directory_name;
-        if (!std::filesystem::exists(dir) || !std::filesystem::is_directory(dir)) {
-            return;
-        }
-
-        std::error_code ec;
-        std::filesystem::directory_iterator it(dir, ec);
-        if (ec) {
-            std::cerr << "[Assets] Failed to scan legacy directory " << dir << ": "
-                      << ec.message() << "\n";
-            return;
-        }
-
-        nlohmann::json merged = nlohmann::json::object();
-        for (const auto& entry : it) {
-            if (!entry.is_regular_file()) {
-                continue;
-            }
-            const auto& path = entry.path();
-            if (path.extension() != ".json") {
-                continue;
-            }
-            std::ifstream in(path);
-            if (!in.is_open()) {
-                std::cerr << "[Assets] Failed to open legacy section " << path << "\n";
-                continue;
-            }
-            try {
-                nlohmann::json section;
-                in >> section;
-                merged[path.stem().string()] = std::move(section);
-            } catch (const std::exception& ex) {
-                std::cerr << "[Assets] Failed to hydrate " << merged_key << " entry from "
-                          << path << ": " << ex.what() << "\n";
-            }
-        }
-
-        if (!merged.is_object()) {
-            merged = nlohmann::json::object();
-        }
-        map_info_json_[merged_key] = std::move(merged);
-};
-
-    hydrate_directory("rooms_data", "rooms");
-    hydrate_directory("trails_data", "trails");
-
-    const auto ensure_object = [&](const char* key) {
-        auto it = map_info_json_.find(key);
-        if (it == map_info_json_.end()) {
-            map_info_json_[key] = nlohmann::json::object();
-            return;
-        }
-        if (!it->is_object()) {
-            std::cerr << "[Assets] map_info." << key << " expected to be an object. Resetting." << "\n";
-            *it = nlohmann::json::object();
-        }
-};
-
-    ensure_object("map_assets_data");
-    ensure_object("map_boundary_data");
-    ensure_object("map_light_data");
-
-    {
-        nlohmann::json& L = map_info_json_["map_light_data"];
-        if (!L.is_object()) {
-            map_info_json_["map_light_data"] = nlohmann::json::object();
-        }
-        nlohmann::json& D = map_info_json_["map_light_data"];
-        if (!D.contains("radius"))          D["radius"] = 0;
-        if (!D.contains("intensity"))       D["intensity"] = 255;
-        if (!D.contains("orbit_radius"))    D["orbit_radius"] = 0;
-        if (!D.contains("update_interval")) D["update_interval"] = 10;
-        if (!D.contains("mult"))            D["mult"] = 0.0;
-        if (!D.contains("fall_off"))        D["fall_off"] = 100;
-        if (!D.contains("min_opacity"))     D["min_opacity"] = 0;
-        if (!D.contains("max_opacity"))     D["max_opacity"] = 255;
-        if (!D.contains("base_color") || !D["base_color"].is_array() || D["base_color"].size() < 4) {
-            D["base_color"] = nlohmann::json::array({255, 255, 255, 255});
-        }
-        if (!D.contains("keys") || !D["keys"].is_array() || D["keys"].empty()) {
-
-            D["keys"] = nlohmann::json::array();
-            D["keys"].push_back(nlohmann::json::array({ 0.0, D["base_color"] }));
-        }
-    }
-    ensure_object("rooms_data");
-    ensure_object("trails_data");
+    map_doc_.mark_dirty();
+    map_doc_.save_async();
 }
 
 void Assets::load_camera_settings_from_json() {
-    if (!map_info_json_.is_object()) {
+    if (!map_doc_.json().is_object()) {
         return;
     }
-    nlohmann::json& camera_settings = map_info_json_["camera_settings"];
+    nlohmann::json& camera_settings = map_doc_.json()["camera_settings"];
     if (!camera_settings.is_object()) {
         camera_settings = nlohmann::json::object();
     }
@@ -262,10 +96,10 @@ void Assets::load_camera_settings_from_json() {
 }
 
 void Assets::write_camera_settings_to_json() {
-    if (!map_info_json_.is_object()) {
+    if (!map_doc_.json().is_object()) {
         return;
     }
-    map_info_json_["camera_settings"] = camera_.camera_settings_to_json();
+    map_doc_.json()["camera_settings"] = camera_.camera_settings_to_json();
 }
 
 void Assets::on_camera_settings_changed() {
@@ -281,11 +115,11 @@ void Assets::apply_map_light_config() {
     if (!scene) {
         return;
     }
-    if (!map_info_json_.is_object()) {
+    if (!map_doc_.json().is_object()) {
         return;
     }
-    auto it = map_info_json_.find("map_light_data");
-    if (it == map_info_json_.end() || !it->is_object()) {
+    auto it = map_doc_.json().find("map_light_data");
+    if (it == map_doc_.json().end() || !it->is_object()) {
         return;
     }
     scene->apply_map_light_config(*it);
@@ -375,11 +209,12 @@ void Assets::ensure_dev_controls() {
     dev_controls_->set_screen_dimensions(screen_width, screen_height);
     dev_controls_->set_rooms(&rooms_);
     dev_controls_->set_input(input);
-    dev_controls_->set_map_info(&map_info_json_, [this]() { on_map_light_changed(); });
-    dev_controls_->set_map_context(&map_info_json_, map_path_);
+    dev_controls_->set_map_info(&map_doc_.json(), [this]() { on_map_light_changed(); });
+    dev_controls_->set_map_context(&map_doc_.json(), map_path_);
 }
 
 void Assets::update_closest_assets(Asset* player, int max_count) {
+    PROFILE_SCOPE("Assets::update_closest_assets");
     for (Asset* asset : closest_assets) {
         if (asset) {
             asset->set_render_player_light(false);
@@ -482,7 +317,7 @@ void Assets::set_input(Input* m) {
             dev_controls_->set_current_room(current_room_);
             dev_controls_->set_screen_dimensions(screen_width, screen_height);
             dev_controls_->set_rooms(&rooms_);
-            dev_controls_->set_map_context(&map_info_json_, map_path_);
+            dev_controls_->set_map_context(&map_doc_.json(), map_path_);
         }
     }
 }
@@ -491,9 +326,13 @@ void Assets::update(const Input& input,
                     int screen_center_x,
                     int screen_center_y)
 {
+    PROFILE_SCOPE("Assets::update");
     (void)screen_center_x;
     (void)screen_center_y;
 
+    ++tick_;
+    camera_.snapshot_tick_state();
+
     Room* detected_room = finder_ ? finder_->getCurrentRoom() : nullptr;
     Room* active_room = detected_room;
     if (dev_controls_ && dev_controls_->is_enabled()) {
@@ -507,6 +346,12 @@ void Assets::update(const Input& input,
     rebuild_active_assets_if_needed();
     update_closest_assets(player, 3);
 
+    for (Asset* a : active_assets) {
+        if (!a) continue;
+        a->prev_pos = a->pos;
+        a->prev_pos_tick = tick_;
+    }
+
     AudioEngine& audio_engine = AudioEngine::instance();
     audio_engine.set_effect_max_distance(static_cast<float>(std::max(1, camera_.get_render_distance_world_margin())));
 
@@ -537,10 +382,7 @@ void Assets::update(const Input& input,
         }
     }
     if (!dev_mode) {
-        for (Asset* a : active_assets) {
-            if (a && a != player)
-                a->update();
-        }
+        update_active_assets_two_phase();
     }
 
     if (dev_controls_ && dev_controls_->is_enabled()) {
@@ -553,11 +395,62 @@ void Assets::update(const Input& input,
         dev_controls_->update_ui(input);
     }
 
-    if (scene && !suppress_render_) scene->render();
+    // Apply this frame's z changes before drawing; only moved assets are re-slotted.
+    if (active_asset_list_) active_asset_list_->commit_repositions();
+    rebuild_active_assets_if_needed();
+
+    if (scene && !suppress_render_) scene->step();
 
     process_removals();
 }
 
+void Assets::update_active_assets_two_phase() {
+    PROFILE_SCOPE("Assets::update_active_assets");
+    think_assets_.clear();
+    for (Asset* a : active_assets) {
+        if (!a) continue;
+        a->prepare_shared_reads();
+        if (a != player) think_assets_.push_back(a);
+    }
+    {
+        PROFILE_SCOPE("Assets::think");
+        JobPool::shared().parallel_for(think_assets_.size(), 16, [this](std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; ++i) {
+                think_assets_[i]->think();
+            }
+        });
+    }
+    PROFILE_SCOPE("Assets::commit");
+    for (Asset* a : think_assets_) {
+        a->commit();
+    }
+}
+
+void Assets::render(float alpha) {
+    PROFILE_SCOPE("Assets::render");
+    if (!scene || suppress_render_) {
+        return;
+    }
+    render_alpha_ = std::clamp(alpha, 0.0f, 1.0f);
+    camera_.begin_interpolated_render(render_alpha_);
+    scene->render();
+    camera_.end_interpolated_render();
+    render_alpha_ = 1.0f;
+}
+
+SDL_Point Assets::render_pos(const Asset* a) const {
+    if (!a) {
+        return SDL_Point{0, 0};
+    }
+    if (render_alpha_ >= 1.0f || a->prev_pos_tick != tick_) {
+        return a->pos;
+    }
+    const float t = render_alpha_;
+    return SDL_Point{
+        a->prev_pos.x + static_cast<int>(std::lround(static_cast<float>(a->pos.x - a->prev_pos.x) * t)),
+        a->prev_pos.y + static_cast<int>(std::lround(static_cast<float>(a->pos.y - a->prev_pos.y) * t)) };
+}
+
 void Assets::set_dev_mode(bool mode) {
     const bool changed = (dev_mode != mode);
     dev_mode = mode;
@@ -580,8 +473,8 @@ void Assets::set_dev_mode(bool mode) {
             dev_controls_->set_screen_dimensions(screen_width, screen_height);
             dev_controls_->set_rooms(&rooms_);
             dev_controls_->set_input(input);
-            dev_controls_->set_map_info(&map_info_json_, [this]() { on_map_light_changed(); });
-            dev_controls_->set_map_context(&map_info_json_, map_path_);
+            dev_controls_->set_map_info(&map_doc_.json(), [this]() { on_map_light_changed(); });
+            dev_controls_->set_map_context(&map_doc_.json(), map_path_);
             dev_controls_->resolve_current_room(current_room_);
         }
         refresh_filtered_active_assets();
@@ -745,6 +638,8 @@ void Assets::mark_active_assets_dirty() {
 
 void Assets::initialize_active_assets(SDL_Point center) {
     const int radius = active_search_radius();
+    spatial_index_.rebuild(all);
+    neighbor_index_.clear();
     active_asset_list_ = std::make_unique<AssetList>(
         all,
         center,
@@ -752,10 +647,23 @@ void Assets::initialize_active_assets(SDL_Point center) {
         std::vector<std::string>{},
         std::vector<std::string>{},
         std::vector<std::string>{},
-        SortMode::ZIndexAsc);
+        SortMode::ZIndexAsc,
+        nullptr,
+        &spatial_index_);
     active_assets_dirty_ = true;
 }
 
+void Assets::on_asset_moved(Asset* a) {
+    spatial_index_.update(a);
+    neighbor_index_.update(a);
+}
+
+void Assets::on_asset_z_changed(Asset* a) {
+    if (active_asset_list_) {
+        active_asset_list_->reposition(a);
+    }
+}
+
 void Assets::update_active_assets(SDL_Point center) {
     if (!active_asset_list_) {
         initialize_active_assets(center);
@@ -765,7 +673,6 @@ void Assets::update_active_assets(SDL_Point center) {
     active_asset_list_->set_center(center);
     active_asset_list_->set_search_radius(active_search_radius());
     active_asset_list_->update();
-    active_assets_dirty_ = true;
 }
 
 void Assets::rebuild_active_assets_if_needed() {
@@ -773,12 +680,23 @@ void Assets::rebuild_active_assets_if_needed() {
         initialize_active_assets(camera_.get_screen_center());
     }
 
-    if (!active_asset_list_ || !active_assets_dirty_) {
+    if (!active_asset_list_) {
+        return;
+    }
+    const std::uint64_t revision = active_asset_list_->revision();
+    const std::uint64_t membership = active_asset_list_->membership_revision();
+    if (!active_assets_dirty_ && revision == active_list_revision_) {
         return;
     }
 
     active_assets.clear();
     active_asset_list_->full_list(active_assets);
+    // Pure reorders keep the same members, so the neighbor grid stays valid.
+    if (active_assets_dirty_ || membership != active_list_membership_revision_) {
+        neighbor_index_.rebuild(active_assets);
+    }
+    active_list_revision_ = revision;
+    active_list_membership_revision_ = membership;
     active_assets_dirty_ = false;
 }
 
@@ -793,6 +711,8 @@ void Assets::schedule_removal(Asset* a) {
 void Assets::process_removals() {
     if (removal_queue.empty()) return;
     for (Asset* a : removal_queue) {
+        spatial_index_.remove(a);
+        neighbor_index_.remove(a);
 
         auto it = std::find_if(owned_assets.begin(), owned_assets.end(),
                                [a](const std::unique_ptr<Asset>& p){ return p.get() == a; });
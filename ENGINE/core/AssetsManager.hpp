@@ -2,14 +2,18 @@
 
 #include "render/camera.hpp"
 #include "asset_list.hpp"
+#include "spatial_index.hpp"
+#include "neighbor_index.hpp"
 #include "asset/asset_library.hpp"
 #include <SDL.h>
 #include <string>
 #include <vector>
 #include <memory>
 #include <deque>
+#include <cstdint>
 #include <nlohmann/json.hpp>
 #include "map_generation/room.hpp"
+#include "map_document.hpp"
 
 class Asset;
 class SceneRenderer;
@@ -22,11 +26,16 @@ class AssetInfo;
 
 class Assets {
 public:
-    Assets(std::vector<Asset>&& loaded, AssetLibrary& library, Asset*, std::vector<Room*> rooms, int screen_width, int screen_height, int screen_center_x, int screen_center_y, int map_radius, SDL_Renderer* renderer, const std::string& map_path);
+    Assets(std::vector<Asset>&& loaded, AssetLibrary& library, Asset*, std::vector<Room*> rooms, int screen_width, int screen_height, int screen_center_x, int screen_center_y, int map_radius, SDL_Renderer* renderer, MapDocument& map_doc);
     ~Assets();
 
     nlohmann::json save_current_room(std::string room_name);
+    // One fixed simulation tick; drawing is done separately by render().
     void update(const Input& input, int screen_center_x, int screen_center_y);
+    // Draws the scene alpha of the way from the previous tick to the current one.
+    void render(float alpha);
+    // Asset position for the frame being drawn (the simulated pos outside render()).
+    SDL_Point render_pos(const Asset* a) const;
     void set_dev_mode(bool mode);
     void set_render_suppressed(bool suppressed);
     void set_input(Input* m);
@@ -70,10 +79,11 @@ public:
 
     void set_editor_current_room(Room* room);
 
-    nlohmann::json& map_info_json() { return map_info_json_; }
-    const nlohmann::json& map_info_json() const { return map_info_json_; }
+    nlohmann::json& map_info_json() { return map_doc_.json(); }
+    const nlohmann::json& map_info_json() const { return map_doc_.json(); }
+    MapDocument& map_document() { return map_doc_; }
     const std::string& map_path() const { return map_path_; }
-    const std::string& map_info_path() const { return map_info_path_; }
+    const std::string& map_info_path() const { return map_doc_.path(); }
 
     AssetLibrary& library();
     const AssetLibrary& library() const;
@@ -87,6 +97,11 @@ public:
     void update_closest_assets(Asset* player, int max_count);
     void mark_active_assets_dirty();
     void initialize_active_assets(SDL_Point center);
+    void on_asset_moved(Asset* a);
+    // Slides the asset to its new draw slot instead of dirtying the whole active list.
+    void on_asset_z_changed(Asset* a);
+    const SpatialIndex& spatial_index() const { return spatial_index_; }
+    const NeighborIndex& neighbor_index() const { return neighbor_index_; }
 
     bool is_dev_mode() const { return dev_mode; }
 
@@ -99,11 +114,9 @@ public:
     Asset* spawn_asset(const std::string& name, SDL_Point world_pos);
 
 private:
-    void load_map_info_json();
     void save_map_info_json();
     void apply_map_light_config();
     void on_map_light_changed();
-    void hydrate_map_info_sections();
     void load_camera_settings_from_json();
     void write_camera_settings_to_json();
     void schedule_removal(Asset* a);
@@ -111,6 +124,9 @@ private:
     void addAsset(const std::string& name, SDL_Point g);
     void update_filtered_active_assets();
     void ensure_dev_controls();
+    // Runs every active non-player asset's update as a parallel think phase
+    // followed by a serial commit in active-list order.
+    void update_active_assets_two_phase();
 
     friend class SceneRenderer;
     friend class Asset;
@@ -135,11 +151,18 @@ private:
     std::vector<Asset*> removal_queue;
 
     AssetLibrary& library_;
+    MapDocument& map_doc_;
     std::string map_path_;
-    std::string map_info_path_;
-    nlohmann::json map_info_json_;
     std::unique_ptr<AssetList> active_asset_list_;
+    SpatialIndex spatial_index_;
+    NeighborIndex neighbor_index_;
     bool active_assets_dirty_ = true;
+    std::uint64_t tick_ = 0;
+    std::vector<Asset*> think_assets_;
+    float render_alpha_ = 1.0f;
+    // Last AssetList revisions copied into active_assets / the neighbor index.
+    std::uint64_t active_list_revision_ = 0;
+    std::uint64_t active_list_membership_revision_ = 0;
 
     struct ClosestEntry {
         double distance_sq;
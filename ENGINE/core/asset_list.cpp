@@ -2,10 +2,13 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <iterator>
 #include <unordered_set>
 
 #include "asset/Asset.hpp"
+#include "core/spatial_index.hpp"
 #include "utils/range_util.hpp"
+#include "utils/frame_profiler.hpp"
 
 namespace {
     bool contains_asset(const std::unordered_set<Asset*>& lookup, Asset* asset) {
@@ -20,7 +23,8 @@ AssetList::AssetList(const std::vector<Asset*>& source_candidates,
                      const std::vector<std::string>& top_bucket_tags,
                      const std::vector<std::string>& bottom_bucket_tags,
                      SortMode sort_mode,
-                     std::function<bool(const Asset*)> eligibility_filter)
+                     std::function<bool(const Asset*)> eligibility_filter,
+                     const SpatialIndex* spatial_index)
     : source_candidates_(source_candidates),
       center_point_(list_center),
       center_asset_(nullptr),
@@ -31,7 +35,8 @@ AssetList::AssetList(const std::vector<Asset*>& source_candidates,
       sort_mode_(sort_mode),
       eligibility_filter_(std::move(eligibility_filter)),
       previous_center_point_(list_center),
-      previous_search_radius_(search_radius) {
+      previous_search_radius_(search_radius),
+      spatial_index_(spatial_index) {
     rebuild_from_scratch();
 }
 
@@ -179,6 +184,10 @@ void AssetList::full_list(std::vector<Asset*>& out) const {
     out.insert(out.end(), list_bottom_unsorted_.begin(), list_bottom_unsorted_.end());
 }
 
+bool AssetList::contains(const Asset* a) const {
+    return slots_.find(a) != slots_.end();
+}
+
 void AssetList::set_center(SDL_Point p) {
     center_point_ = p;
     center_asset_ = nullptr;
@@ -210,6 +219,7 @@ void AssetList::set_tags(const std::vector<std::string>& required_tags,
 }
 
 void AssetList::update() {
+    PROFILE_SCOPE("AssetList::update");
     SDL_Point current_center = resolve_center();
 
     delta_buffer_.clear();
@@ -233,7 +243,7 @@ void AssetList::update() {
 
         bool now_inside = (i < delta_inside_flags_.size()) ? delta_inside_flags_[i] : Range::is_in_range(current_center, asset, search_radius_);
         if (now_inside) {
-            if (!has_all_required_tags(asset, required_tags_)) {
+            if (!has_all_required_tags(asset)) {
                 if (!contains_asset(list_always_ineligible_lookup_, asset)) {
                     list_always_ineligible_.push_back(asset);
                     list_always_ineligible_lookup_.insert(asset);
@@ -248,7 +258,7 @@ void AssetList::update() {
         }
     }
 
-    sort_middle_section();
+    commit_middle_section();
 
     previous_center_point_ = current_center;
     previous_search_radius_ = search_radius_;
@@ -270,21 +280,8 @@ std::vector<Asset*> AssetList::get_union(const AssetList& other,
     std::vector<Asset*> result;
     result.reserve(list_top_unsorted_.size() + list_middle_sorted_.size() + list_bottom_unsorted_.size());
 
-    std::unordered_set<Asset*> other_assets;
-    other_assets.reserve(other.list_top_unsorted_.size() + other.list_middle_sorted_.size() + other.list_bottom_unsorted_.size());
-
-    for (Asset* asset : other.list_top_unsorted_) {
-        other_assets.insert(asset);
-    }
-    for (Asset* asset : other.list_middle_sorted_) {
-        other_assets.insert(asset);
-    }
-    for (Asset* asset : other.list_bottom_unsorted_) {
-        other_assets.insert(asset);
-    }
-
     auto consider = [&](Asset* asset) {
-        if (asset && other_assets.find(asset) != other_assets.end() &&
+        if (asset && other.contains(asset) &&
             has_all_required_tags(asset, required_tags)) {
             result.push_back(asset);
         }
@@ -311,9 +308,16 @@ SDL_Point AssetList::resolve_center() const {
 }
 
 void AssetList::rebuild_from_scratch() {
+    compile_tag_filters();
     list_top_unsorted_.clear();
     list_middle_sorted_.clear();
     list_bottom_unsorted_.clear();
+    slots_.clear();
+    pending_middle_.clear();
+    moved_middle_.clear();
+    middle_tombstones_ = 0;
+    ++revision_;
+    ++membership_revision_;
     list_always_ineligible_.clear();
     list_always_ineligible_lookup_.clear();
     delta_buffer_.clear();
@@ -321,7 +325,7 @@ void AssetList::rebuild_from_scratch() {
 
     SDL_Point center = resolve_center();
 
-    for_each_candidate([&](Asset* asset) {
+    auto consider = [&](Asset* asset) {
         if (asset == nullptr) {
             return;
         }
@@ -334,7 +338,7 @@ void AssetList::rebuild_from_scratch() {
             return;
         }
 
-        if (!has_all_required_tags(asset, required_tags_)) {
+        if (!has_all_required_tags(asset)) {
             if (!contains_asset(list_always_ineligible_lookup_, asset)) {
                 list_always_ineligible_.push_back(asset);
                 list_always_ineligible_lookup_.insert(asset);
@@ -345,9 +349,20 @@ void AssetList::rebuild_from_scratch() {
         if (Range::is_in_range(center, asset, search_radius_)) {
             route_asset_to_section(asset);
         }
-    });
+};
 
-    sort_middle_section();
+    if (uses_spatial_index()) {
+        delta_buffer_.clear();
+        spatial_index_->query_circle(center, search_radius_, delta_buffer_);
+        for (Asset* asset : delta_buffer_) {
+            consider(asset);
+        }
+        delta_buffer_.clear();
+    } else {
+        for_each_candidate(consider);
+    }
+
+    commit_middle_section();
 
     previous_center_point_ = center;
     previous_search_radius_ = search_radius_;
@@ -366,19 +381,46 @@ void AssetList::route_asset_to_section(Asset* a) {
         return;
     }
 
-    remove_from_all_sections(a);
-
-    if (!top_bucket_tags_.empty() && has_any_tag(a, top_bucket_tags_)) {
-        list_top_unsorted_.push_back(a);
-        return;
+    Section target = Section::Middle;
+    if (!top_bucket_tags_.empty() && has_any_tag(a, top_filter_, top_bucket_tags_)) {
+        target = Section::Top;
+    } else if (!bottom_bucket_tags_.empty() && has_any_tag(a, bottom_filter_, bottom_bucket_tags_)) {
+        target = Section::Bottom;
     }
 
-    if (!bottom_bucket_tags_.empty() && has_any_tag(a, bottom_bucket_tags_)) {
-        list_bottom_unsorted_.push_back(a);
-        return;
+    auto existing = slots_.find(a);
+    if (existing != slots_.end()) {
+        if (existing->second.section == target) {
+            return;
+        }
+        remove_from_all_sections(a);
     }
 
-    list_middle_sorted_.push_back(a);
+    Slot slot;
+    slot.section = target;
+    switch (target) {
+        case Section::Top:
+            slot.index = list_top_unsorted_.size();
+            list_top_unsorted_.push_back(a);
+            break;
+        case Section::Bottom:
+            slot.index = list_bottom_unsorted_.size();
+            list_bottom_unsorted_.push_back(a);
+            break;
+        case Section::Middle:
+            if (sort_mode_ == SortMode::Unsorted) {
+                slot.index = list_middle_sorted_.size();
+                list_middle_sorted_.push_back(a);
+            } else {
+                slot.index = pending_middle_.size();
+                slot.pending = true;
+                pending_middle_.push_back(a);
+            }
+            break;
+    }
+    slots_[a] = slot;
+    ++revision_;
+    ++membership_revision_;
 }
 
 void AssetList::remove_from_all_sections(Asset* a) {
@@ -386,13 +428,95 @@ void AssetList::remove_from_all_sections(Asset* a) {
         return;
     }
 
-    auto remover = [a](std::vector<Asset*>& vec) {
-        vec.erase(std::remove(vec.begin(), vec.end(), a), vec.end());
+    auto it = slots_.find(a);
+    if (it == slots_.end()) {
+        return;
+    }
+    const Slot slot = it->second;
+    slots_.erase(it);
+    ++revision_;
+    ++membership_revision_;
+
+    auto swap_remove = [this](std::vector<Asset*>& vec, std::size_t index) {
+        if (index >= vec.size()) {
+            return;
+        }
+        if (index + 1 != vec.size()) {
+            vec[index] = vec.back();
+            auto moved = slots_.find(vec[index]);
+            if (moved != slots_.end()) {
+                moved->second.index = index;
+            }
+        }
+        vec.pop_back();
 };
 
-    remover(list_top_unsorted_);
-    remover(list_middle_sorted_);
-    remover(list_bottom_unsorted_);
+    switch (slot.section) {
+        case Section::Top:
+            swap_remove(list_top_unsorted_, slot.index);
+            break;
+        case Section::Bottom:
+            swap_remove(list_bottom_unsorted_, slot.index);
+            break;
+        case Section::Middle:
+            if (slot.pending) {
+                if (slot.index < pending_middle_.size()) {
+                    pending_middle_[slot.index] = nullptr;
+                }
+            } else if (sort_mode_ == SortMode::Unsorted) {
+                swap_remove(list_middle_sorted_, slot.index);
+            } else if (slot.index < list_middle_sorted_.size()) {
+                list_middle_sorted_[slot.index] = nullptr;
+                ++middle_tombstones_;
+            }
+            break;
+    }
+}
+
+AssetList::TagFilter AssetList::compile_tag_filter(const std::vector<std::string>& tags) {
+    TagFilter filter;
+    const TagInterner& interner = TagInterner::instance();
+    filter.known = interner.known_mask();
+    filter.has_unknown = interner.find_mask(tags, filter.mask) > 0;
+    return filter;
+}
+
+bool AssetList::mask_usable(const Asset* a, const TagFilter& filter) {
+    if (!a->info->tag_mask_complete) {
+        return false;
+    }
+    // An unknown filter tag may have been interned since by an asset loaded later.
+    return !filter.has_unknown || (a->info->tag_mask & ~filter.known).none();
+}
+
+void AssetList::compile_tag_filters() {
+    required_filter_ = compile_tag_filter(required_tags_);
+    top_filter_ = compile_tag_filter(top_bucket_tags_);
+    bottom_filter_ = compile_tag_filter(bottom_bucket_tags_);
+}
+
+bool AssetList::has_all_required_tags(const Asset* a) const {
+    if (a == nullptr || !a->info) {
+        return false;
+    }
+    if (required_tags_.empty()) {
+        return true;
+    }
+    if (mask_usable(a, required_filter_)) {
+        return !required_filter_.has_unknown &&
+               (a->info->tag_mask & required_filter_.mask) == required_filter_.mask;
+    }
+    return has_all_required_tags(a, required_tags_);
+}
+
+bool AssetList::has_any_tag(const Asset* a, const TagFilter& filter, const std::vector<std::string>& tags) const {
+    if (a == nullptr || !a->info || tags.empty()) {
+        return false;
+    }
+    if (mask_usable(a, filter)) {
+        return (a->info->tag_mask & filter.mask).any();
+    }
+    return has_any_tag(a, tags);
 }
 
 bool AssetList::has_all_required_tags(const Asset* a, const std::vector<std::string>& req) const {
@@ -434,32 +558,139 @@ bool AssetList::is_asset_eligible(const Asset* a) const {
     return a != nullptr && eligibility_filter_(a);
 }
 
+bool AssetList::middle_less(const Asset* lhs, const Asset* rhs) const {
+    if (sort_mode_ == SortMode::ZIndexDesc) {
+        if (lhs->z_index == rhs->z_index) {
+            return lhs > rhs;
+        }
+        return lhs->z_index > rhs->z_index;
+    }
+    if (lhs->z_index == rhs->z_index) {
+        return lhs < rhs;
+    }
+    return lhs->z_index < rhs->z_index;
+}
+
 void AssetList::sort_middle_section() {
-    switch (sort_mode_) {
-        case SortMode::Unsorted:
-            break;
-        case SortMode::ZIndexAsc:
-            std::sort(list_middle_sorted_.begin(), list_middle_sorted_.end(), [](const Asset* lhs, const Asset* rhs) {
-                if (lhs == nullptr || rhs == nullptr) {
-                    return rhs != nullptr;
-                }
-                if (lhs->z_index == rhs->z_index) {
-                    return lhs < rhs;
-                }
-                return lhs->z_index < rhs->z_index;
-            });
-            break;
-        case SortMode::ZIndexDesc:
-            std::sort(list_middle_sorted_.begin(), list_middle_sorted_.end(), [](const Asset* lhs, const Asset* rhs) {
-                if (lhs == nullptr || rhs == nullptr) {
-                    return lhs != nullptr;
-                }
-                if (lhs->z_index == rhs->z_index) {
-                    return lhs > rhs;
-                }
-                return lhs->z_index > rhs->z_index;
-            });
-            break;
+    if (sort_mode_ != SortMode::Unsorted) {
+        std::sort(list_middle_sorted_.begin(), list_middle_sorted_.end(), [this](const Asset* lhs, const Asset* rhs) {
+            return middle_less(lhs, rhs);
+        });
+    }
+    reindex_middle_section();
+    ++revision_;
+}
+
+void AssetList::reposition(Asset* a) {
+    if (a == nullptr || sort_mode_ == SortMode::Unsorted) {
+        return;
+    }
+    auto it = slots_.find(a);
+    if (it == slots_.end() || it->second.section != Section::Middle || it->second.pending) {
+        return;
+    }
+    moved_middle_.push_back(a);
+}
+
+void AssetList::commit_repositions() {
+    commit_middle_section();
+}
+
+// Insertion-sort step for one member: z changes from walking are a few pixels,
+// so the member usually moves only a handful of slots.
+bool AssetList::slide_into_place(Asset* a) {
+    auto it = slots_.find(a);
+    if (it == slots_.end() || it->second.section != Section::Middle || it->second.pending) {
+        return false;
+    }
+    std::size_t idx = it->second.index;
+    if (idx >= list_middle_sorted_.size() || list_middle_sorted_[idx] != a) {
+        return false;
+    }
+    const std::size_t start = idx;
+    while (idx > 0 && middle_less(a, list_middle_sorted_[idx - 1])) {
+        list_middle_sorted_[idx] = list_middle_sorted_[idx - 1];
+        slots_[list_middle_sorted_[idx]].index = idx;
+        --idx;
+    }
+    while (idx + 1 < list_middle_sorted_.size() && middle_less(list_middle_sorted_[idx + 1], a)) {
+        list_middle_sorted_[idx] = list_middle_sorted_[idx + 1];
+        slots_[list_middle_sorted_[idx]].index = idx;
+        ++idx;
+    }
+    list_middle_sorted_[idx] = a;
+    it->second.index = idx;
+    return idx != start;
+}
+
+void AssetList::commit_middle_section() {
+    if (sort_mode_ == SortMode::Unsorted) {
+        pending_middle_.clear();
+        moved_middle_.clear();
+        return;
+    }
+
+    auto less = [this](const Asset* lhs, const Asset* rhs) { return middle_less(lhs, rhs); };
+    bool changed = false;
+    bool needs_reindex = false;
+
+    if (middle_tombstones_ > 0) {
+        list_middle_sorted_.erase(std::remove(list_middle_sorted_.begin(), list_middle_sorted_.end(), nullptr), list_middle_sorted_.end());
+        middle_tombstones_ = 0;
+        changed = true;
+        needs_reindex = true;
+    }
+
+    if (!moved_middle_.empty()) {
+        if (needs_reindex) {
+            reindex_middle_section();
+            needs_reindex = false;
+        }
+        for (Asset* a : moved_middle_) {
+            if (slide_into_place(a)) {
+                changed = true;
+            }
+        }
+        moved_middle_.clear();
+    }
+
+    // Safety net for z edits that were never reported through reposition().
+    // Once the moved members are in place this is a single linear pass.
+    if (!std::is_sorted(list_middle_sorted_.begin(), list_middle_sorted_.end(), less)) {
+        std::sort(list_middle_sorted_.begin(), list_middle_sorted_.end(), less);
+        changed = true;
+        needs_reindex = true;
+    }
+
+    pending_middle_.erase(std::remove(pending_middle_.begin(), pending_middle_.end(), nullptr), pending_middle_.end());
+    if (!pending_middle_.empty()) {
+        std::sort(pending_middle_.begin(), pending_middle_.end(), less);
+        merge_buffer_.clear();
+        merge_buffer_.reserve(list_middle_sorted_.size() + pending_middle_.size());
+        std::merge(list_middle_sorted_.begin(), list_middle_sorted_.end(),
+                   pending_middle_.begin(), pending_middle_.end(),
+                   std::back_inserter(merge_buffer_), less);
+        list_middle_sorted_.swap(merge_buffer_);
+        pending_middle_.clear();
+        changed = true;
+        needs_reindex = true;
+    }
+
+    if (needs_reindex) {
+        reindex_middle_section();
+    }
+    if (changed) {
+        ++revision_;
+    }
+}
+
+void AssetList::reindex_middle_section() {
+    for (std::size_t i = 0; i < list_middle_sorted_.size(); ++i) {
+        auto it = slots_.find(list_middle_sorted_[i]);
+        if (it != slots_.end()) {
+            it->second.index = i;
+            it->second.pending = false;
+        }
     }
 }
 
@@ -468,7 +699,7 @@ void AssetList::get_delta_area_assets(SDL_Point prev_center,
                                       SDL_Point curr_center,
                                       int curr_radius,
                                       std::vector<Asset*>& out_changed) const {
-    for_each_candidate([&](Asset* asset) {
+    auto consider = [&](Asset* asset) {
         if (asset == nullptr) {
             return;
         }
@@ -480,7 +711,36 @@ void AssetList::get_delta_area_assets(SDL_Point prev_center,
                 delta_inside_flags_.push_back(now_inside);
             }
         }
-    });
+};
+
+    if (!uses_spatial_index()) {
+        for_each_candidate(consider);
+        return;
+    }
+
+    // Candidates from the ring between the two circles are appended after the existing
+    // entries, then compacted in place to the ones that actually crossed the boundary.
+    const std::size_t first = out_changed.size();
+    spatial_index_->query_delta(prev_center, prev_radius, curr_center, curr_radius, out_changed);
+    const std::size_t last = out_changed.size();
+    std::size_t write = first;
+    for (std::size_t i = first; i < last; ++i) {
+        Asset* asset = out_changed[i];
+        if (asset == nullptr || contains_asset(list_always_ineligible_lookup_, asset)) {
+            continue;
+        }
+        bool was_inside = Range::is_in_range(prev_center, asset, prev_radius);
+        bool now_inside = Range::is_in_range(curr_center, asset, curr_radius);
+        if (was_inside != now_inside) {
+            out_changed[write++] = asset;
+            delta_inside_flags_.push_back(now_inside);
+        }
+    }
+    out_changed.resize(write);
+}
+
+bool AssetList::uses_spatial_index() const {
+    return spatial_index_ != nullptr && !inherit_parent_view_;
 }
 
 void AssetList::for_each_candidate(const std::function<void(Asset*)>& f) const {
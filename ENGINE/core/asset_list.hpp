@@ -1,14 +1,19 @@
 #pragma once
 
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
 #include <SDL.h>
 
+#include "utils/tag_interner.hpp"
+
 class Asset;
+class SpatialIndex;
 
 enum class SortMode {
     Unsorted,
@@ -18,7 +23,9 @@ enum class SortMode {
 
 class AssetList {
 public:
-    AssetList(const std::vector<Asset*>& source_candidates, SDL_Point list_center, int search_radius, const std::vector<std::string>& required_tags, const std::vector<std::string>& top_bucket_tags, const std::vector<std::string>& bottom_bucket_tags, SortMode sort_mode, std::function<bool(const Asset*)> eligibility_filter = nullptr);
+    // When a spatial index covering the same assets as source_candidates is supplied, rebuilds
+    // and delta updates only visit the grid cells touched by the search circles.
+    AssetList(const std::vector<Asset*>& source_candidates, SDL_Point list_center, int search_radius, const std::vector<std::string>& required_tags, const std::vector<std::string>& top_bucket_tags, const std::vector<std::string>& bottom_bucket_tags, SortMode sort_mode, std::function<bool(const Asset*)> eligibility_filter = nullptr, const SpatialIndex* spatial_index = nullptr);
 
     AssetList(const std::vector<Asset*>& source_candidates, Asset* center_asset, int search_radius, const std::vector<std::string>& required_tags, const std::vector<std::string>& top_bucket_tags, const std::vector<std::string>& bottom_bucket_tags, SortMode sort_mode, std::function<bool(const Asset*)> eligibility_filter = nullptr);
 
@@ -40,6 +47,7 @@ public:
     const std::vector<Asset*>& middle_sorted() const;
     const std::vector<Asset*>& bottom_unsorted() const;
     void full_list(std::vector<Asset*>& out) const;
+    bool contains(const Asset* a) const;
 
     void set_center(SDL_Point p);
     void set_center(Asset* a);
@@ -50,6 +58,17 @@ public:
     void update();
     void update(SDL_Point new_center);
 
+    // Call when a member's z_index changed. The member is slid to its new place
+    // in the sorted middle section on the next commit instead of re-sorting it.
+    void reposition(Asset* a);
+    // Applies queued repositions and pending insertions without a spatial update.
+    void commit_repositions();
+
+    // Bumped whenever the flattened full_list() would change: membership or order.
+    std::uint64_t revision() const { return revision_; }
+    // Bumped only when members are added or removed.
+    std::uint64_t membership_revision() const { return membership_revision_; }
+
     std::vector<Asset*> get_union(const AssetList& other, const std::vector<std::string>& required_tags) const;
 
     int search_radius() const { return search_radius_; }
@@ -59,10 +78,30 @@ private:
     void rebuild_from_scratch();
     void route_asset_to_section(Asset* a);
     void remove_from_all_sections(Asset* a);
+    // Tag lists compiled to bitmasks of already-interned tags. Filter strings are
+    // never interned: a tag no asset has is `unknown`, which makes a require
+    // filter match nothing and drops out of an any-of filter. `known` holds the
+    // ids that existed at compile time; assets carrying newer tags are matched
+    // against the string lists instead.
+    struct TagFilter {
+        TagMask mask;
+        TagMask known;
+        bool    has_unknown = false;
+    };
+    static TagFilter compile_tag_filter(const std::vector<std::string>& tags);
+    static bool mask_usable(const Asset* a, const TagFilter& filter);
+    void compile_tag_filters();
+    bool has_all_required_tags(const Asset* a) const;
+    bool has_any_tag(const Asset* a, const TagFilter& filter, const std::vector<std::string>& tags) const;
     bool has_all_required_tags(const Asset* a, const std::vector<std::string>& req) const;
     bool has_any_tag(const Asset* a, const std::vector<std::string>& tags) const;
     void sort_middle_section();
+    void commit_middle_section();
+    bool slide_into_place(Asset* a);
+    void reindex_middle_section();
+    bool middle_less(const Asset* lhs, const Asset* rhs) const;
     bool is_asset_eligible(const Asset* a) const;
+    bool uses_spatial_index() const;
 
     void get_delta_area_assets(SDL_Point prev_center, int prev_radius, SDL_Point curr_center, int curr_radius, std::vector<Asset*>& out_changed) const;
 
@@ -75,12 +114,32 @@ private:
     std::vector<std::string> required_tags_;
     std::vector<std::string> top_bucket_tags_;
     std::vector<std::string> bottom_bucket_tags_;
+    TagFilter           required_filter_;
+    TagFilter           top_filter_;
+    TagFilter           bottom_filter_;
     SortMode            sort_mode_ = SortMode::Unsorted;
 
     std::vector<Asset*> list_top_unsorted_;
     std::vector<Asset*> list_middle_sorted_;
     std::vector<Asset*> list_bottom_unsorted_;
 
+    // Where each member currently lives, so membership tests and removals are O(1).
+    // Unsorted sections swap-remove; the sorted middle section leaves a null tombstone
+    // and queues insertions, and both are folded in by commit_middle_section().
+    enum class Section : unsigned char { Top, Middle, Bottom };
+    struct Slot {
+        Section     section = Section::Middle;
+        std::size_t index   = 0;
+        bool        pending = false;
+};
+    std::unordered_map<const Asset*, Slot> slots_;
+    std::vector<Asset*> pending_middle_;
+    std::vector<Asset*> merge_buffer_;
+    std::size_t         middle_tombstones_ = 0;
+    std::vector<Asset*> moved_middle_;
+    std::uint64_t       revision_ = 0;
+    std::uint64_t       membership_revision_ = 0;
+
     std::vector<Asset*> list_always_ineligible_;
     std::unordered_set<Asset*> list_always_ineligible_lookup_;
 
@@ -94,6 +153,8 @@ private:
     std::vector<Asset*> delta_buffer_;
     mutable std::vector<bool> delta_inside_flags_;
 
+    const SpatialIndex* spatial_index_ = nullptr;
+
     // Optional view of a parent list's current filtered contents as our candidate set.
     const AssetList* parent_provider_ = nullptr;
     bool inherit_parent_view_ = false;
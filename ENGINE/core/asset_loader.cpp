@@ -1,4 +1,5 @@
 #include "asset_loader.hpp"
+#include "map_document.hpp"
 #include <fstream>
 #include <iostream>
 #include <numeric>
@@ -14,6 +15,8 @@
 #include "map_generation/room.hpp"
 #include "utils/area.hpp"
 #include "map_generation/generate_rooms.hpp"
+#include "utils/map_seed.hpp"
+#include "ui/loading_screen.hpp"
 #include <nlohmann/json.hpp>
 using json = nlohmann::json;
 
@@ -59,7 +62,21 @@ renderer_(renderer)
                 }
             }
         }
-        asset_library_->loadAnimationsFor(renderer_, used);
+        int out_w = 0, out_h = 0;
+        SDL_GetRendererOutputSize(renderer_, &out_w, &out_h);
+        LoadingScreen loading(renderer_, out_w, out_h);
+        loading.init();
+        Uint32 last_draw = 0;
+        asset_library_->loadAnimationsFor(renderer_, used, [&](float fraction, const std::string& stage) {
+            const Uint32 now = SDL_GetTicks();
+            if (now - last_draw < 33 && fraction < 1.0f) return;
+            last_draw = now;
+            SDL_PumpEvents();
+            SDL_SetRenderTarget(renderer_, nullptr);
+            loading.set_progress(fraction, stage);
+            loading.draw_frame();
+            SDL_RenderPresent(renderer_);
+        });
     }
 	finalizeAssets();
 	auto distant_boundary = collectDistantAssets(0,2000);
@@ -196,13 +213,14 @@ std::vector<Asset*> AssetLoader::collectDistantAssets(int fade_start_distance, i
 }
 
 void AssetLoader::loadRooms() {
-        GenerateRooms generator(map_layers_, map_center_x_, map_center_y_, map_path_, map_info_path_);
+        GenerateRooms generator(map_layers_, map_center_x_, map_center_y_, map_path_, map_info_path_, map_seed_);
         nlohmann::json empty_boundary = nlohmann::json::object();
         nlohmann::json empty_rooms    = nlohmann::json::object();
         nlohmann::json empty_trails   = nlohmann::json::object();
         nlohmann::json empty_assets   = nlohmann::json::object();
         auto room_ptrs = generator.build( asset_library_.get(), map_radius_, map_boundary_data_ ? *map_boundary_data_ : empty_boundary, rooms_data_        ? *rooms_data_        : empty_rooms, trails_data_       ? *trails_data_       : empty_trails, map_assets_data_   ? *map_assets_data_   : empty_assets);
         for (auto& up : room_ptrs) {
+                up->set_map_document(map_doc_.get());
                 rooms_.push_back(up.get());
                 all_rooms_.push_back(std::move(up));
 	}
@@ -248,59 +266,26 @@ std::vector<Area> AssetLoader::getAllRoomAndTrailAreas() const {
 }
 
 void AssetLoader::load_map_json() {
-        map_info_path_ = map_path_ + "/map_info.json";
-        std::ifstream f(map_info_path_);
-        if (!f) throw std::runtime_error("Failed to open map_info.json");
+        map_doc_ = std::make_unique<MapDocument>(map_path_);
+        if (!map_doc_->load()) throw std::runtime_error("Failed to load map_info.json");
+        map_info_path_ = map_doc_->path();
+        const json& info = map_doc_->json();
 
-        json j;
-        f >> j;
-        map_info_json_ = std::move(j);
-
-        map_radius_     = map_info_json_.value("map_radius", 0.0);
+        map_radius_     = info.value("map_radius", 0.0);
         map_center_x_   = map_center_y_ = map_radius_;
-        map_layers_.clear();
-
-        auto layers_it = map_info_json_.find("map_layers");
-        if (layers_it != map_info_json_.end() && layers_it->is_array()) {
-                for (const auto& layer_entry : *layers_it) {
-                        LayerSpec spec;
-                        spec.level     = layer_entry.value("level", 0);
-                        spec.radius    = layer_entry.value("radius", 0);
-                        spec.max_rooms = layer_entry.value("max_rooms", 0);
-
-                        auto rooms_it = layer_entry.find("rooms");
-                        if (rooms_it != layer_entry.end() && rooms_it->is_array()) {
-                                for (const auto& room_entry : *rooms_it) {
-                                        RoomSpec rs;
-                                        rs.name          = room_entry.value("name", "unnamed");
-                                        rs.max_instances = room_entry.value("max_instances", 1);
+        map_layers_     = load_layer_specs(info);
 
-                                        auto required_it = room_entry.find("required_children");
-                                        if (required_it != room_entry.end() && required_it->is_array()) {
-                                                for (const auto& child : *required_it) {
-                                                        if (child.is_string()) {
-                                                                rs.required_children.push_back(child.get<std::string>());
-                                                        } else {
-                                                                std::cerr << "[AssetLoader] Room '" << rs.name
-                                                                          << "' has non-string entry in 'required_children'; skipping.\n";
-                                                        }
-                                                }
-                                        }
-
-                                        spec.rooms.push_back(std::move(rs));
-                                }
-                        }
-
-                        map_layers_.push_back(std::move(spec));
-                }
+        // A map may pin "map_seed" to rebuild the same layout every run.
+        auto seed_it = info.find("map_seed");
+        if (seed_it != info.end() && seed_it->is_number_integer()) {
+                map_seed_ = static_cast<std::uint32_t>(seed_it->get<std::int64_t>());
+        } else {
+                map_seed_ = map_seed::random();
         }
+        std::cout << "[AssetLoader] Map seed: " << map_seed_ << "\n";
 
-        map_assets_data_   = &map_info_json_["map_assets_data"];
-        if (!map_assets_data_->is_object()) *map_assets_data_ = nlohmann::json::object();
-        map_boundary_data_ = &map_info_json_["map_boundary_data"];
-        if (!map_boundary_data_->is_object()) *map_boundary_data_ = nlohmann::json::object();
-        rooms_data_        = &map_info_json_["rooms_data"];
-        if (!rooms_data_->is_object()) *rooms_data_ = nlohmann::json::object();
-        trails_data_       = &map_info_json_["trails_data"];
-        if (!trails_data_->is_object()) *trails_data_ = nlohmann::json::object();
+        map_assets_data_   = &map_doc_->section("map_assets_data");
+        map_boundary_data_ = &map_doc_->section("map_boundary_data");
+        rooms_data_        = &map_doc_->section("rooms_data");
+        trails_data_       = &map_doc_->section("trails_data");
 }
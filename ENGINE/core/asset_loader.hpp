@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <memory>
@@ -13,6 +14,7 @@ class AssetLibrary;
 struct SDL_Texture;
 struct SDL_Renderer;
 struct LayerSpec;
+class MapDocument;
 
 class AssetLoader {
 
@@ -28,6 +30,8 @@ class AssetLoader {
     AssetLibrary* getAssetLibrary() const { return asset_library_.get(); }
     const std::vector<Room*>& getRooms() const { return rooms_; }
     double getMapRadius() const { return map_radius_; }
+    std::uint32_t getMapSeed() const { return map_seed_; }
+    MapDocument& getMapDocument() { return *map_doc_; }
 
 	private:
     std::string map_path_;
@@ -39,8 +43,9 @@ class AssetLoader {
     double map_center_x_ = 0.0;
     double map_center_y_ = 0.0;
     double map_radius_   = 0.0;
+    std::uint32_t map_seed_ = 0;
     std::string map_info_path_;
-    nlohmann::json map_info_json_;
+    std::unique_ptr<MapDocument> map_doc_;
     nlohmann::json* map_assets_data_   = nullptr;
     nlohmann::json* map_boundary_data_ = nullptr;
     nlohmann::json* rooms_data_        = nullptr;
@@ -0,0 +1,258 @@
+#include "map_document.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <system_error>
+#include <utility>
+
+MapDocument::MapDocument(const std::string& map_dir)
+: map_dir_(map_dir),
+  path_(map_dir.empty() ? std::string{} : (map_dir + "/map_info.json")) {}
+
+MapDocument::~MapDocument() {
+    flush();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    wake_.notify_all();
+    if (writer_.joinable()) {
+        writer_.join();
+    }
+}
+
+bool MapDocument::load() {
+    json_ = nlohmann::json::object();
+    dirty_ = false;
+    if (path_.empty()) {
+        return false;
+    }
+
+    std::ifstream in(path_);
+    if (!in.is_open()) {
+        std::cerr << "[MapDocument] Failed to open " << path_ << "\n";
+        return false;
+    }
+    try {
+        in >> json_;
+    } catch (const std::exception& e) {
+        std::cerr << "[MapDocument] Failed to parse " << path_ << ": " << e.what() << "\n";
+        json_ = nlohmann::json::object();
+        return false;
+    }
+    if (!json_.is_object()) {
+        json_ = nlohmann::json::object();
+    }
+    hydrate_sections();
+    return true;
+}
+
+nlohmann::json& MapDocument::section(const std::string& key) {
+    nlohmann::json& s = json_[key];
+    if (!s.is_object()) {
+        s = nlohmann::json::object();
+    }
+    return s;
+}
+
+void MapDocument::save_async() {
+    if (path_.empty() || !dirty_) {
+        return;
+    }
+    auto snapshot = std::make_unique<nlohmann::json>(json_);
+    dirty_ = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pending_ = std::move(snapshot);
+        if (!writer_.joinable()) {
+            writer_ = std::thread([this]() { writer_loop(); });
+        }
+    }
+    wake_.notify_one();
+}
+
+void MapDocument::flush() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    idle_.wait(lock, [this]() { return !pending_ && !writing_; });
+}
+
+void MapDocument::writer_loop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+        wake_.wait(lock, [this]() { return stop_ || pending_; });
+        if (!pending_) {
+            return;
+        }
+        std::unique_ptr<nlohmann::json> snapshot = std::move(pending_);
+        writing_ = true;
+        lock.unlock();
+        write_atomic(*snapshot);
+        snapshot.reset();
+        lock.lock();
+        writing_ = false;
+        if (!pending_) {
+            idle_.notify_all();
+        }
+    }
+}
+
+bool MapDocument::write_atomic(const nlohmann::json& snapshot) const {
+    const std::string tmp_path = path_ + ".tmp";
+    {
+        std::ofstream out(tmp_path, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) {
+            std::cerr << "[MapDocument] Failed to write " << tmp_path << "\n";
+            return false;
+        }
+        try {
+            out << snapshot.dump(2);
+        } catch (const std::exception& e) {
+            std::cerr << "[MapDocument] Failed to serialize map_info.json: " << e.what() << "\n";
+            return false;
+        }
+        out.flush();
+        if (!out) {
+            std::cerr << "[MapDocument] Failed to write " << tmp_path << "\n";
+            return false;
+        }
+    }
+    std::error_code ec;
+    std::filesystem::rename(tmp_path, path_, ec);
+    if (ec) {
+        std::cerr << "[MapDocument] Failed to replace " << path_ << ": " << ec.message() << "\n";
+        std::filesystem::remove(tmp_path, ec);
+        return false;
+    }
+    return true;
+}
+
+void MapDocument::hydrate_sections() {
+    if (!json_.is_object()) {
+        return;
+    }
+    if (map_dir_.empty()) {
+        return;
+    }
+
+    const auto hydrate_from_file = [&](const char* legacy_key, const char* merged_key) {
+        if (json_.contains(merged_key)) {
+            return;
+        }
+        auto it = json_.find(legacy_key);
+        if (it == json_.end() || !it->is_string()) {
+            return;
+        }
+        const std::string file_path = map_dir_ + "/" + it->get<std::string>();
+        std::ifstream section(file_path);
+        if (!section.is_open()) {
+            std::cerr << "[MapDocument] Legacy map section missing: " << file_path << "\n";
+            return;
+        }
+        try {
+            nlohmann::json data;
+            section >> data;
+            json_[merged_key] = std::move(data);
+        } catch (const std::exception& ex) {
+            std::cerr << "[MapDocument] Failed to hydrate " << merged_key << " from "
+                      << file_path << ": " << ex.what() << "\n";
+        }
+};
+
+    hydrate_from_file("map_assets", "map_assets_data");
+    hydrate_from_file("map_boundary", "map_boundary_data");
+    hydrate_from_file("map_light", "map_light_data");
+
+    const auto hydrate_directory = [&](const char* merged_key, const char* directory_name) {
+        if (json_.contains(merged_key) && json_[merged_key].is_object()) {
+            return;
+        }
+
+        const std::filesystem::path dir = std::filesystem::path(map_dir_) / directory_name;
+        if (!std::filesystem::exists(dir) || !std::filesystem::is_directory(dir)) {
+            return;
+        }
+
+        std::error_code ec;
+        std::filesystem::directory_iterator it(dir, ec);
+        if (ec) {
+            std::cerr << "[MapDocument] Failed to scan legacy directory " << dir << ": "
+                      << ec.message() << "\n";
+            return;
+        }
+
+        nlohmann::json merged = nlohmann::json::object();
+        for (const auto& entry : it) {
+            if (!entry.is_regular_file()) {
+                continue;
+            }
+            const auto& path = entry.path();
+            if (path.extension() != ".json") {
+                continue;
+            }
+            std::ifstream in(path);
+            if (!in.is_open()) {
+                std::cerr << "[MapDocument] Failed to open legacy section " << path << "\n";
+                continue;
+            }
+            try {
+                nlohmann::json section;
+                in >> section;
+                merged[path.stem().string()] = std::move(section);
+            } catch (const std::exception& ex) {
+                std::cerr << "[MapDocument] Failed to hydrate " << merged_key << " entry from "
+                          << path << ": " << ex.what() << "\n";
+            }
+        }
+
+        if (!merged.is_object()) {
+            merged = nlohmann::json::object();
+        }
+        json_[merged_key] = std::move(merged);
+};
+
+    hydrate_directory("rooms_data", "rooms");
+    hydrate_directory("trails_data", "trails");
+
+    const auto ensure_object = [&](const char* key) {
+        auto it = json_.find(key);
+        if (it == json_.end()) {
+            json_[key] = nlohmann::json::object();
+            return;
+        }
+        if (!it->is_object()) {
+            std::cerr << "[MapDocument] map_info." << key << " expected to be an object. Resetting." << "\n";
+            *it = nlohmann::json::object();
+        }
+};
+
+    ensure_object("map_assets_data");
+    ensure_object("map_boundary_data");
+    ensure_object("map_light_data");
+
+    {
+        nlohmann::json& L = json_["map_light_data"];
+        if (!L.is_object()) {
+            json_["map_light_data"] = nlohmann::json::object();
+        }
+        nlohmann::json& D = json_["map_light_data"];
+        if (!D.contains("radius"))          D["radius"] = 0;
+        if (!D.contains("intensity"))       D["intensity"] = 255;
+        if (!D.contains("orbit_radius"))    D["orbit_radius"] = 0;
+        if (!D.contains("update_interval")) D["update_interval"] = 10;
+        if (!D.contains("mult"))            D["mult"] = 0.0;
+        if (!D.contains("fall_off"))        D["fall_off"] = 100;
+        if (!D.contains("min_opacity"))     D["min_opacity"] = 0;
+        if (!D.contains("max_opacity"))     D["max_opacity"] = 255;
+        if (!D.contains("base_color") || !D["base_color"].is_array() || D["base_color"].size() < 4) {
+            D["base_color"] = nlohmann::json::array({255, 255, 255, 255});
+        }
+        if (!D.contains("keys") || !D["keys"].is_array() || D["keys"].empty()) {
+
+            D["keys"] = nlohmann::json::array();
+            D["keys"].push_back(nlohmann::json::array({ 0.0, D["base_color"] }));
+        }
+    }
+    ensure_object("rooms_data");
+    ensure_object("trails_data");
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <nlohmann/json.hpp>
+
+// The parsed map_info.json of one map directory. It is parsed once by the
+// loader and handed by reference to everything that reads or edits map data
+// (room generation, Assets, the scene's light source, dev tools).
+//
+// Editors change json() in place and call mark_dirty(). save_async() copies
+// the whole document when it is dirty and a background writer serialises the
+// copy to "map_info.json.tmp", then renames it over the original, so a crash
+// mid-write never leaves a truncated map. Snapshots queued while a write is
+// running replace each other; only the newest is written. Anything that reads
+// or writes map_info.json directly must flush() first.
+class MapDocument {
+public:
+    explicit MapDocument(const std::string& map_dir);
+    ~MapDocument();
+
+    MapDocument(const MapDocument&) = delete;
+    MapDocument& operator=(const MapDocument&) = delete;
+
+    // Parses map_info.json and fills in legacy split files and default
+    // sections. Returns false if the file is missing or is not valid JSON.
+    bool load();
+
+    nlohmann::json& json() { return json_; }
+    const nlohmann::json& json() const { return json_; }
+    const std::string& map_dir() const { return map_dir_; }
+    const std::string& path() const { return path_; }
+
+    // Top-level object stored under key, replacing any non-object value.
+    nlohmann::json& section(const std::string& key);
+
+    void mark_dirty() { dirty_ = true; }
+    bool is_dirty() const { return dirty_; }
+
+    void save_async();
+    // Blocks until every queued snapshot is on disk.
+    void flush();
+
+private:
+    void hydrate_sections();
+    void writer_loop();
+    bool write_atomic(const nlohmann::json& snapshot) const;
+
+    std::string map_dir_;
+    std::string path_;
+    nlohmann::json json_ = nlohmann::json::object();
+    bool dirty_ = false;
+
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable idle_;
+    std::unique_ptr<nlohmann::json> pending_;
+    bool writing_ = false;
+    bool stop_ = false;
+    std::thread writer_;
+};
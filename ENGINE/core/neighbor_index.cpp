@@ -0,0 +1,51 @@
+#include "core/neighbor_index.hpp"
+
+#include "asset/Asset.hpp"
+#include "asset/asset_info.hpp"
+#include "asset/asset_types.hpp"
+#include "utils/range_util.hpp"
+
+NeighborIndex::NeighborIndex(int cell_size)
+    : all_(cell_size), impassable_(cell_size) {}
+
+void NeighborIndex::clear() {
+    all_.clear();
+    impassable_.clear();
+}
+
+void NeighborIndex::rebuild(const std::vector<Asset*>& active) {
+    clear();
+    for (Asset* a : active) {
+        if (!accepts(a)) continue;
+        all_.insert(a);
+        if (!a->info->passable) {
+            impassable_.insert(a);
+        }
+    }
+}
+
+void NeighborIndex::update(Asset* a) {
+    all_.update(a);
+    impassable_.update(a);
+}
+
+void NeighborIndex::remove(const Asset* a) {
+    all_.remove(a);
+    impassable_.remove(a);
+}
+
+void NeighborIndex::query(SDL_Point center, int radius, Layer layer, const Asset* self, std::vector<Asset*>& out) const {
+    out.clear();
+    const SpatialIndex& grid = (layer == Layer::Impassable) ? impassable_ : all_;
+    grid.query_circle(center, radius, out);
+    std::size_t write = 0;
+    for (Asset* a : out) {
+        if (a == self || !Range::is_in_range(center, a, radius)) continue;
+        out[write++] = a;
+    }
+    out.resize(write);
+}
+
+bool NeighborIndex::accepts(const Asset* a) {
+    return a && a->info && a->info->type != asset_types::texture;
+}
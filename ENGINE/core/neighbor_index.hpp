@@ -0,0 +1,35 @@
+#pragma once
+
+#include <vector>
+
+#include <SDL.h>
+
+#include "core/spatial_index.hpp"
+
+class Asset;
+
+// Frame-wide neighbor lookups for moving assets. Built once per frame from the
+// active set and kept current as assets move, so every mover shares the same
+// grid instead of filtering the active set into a private list.
+class NeighborIndex {
+public:
+    enum class Layer { All, Impassable };
+
+    explicit NeighborIndex(int cell_size = 128);
+
+    void clear();
+    void rebuild(const std::vector<Asset*>& active);
+    void update(Asset* a);
+    void remove(const Asset* a);
+
+    // Non-texture assets within radius of center, excluding `self`.
+    void query(SDL_Point center, int radius, Layer layer, const Asset* self, std::vector<Asset*>& out) const;
+
+    std::size_t size() const { return all_.size(); }
+
+private:
+    static bool accepts(const Asset* a);
+
+    SpatialIndex all_;
+    SpatialIndex impassable_;
+};
@@ -0,0 +1,199 @@
+#include "core/spatial_index.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+#include "asset/Asset.hpp"
+
+namespace {
+    struct CellRange {
+        int min_x = 0;
+        int min_y = 0;
+        int max_x = -1;
+        int max_y = -1;
+
+        bool contains(int cx, int cy) const {
+            return cx >= min_x && cx <= max_x && cy >= min_y && cy <= max_y;
+        }
+};
+
+    double nearest_d2(SDL_Point c, double x0, double y0, double x1, double y1) {
+        const double px = std::clamp(static_cast<double>(c.x), x0, x1);
+        const double py = std::clamp(static_cast<double>(c.y), y0, y1);
+        const double dx = px - c.x;
+        const double dy = py - c.y;
+        return dx * dx + dy * dy;
+    }
+
+    double farthest_d2(SDL_Point c, double x0, double y0, double x1, double y1) {
+        const double dx = std::max(std::abs(c.x - x0), std::abs(x1 - c.x));
+        const double dy = std::max(std::abs(c.y - y0), std::abs(y1 - c.y));
+        return dx * dx + dy * dy;
+    }
+}
+
+SpatialIndex::SpatialIndex(int cell_size)
+    : cell_size_(std::max(1, cell_size)) {}
+
+void SpatialIndex::clear() {
+    cells_.clear();
+    asset_cells_.clear();
+}
+
+void SpatialIndex::rebuild(const std::vector<Asset*>& assets) {
+    clear();
+    asset_cells_.reserve(assets.size());
+    auto insert_recursive = [&](auto&& self, Asset* a) -> void {
+        if (a == nullptr || contains(a)) return;
+        insert(a);
+        for (Asset* child : a->children) {
+            self(self, child);
+        }
+    };
+    for (Asset* a : assets) {
+        insert_recursive(insert_recursive, a);
+    }
+}
+
+void SpatialIndex::insert(Asset* a) {
+    if (a == nullptr || contains(a)) {
+        return;
+    }
+    const CellKey key = cell_key_for(a->pos);
+    cells_[key].push_back(a);
+    asset_cells_.emplace(a, key);
+}
+
+void SpatialIndex::remove(const Asset* a) {
+    auto it = asset_cells_.find(a);
+    if (it == asset_cells_.end()) {
+        return;
+    }
+    erase_from_cell(it->second, a);
+    asset_cells_.erase(it);
+}
+
+void SpatialIndex::update(Asset* a) {
+    auto it = asset_cells_.find(a);
+    if (it == asset_cells_.end()) {
+        return;
+    }
+    const CellKey key = cell_key_for(a->pos);
+    if (key == it->second) {
+        return;
+    }
+    erase_from_cell(it->second, a);
+    cells_[key].push_back(a);
+    it->second = key;
+}
+
+bool SpatialIndex::contains(const Asset* a) const {
+    return asset_cells_.find(a) != asset_cells_.end();
+}
+
+void SpatialIndex::query_circle(SDL_Point center, int radius, std::vector<Asset*>& out) const {
+    if (radius < 0) {
+        return;
+    }
+    const int min_x = cell_coord(center.x - radius);
+    const int max_x = cell_coord(center.x + radius);
+    const int min_y = cell_coord(center.y - radius);
+    const int max_y = cell_coord(center.y + radius);
+    for (int cy = min_y; cy <= max_y; ++cy) {
+        for (int cx = min_x; cx <= max_x; ++cx) {
+            auto it = cells_.find(cell_key(cx, cy));
+            if (it == cells_.end()) continue;
+            out.insert(out.end(), it->second.begin(), it->second.end());
+        }
+    }
+}
+
+void SpatialIndex::query_delta(SDL_Point prev_center,
+                               int prev_radius,
+                               SDL_Point curr_center,
+                               int curr_radius,
+                               std::vector<Asset*>& out) const {
+    if (prev_center.x == curr_center.x && prev_center.y == curr_center.y && prev_radius == curr_radius) {
+        return;
+    }
+
+    auto range_for = [this](SDL_Point c, int r) {
+        CellRange range;
+        if (r < 0) return range;
+        range.min_x = cell_coord(c.x - r);
+        range.max_x = cell_coord(c.x + r);
+        range.min_y = cell_coord(c.y - r);
+        range.max_y = cell_coord(c.y + r);
+        return range;
+};
+
+    const double prev_r2 = static_cast<double>(prev_radius) * static_cast<double>(prev_radius);
+    const double curr_r2 = static_cast<double>(curr_radius) * static_cast<double>(curr_radius);
+
+    auto visit_cell = [&](int cx, int cy) {
+        auto it = cells_.find(cell_key(cx, cy));
+        if (it == cells_.end() || it->second.empty()) return;
+
+        const double x0 = static_cast<double>(cx) * cell_size_;
+        const double y0 = static_cast<double>(cy) * cell_size_;
+        const double x1 = x0 + cell_size_ - 1;
+        const double y1 = y0 + cell_size_ - 1;
+
+        const bool inside_prev = prev_radius >= 0 && farthest_d2(prev_center, x0, y0, x1, y1) <= prev_r2;
+        const bool inside_curr = curr_radius >= 0 && farthest_d2(curr_center, x0, y0, x1, y1) <= curr_r2;
+        if (inside_prev && inside_curr) return;
+
+        const bool outside_prev = prev_radius < 0 || nearest_d2(prev_center, x0, y0, x1, y1) > prev_r2;
+        const bool outside_curr = curr_radius < 0 || nearest_d2(curr_center, x0, y0, x1, y1) > curr_r2;
+        if (outside_prev && outside_curr) return;
+
+        out.insert(out.end(), it->second.begin(), it->second.end());
+};
+
+    const CellRange prev_range = range_for(prev_center, prev_radius);
+    const CellRange curr_range = range_for(curr_center, curr_radius);
+
+    for (int cy = prev_range.min_y; cy <= prev_range.max_y; ++cy) {
+        for (int cx = prev_range.min_x; cx <= prev_range.max_x; ++cx) {
+            visit_cell(cx, cy);
+        }
+    }
+    for (int cy = curr_range.min_y; cy <= curr_range.max_y; ++cy) {
+        for (int cx = curr_range.min_x; cx <= curr_range.max_x; ++cx) {
+            if (prev_range.contains(cx, cy)) continue;
+            visit_cell(cx, cy);
+        }
+    }
+}
+
+SpatialIndex::CellKey SpatialIndex::cell_key(int cx, int cy) const {
+    const std::uint64_t hi = static_cast<std::uint32_t>(cx);
+    const std::uint64_t lo = static_cast<std::uint32_t>(cy);
+    return static_cast<CellKey>((hi << 32) | lo);
+}
+
+SpatialIndex::CellKey SpatialIndex::cell_key_for(SDL_Point p) const {
+    return cell_key(cell_coord(p.x), cell_coord(p.y));
+}
+
+int SpatialIndex::cell_coord(int v) const {
+    // Floor division so negative world coordinates land in their own cells.
+    return (v >= 0) ? (v / cell_size_) : -(((-v) + cell_size_ - 1) / cell_size_);
+}
+
+void SpatialIndex::erase_from_cell(CellKey key, const Asset* a) {
+    auto it = cells_.find(key);
+    if (it == cells_.end()) {
+        return;
+    }
+    auto& bucket = it->second;
+    auto pos = std::find(bucket.begin(), bucket.end(), a);
+    if (pos != bucket.end()) {
+        *pos = bucket.back();
+        bucket.pop_back();
+    }
+    if (bucket.empty()) {
+        cells_.erase(it);
+    }
+}
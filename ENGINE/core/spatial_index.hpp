@@ -0,0 +1,48 @@
+#pragma once
+
+#include <unordered_map>
+#include <vector>
+
+#include <SDL.h>
+
+class Asset;
+
+// Uniform grid over world space keyed by cell coordinates. Assets are bucketed by
+// their current pos; callers must report moves through update() so the bucket stays
+// in sync. Queries return coarse candidates that callers refine with Range checks.
+class SpatialIndex {
+public:
+    explicit SpatialIndex(int cell_size = 256);
+
+    void clear();
+    void rebuild(const std::vector<Asset*>& assets);
+
+    void insert(Asset* a);
+    void remove(const Asset* a);
+    void update(Asset* a);
+
+    bool contains(const Asset* a) const;
+    bool empty() const { return asset_cells_.empty(); }
+    std::size_t size() const { return asset_cells_.size(); }
+    int cell_size() const { return cell_size_; }
+
+    // Every indexed asset whose cell overlaps the circle's bounding box.
+    void query_circle(SDL_Point center, int radius, std::vector<Asset*>& out) const;
+
+    // Assets that may have crossed between the two circles. Cells lying entirely
+    // inside both circles or entirely outside both are skipped, so the cost follows
+    // the ring swept by the move rather than the full search area.
+    void query_delta(SDL_Point prev_center, int prev_radius, SDL_Point curr_center, int curr_radius, std::vector<Asset*>& out) const;
+
+private:
+    using CellKey = long long;
+
+    CellKey cell_key(int cx, int cy) const;
+    CellKey cell_key_for(SDL_Point p) const;
+    int cell_coord(int v) const;
+    void erase_from_cell(CellKey key, const Asset* a);
+
+    int cell_size_ = 256;
+    std::unordered_map<CellKey, std::vector<Asset*>> cells_;
+    std::unordered_map<const Asset*, CellKey> asset_cells_;
+};
@@ -46,14 +46,15 @@ namespace {
         if (!player) return 1.0f;
 
         SDL_Texture* player_final = player->get_final_texture();
-        SDL_Texture* player_frame = player->get_current_frame();
+        const AtlasFrame* player_frame = player->get_current_frame();
         int pw = player->cached_w;
         int ph = player->cached_h;
         if ((pw == 0 || ph == 0) && player_final) {
             SDL_QueryTexture(player_final, nullptr, nullptr, &pw, &ph);
         }
         if ((pw == 0 || ph == 0) && player_frame) {
-            SDL_QueryTexture(player_frame, nullptr, nullptr, &pw, &ph);
+            pw = player_frame->width();
+            ph = player_frame->height();
         }
         if (pw != 0) player->cached_w = pw;
         if (ph != 0) player->cached_h = ph;
@@ -338,15 +339,23 @@ bool AreaOverlayEditor::generate_mask_from_asset(SDL_Renderer* renderer) {
     if (!renderer || !asset_ || canvas_w_ <= 0 || canvas_h_ <= 0) return false;
 
     SDL_Texture* source = asset_->get_final_texture();
-    if (!source) source = asset_->get_current_frame();
-    if (!source) return false;
-
+    const SDL_Rect* src_rect = nullptr;
+    SDL_RendererFlip flip = SDL_FLIP_NONE;
     int tex_w = 0;
     int tex_h = 0;
-    if (SDL_QueryTexture(source, nullptr, nullptr, &tex_w, &tex_h) != 0) {
-        std::cerr << "[AreaOverlayEditor] SDL_QueryTexture failed: " << SDL_GetError() << "\n";
-        return false;
+    if (source) {
+        if (SDL_QueryTexture(source, nullptr, nullptr, &tex_w, &tex_h) != 0) {
+            std::cerr << "[AreaOverlayEditor] SDL_QueryTexture failed: " << SDL_GetError() << "\n";
+            return false;
+        }
+    } else if (const AtlasFrame* frame = asset_->get_current_frame()) {
+        source = frame->texture;
+        src_rect = &frame->src;
+        flip = frame->flipped ? SDL_FLIP_HORIZONTAL : SDL_FLIP_NONE;
+        tex_w = frame->width();
+        tex_h = frame->height();
     }
+    if (!source) return false;
     if (tex_w <= 0 || tex_h <= 0) {
         std::cerr << "[AreaOverlayEditor] Source texture has invalid dimensions" << "\n";
         return false;
@@ -369,7 +378,7 @@ bool AreaOverlayEditor::generate_mask_from_asset(SDL_Renderer* renderer) {
     SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
     SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
     SDL_RenderClear(renderer);
-    SDL_RenderCopyEx(renderer, source, nullptr, nullptr, 0.0, nullptr, SDL_FLIP_NONE);
+    SDL_RenderCopyEx(renderer, source, src_rect, nullptr, 0.0, nullptr, flip);
 
     SDL_Surface* captured = SDL_CreateRGBSurfaceWithFormat(0, tex_w, tex_h, 32, SDL_PIXELFORMAT_RGBA32);
     if (!captured) {
@@ -594,8 +603,9 @@ void AreaOverlayEditor::render(SDL_Renderer* r) {
                     SDL_QueryTexture(final_tex, nullptr, nullptr, &fw, &fh);
                 }
                 if (fw == 0 || fh == 0) {
-                    if (SDL_Texture* base_tex = asset_->get_current_frame()) {
-                        SDL_QueryTexture(base_tex, nullptr, nullptr, &fw, &fh);
+                    if (const AtlasFrame* base_frame = asset_->get_current_frame()) {
+                        fw = base_frame->width();
+                        fh = base_frame->height();
                     }
                 }
             }
@@ -539,14 +539,15 @@ float AssetInfoUI::compute_player_screen_height(const camera& cam) const {
     if (!player_asset) return 1.0f;
 
     SDL_Texture* player_final = player_asset->get_final_texture();
-    SDL_Texture* player_frame = player_asset->get_current_frame();
+    const AtlasFrame* player_frame = player_asset->get_current_frame();
     int pw = player_asset->cached_w;
     int ph = player_asset->cached_h;
     if ((pw == 0 || ph == 0) && player_final) {
         SDL_QueryTexture(player_final, nullptr, nullptr, &pw, &ph);
     }
     if ((pw == 0 || ph == 0) && player_frame) {
-        SDL_QueryTexture(player_frame, nullptr, nullptr, &pw, &ph);
+        pw = player_frame->width();
+        ph = player_frame->height();
     }
     if (pw != 0) player_asset->cached_w = pw;
     if (ph != 0) player_asset->cached_h = ph;
@@ -192,15 +192,15 @@ struct AssetLibraryUI::AssetTileWidget : public Widget {
         }
 
         if (in) {
-            SDL_Texture* tex = owner ? owner->get_default_frame_texture(*in) : nullptr;
+            const AtlasFrame* tex = owner ? owner->get_default_frame_texture(*in) : nullptr;
             if (!tex) {
                 auto it = in->animations.find("default");
                 if (it == in->animations.end()) it = in->animations.find("start");
                 if (it == in->animations.end() && !in->animations.empty()) it = in->animations.begin();
-                if (it != in->animations.end() && !it->second.frames.empty()) tex = it->second.frames.front();
+                if (it != in->animations.end() && !it->second.frames.empty()) tex = &it->second.frames.front();
             }
-            if (tex) {
-                int tw=0, th=0; SDL_QueryTexture(tex, nullptr, nullptr, &tw, &th);
+            if (tex && tex->texture) {
+                int tw = tex->width(), th = tex->height();
                 if (tw > 0 && th > 0) {
                     SDL_Rect image_rect{ rect_.x + pad,
                                          label_rect.y + label_rect.h + pad,
@@ -214,7 +214,7 @@ struct AssetLibraryUI::AssetTileWidget : public Widget {
                             int dh = int(th * scale);
                             SDL_Rect dst{ image_rect.x + (image_rect.w - dw) / 2,
                                           image_rect.y + (image_rect.h - dh) / 2, dw, dh };
-                            SDL_RenderCopy(r, tex, nullptr, &dst);
+                            tex->render(r, &dst);
                         }
                     }
                 }
@@ -332,6 +332,18 @@ bool AssetLibraryUI::matches_query(const AssetInfo& info, const std::string& que
         return s;
 };
 
+    // Interned tags are matched by ANDing the asset's mask with the set of known
+    // tags containing the needle; the string scan is only needed when the asset
+    // carries tags the interner could not hold.
+    auto tags_match = [&](const std::string& needle) {
+        if (info.tag_mask_complete) {
+            return (TagInterner::instance().mask_matching_substring(needle) & info.tag_mask).any();
+        }
+        return std::any_of(info.tags.begin(), info.tags.end(), [&](const std::string& t){
+            return to_lower_copy(t).find(needle) != std::string::npos;
+        });
+};
+
     std::istringstream ss(query);
     std::string token;
     std::string name_lower = to_lower_copy(info.name);
@@ -343,10 +355,7 @@ bool AssetLibraryUI::matches_query(const AssetInfo& info, const std::string& que
             std::string tag = token.substr(1);
             if (tag.empty()) continue;
             std::string needle = to_lower_copy(tag);
-            bool tag_match = std::any_of(info.tags.begin(), info.tags.end(), [&](const std::string& t){
-                return to_lower_copy(t).find(needle) != std::string::npos;
-            });
-            if (!tag_match) {
+            if (!tags_match(needle)) {
                 return false;
             }
         } else {
@@ -354,10 +363,7 @@ bool AssetLibraryUI::matches_query(const AssetInfo& info, const std::string& que
             if (needle.empty()) continue;
             bool in_name = name_lower.find(needle) != std::string::npos;
             if (!in_name) {
-                bool in_tags = std::any_of(info.tags.begin(), info.tags.end(), [&](const std::string& t){
-                    return to_lower_copy(t).find(needle) != std::string::npos;
-                });
-                if (!in_tags) {
+                if (!tags_match(needle)) {
                     return false;
                 }
             }
@@ -395,28 +401,28 @@ void AssetLibraryUI::refresh_tiles(Assets& assets) {
     rebuild_rows();
 }
 
-SDL_Texture* AssetLibraryUI::get_default_frame_texture(const AssetInfo& info) const {
-    auto find_frame = [](const AssetInfo& inf, const std::string& key) -> SDL_Texture* {
+const AtlasFrame* AssetLibraryUI::get_default_frame_texture(const AssetInfo& info) const {
+    auto find_frame = [](const AssetInfo& inf, const std::string& key) -> const AtlasFrame* {
         if (key.empty()) return nullptr;
         auto it = inf.animations.find(key);
         if (it != inf.animations.end() && !it->second.frames.empty()) {
-            return it->second.frames.front();
+            return &it->second.frames.front();
         }
         return nullptr;
 };
 
-    if (SDL_Texture* tex = find_frame(info, "default")) {
+    if (const AtlasFrame* tex = find_frame(info, "default")) {
         return tex;
     }
-    if (SDL_Texture* tex = find_frame(info, info.start_animation)) {
+    if (const AtlasFrame* tex = find_frame(info, info.start_animation)) {
         return tex;
     }
-    if (SDL_Texture* tex = find_frame(info, "start")) {
+    if (const AtlasFrame* tex = find_frame(info, "start")) {
         return tex;
     }
     for (const auto& kv : info.animations) {
         if (!kv.second.frames.empty()) {
-            return kv.second.frames.front();
+            return &kv.second.frames.front();
         }
     }
 
@@ -439,18 +445,18 @@ SDL_Texture* AssetLibraryUI::get_default_frame_texture(const AssetInfo& info) co
         mutable_info.loadAnimations(renderer);
     }
 
-    if (SDL_Texture* tex = find_frame(info, "default")) {
+    if (const AtlasFrame* tex = find_frame(info, "default")) {
         return tex;
     }
-    if (SDL_Texture* tex = find_frame(info, info.start_animation)) {
+    if (const AtlasFrame* tex = find_frame(info, info.start_animation)) {
         return tex;
     }
-    if (SDL_Texture* tex = find_frame(info, "start")) {
+    if (const AtlasFrame* tex = find_frame(info, "start")) {
         return tex;
     }
     for (const auto& kv : info.animations) {
         if (!kv.second.frames.empty()) {
-            return kv.second.frames.front();
+            return &kv.second.frames.front();
         }
     }
     return nullptr;
@@ -15,6 +15,7 @@ class DockableCollapsible;
 class DMButton;
 class DMTextBox;
 class TextBoxWidget;
+struct AtlasFrame;
 
 class AssetLibraryUI {
 public:
@@ -43,7 +44,7 @@ private:
     void rebuild_rows();
     void refresh_tiles(Assets& assets);
     bool matches_query(const AssetInfo& info, const std::string& query) const;
-    SDL_Texture* get_default_frame_texture(const AssetInfo& info) const;
+    const AtlasFrame* get_default_frame_texture(const AssetInfo& info) const;
 
 private:
     std::unique_ptr<DockableCollapsible> floating_;
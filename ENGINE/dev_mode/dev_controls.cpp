@@ -394,6 +394,14 @@ void DevControls::set_enabled(bool enabled) {
 
 void DevControls::update(const Input& input) {
     if (!enabled_) return;
+    PROFILE_SCOPE("DevControls::update");
+
+    if (input.wasScancodePressed(SDL_SCANCODE_F9)) {
+        profiler_overlay_.toggle();
+    }
+    if (input.wasScancodePressed(SDL_SCANCODE_F10)) {
+        FrameProfilerOverlay::dump_trace();
+    }
 
     const bool ctrl = input.isScancodeDown(SDL_SCANCODE_LCTRL) || input.isScancodeDown(SDL_SCANCODE_RCTRL);
     if (ctrl && input.wasScancodePressed(SDL_SCANCODE_M)) {
@@ -456,6 +464,7 @@ void DevControls::update(const Input& input) {
 
 void DevControls::update_ui(const Input& input) {
     if (!enabled_) return;
+    PROFILE_SCOPE("DevControls::update_ui");
     if (mode_ != Mode::RoomEditor) return;
     if (!room_editor_ || !room_editor_->is_enabled()) return;
 
@@ -579,6 +588,7 @@ void DevControls::handle_sdl_event(const SDL_Event& event) {
 
 void DevControls::render_overlays(SDL_Renderer* renderer) {
     if (!enabled_) return;
+    PROFILE_SCOPE("DevControls::render_overlays");
 
     if (mode_ == Mode::MapEditor) {
         if (map_editor_) map_editor_->render(renderer);
@@ -600,6 +610,7 @@ void DevControls::render_overlays(SDL_Renderer* renderer) {
         regenerate_popup_->render(renderer);
     }
     asset_filter_.render(renderer);
+    profiler_overlay_.render(renderer, screen_w_);
 }
 
 void DevControls::toggle_asset_library() {
@@ -1227,17 +1238,8 @@ void DevControls::persist_map_info_to_disk() const {
     if (!assets_) {
         return;
     }
-    try {
-        const std::string& path = assets_->map_info_path();
-        if (path.empty()) {
-            return;
-        }
-        std::ofstream out(path);
-        if (!out.is_open()) {
-            return;
-        }
-        out << assets_->map_info_json().dump(2);
-    } catch (...) {
-    }
+    MapDocument& doc = assets_->map_document();
+    doc.mark_dirty();
+    doc.save_async();
 }
 
@@ -15,6 +15,7 @@
 #include "asset_filter_bar.hpp"
 #include "trail_editor_suite.hpp"
 #include "map_assets_modals.hpp"
+#include "frame_profiler_overlay.hpp"
 
 class Asset;
 class Input;
@@ -147,6 +148,7 @@ private:
     bool pointer_over_camera_panel_ = false;
     std::unique_ptr<TrailEditorSuite> trail_suite_;
     AssetFilterBar asset_filter_;
+    FrameProfilerOverlay profiler_overlay_;
 
     std::unique_ptr<SingleSpawnGroupModal> map_assets_modal_;
     std::unique_ptr<SingleSpawnGroupModal> boundary_assets_modal_;
@@ -0,0 +1,115 @@
+#include "frame_profiler_overlay.hpp"
+
+#include <algorithm>
+#include <cstdio>
+
+#include "dm_styles.hpp"
+#include "render/render_target_pool.hpp"
+#include "ui/font_paths.hpp"
+
+namespace {
+constexpr Uint32 kRefreshMs = 250;
+constexpr int kFontSize = 14;
+constexpr int kPad = 8;
+}
+
+FrameProfilerOverlay::~FrameProfilerOverlay() {
+    clear_line_textures();
+    if (font_) TTF_CloseFont(font_);
+}
+
+void FrameProfilerOverlay::clear_line_textures() {
+    for (LineTexture& line : line_textures_) {
+        if (line.texture) SDL_DestroyTexture(line.texture);
+    }
+    line_textures_.clear();
+    textures_renderer_ = nullptr;
+}
+
+void FrameProfilerOverlay::rebuild_line_textures(SDL_Renderer* renderer) {
+    clear_line_textures();
+    textures_renderer_ = renderer;
+    const SDL_Color text = DMStyles::Label().color;
+    line_textures_.reserve(lines_.size());
+    for (const std::string& line : lines_) {
+        LineTexture out;
+        if (SDL_Surface* surf = TTF_RenderUTF8_Blended(font_, line.c_str(), text)) {
+            out.texture = SDL_CreateTextureFromSurface(renderer, surf);
+            out.w = surf->w;
+            out.h = surf->h;
+            SDL_FreeSurface(surf);
+        }
+        line_textures_.push_back(out);
+    }
+}
+
+std::string FrameProfilerOverlay::dump_trace() {
+    const std::string path = "profiles/trace_" + std::to_string(SDL_GetTicks()) + ".json";
+    return FrameProfiler::instance().dump_chrome_trace(path) ? path : std::string{};
+}
+
+void FrameProfilerOverlay::render(SDL_Renderer* renderer, int screen_w) {
+    if (!visible_ || !renderer) return;
+    if (!font_) {
+        font_ = TTF_OpenFont(ui_fonts::monospace().c_str(), kFontSize);
+        if (!font_) return;
+    }
+
+    const Uint32 now = SDL_GetTicks();
+    const bool refresh = lines_.empty() || now - last_refresh_ >= kRefreshMs;
+    if (refresh) {
+        last_refresh_ = now;
+        lines_.clear();
+        char buf[160];
+        std::snprintf(buf, sizeof(buf), "%-24s %7s %7s %7s %7s", "scope (ms)", "avg", "p95", "p99", "calls");
+        lines_.emplace_back(buf);
+        for (const FrameProfiler::ScopeStats& s : FrameProfiler::instance().snapshot()) {
+            std::snprintf(buf, sizeof(buf), "%-24.24s %7.2f %7.2f %7.2f %7.1f",
+                          s.name.c_str(), s.avg_ms, s.p95_ms, s.p99_ms, s.calls);
+            lines_.emplace_back(buf);
+        }
+        if (lines_.size() == 1) {
+#if defined(VIBBLE_FRAME_PROFILER)
+            lines_.emplace_back("no frames recorded yet");
+#else
+            lines_.emplace_back("profiler compiled out (ENABLE_FRAME_PROFILER=OFF)");
+#endif
+        }
+        const RenderTargetPool::Stats& rt = RenderTargetPool::instance().stats();
+        const double lookups = static_cast<double>(rt.hits + rt.misses);
+        std::snprintf(buf, sizeof(buf), "rt pool: live %zu (%.1f MB) idle %zu (%.1f MB) hit %.0f%% evict %llu",
+                      rt.live_textures, rt.live_bytes / (1024.0 * 1024.0),
+                      rt.idle_textures, rt.idle_bytes / (1024.0 * 1024.0),
+                      lookups > 0.0 ? 100.0 * static_cast<double>(rt.hits) / lookups : 0.0,
+                      static_cast<unsigned long long>(rt.evictions));
+        lines_.emplace_back(buf);
+    }
+    if (refresh || renderer != textures_renderer_) {
+        rebuild_line_textures(renderer);
+    }
+
+    const int line_h = TTF_FontLineSkip(font_);
+    int max_w = 0;
+    for (const LineTexture& line : line_textures_) {
+        max_w = std::max(max_w, line.w);
+    }
+    SDL_Rect panel{ screen_w - max_w - kPad * 3, kPad, max_w + kPad * 2,
+                    static_cast<int>(line_textures_.size()) * line_h + kPad * 2 };
+
+    const SDL_Color bg = DMStyles::PanelBG();
+    const SDL_Color border = DMStyles::Border();
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+    SDL_SetRenderDrawColor(renderer, bg.r, bg.g, bg.b, 220);
+    SDL_RenderFillRect(renderer, &panel);
+    SDL_SetRenderDrawColor(renderer, border.r, border.g, border.b, border.a);
+    SDL_RenderDrawRect(renderer, &panel);
+
+    int y = panel.y + kPad;
+    for (const LineTexture& line : line_textures_) {
+        if (line.texture) {
+            SDL_Rect dst{ panel.x + kPad, y, line.w, line.h };
+            SDL_RenderCopy(renderer, line.texture, nullptr, &dst);
+        }
+        y += line_h;
+    }
+}
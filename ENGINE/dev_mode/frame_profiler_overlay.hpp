@@ -0,0 +1,45 @@
+#pragma once
+
+#include <SDL.h>
+#include <SDL_ttf.h>
+#include <string>
+#include <vector>
+
+#include "utils/frame_profiler.hpp"
+
+// Dev-mode panel listing FrameProfiler scopes with rolling avg / p95 / p99,
+// followed by RenderTargetPool usage.
+// Stats are re-sampled a few times per second so the numbers stay readable.
+class FrameProfilerOverlay {
+public:
+    FrameProfilerOverlay() = default;
+    ~FrameProfilerOverlay();
+    FrameProfilerOverlay(const FrameProfilerOverlay&) = delete;
+    FrameProfilerOverlay& operator=(const FrameProfilerOverlay&) = delete;
+
+    void toggle() { visible_ = !visible_; }
+    bool visible() const { return visible_; }
+
+    void render(SDL_Renderer* renderer, int screen_w);
+
+    // Writes profiles/trace_<ticks>.json; returns the path, or empty on failure.
+    static std::string dump_trace();
+
+private:
+    struct LineTexture {
+        SDL_Texture* texture = nullptr;
+        int w = 0;
+        int h = 0;
+    };
+
+    void rebuild_line_textures(SDL_Renderer* renderer);
+    void clear_line_textures();
+
+    bool visible_ = false;
+    TTF_Font* font_ = nullptr;
+    Uint32 last_refresh_ = 0;
+    std::vector<std::string> lines_;
+    // Rendered lines_, rebuilt only when the stats refresh.
+    std::vector<LineTexture> line_textures_;
+    SDL_Renderer* textures_renderer_ = nullptr;
+};
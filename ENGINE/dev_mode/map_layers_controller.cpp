@@ -1,6 +1,7 @@
 #include "map_layers_controller.hpp"
 
 #include "map_layers_common.hpp"
+#include "core/map_document.hpp"
 
 #include <algorithm>
 #include <cctype>
@@ -38,8 +39,9 @@ int next_layer_radius(const json& layers) {
 }
 }
 
-void MapLayersController::bind(json* map_info, std::string map_path) {
+void MapLayersController::bind(json* map_info, std::string map_path, MapDocument* map_doc) {
     map_info_ = map_info;
+    map_doc_ = map_doc;
     map_path_ = std::move(map_path);
     ensure_initialized();
     dirty_ = false;
@@ -57,6 +59,12 @@ void MapLayersController::clear_listeners() {
 
 bool MapLayersController::save() {
     if (!map_info_) return false;
+    if (map_doc_) {
+        map_doc_->mark_dirty();
+        map_doc_->save_async();
+        mark_clean();
+        return true;
+    }
     std::string path = map_info_path();
     if (path.empty()) return false;
 
@@ -80,6 +88,7 @@ bool MapLayersController::reload() {
     if (!map_info_) return false;
     std::string path = map_info_path();
     if (path.empty()) return false;
+    if (map_doc_) map_doc_->flush();
 
     std::ifstream in(path);
     if (!in) {
@@ -6,13 +6,17 @@
 
 #include <nlohmann/json_fwd.hpp>
 
+class MapDocument;
+
 class MapLayersController {
 public:
     using Listener = std::function<void()>;
 
     MapLayersController() = default;
 
-    void bind(nlohmann::json* map_info, std::string map_path);
+    // When map_doc is given, map_info must be its json(); saves then go through
+    // the document's background writer instead of writing the file here.
+    void bind(nlohmann::json* map_info, std::string map_path, MapDocument* map_doc = nullptr);
 
     void add_listener(Listener cb);
     void clear_listeners();
@@ -53,6 +57,7 @@ private:
 
 private:
     nlohmann::json* map_info_ = nullptr;
+    MapDocument* map_doc_ = nullptr;
     std::string map_path_;
     bool dirty_ = false;
     std::vector<Listener> listeners_;
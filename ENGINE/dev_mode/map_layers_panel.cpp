@@ -10,6 +10,8 @@
 
 #include "widgets.hpp"
 
+#include "core/map_document.hpp"
+
 #include "utils/input.hpp"
 
 #include <SDL.h>
@@ -2761,15 +2763,17 @@ MapLayersPanel::MapLayersPanel(int x, int y)
 
 MapLayersPanel::~MapLayersPanel() = default;
 
-void MapLayersPanel::set_map_info(json* map_info, const std::string& map_path) {
+void MapLayersPanel::set_map_info(json* map_info, const std::string& map_path, MapDocument* map_doc) {
 
     map_info_ = map_info;
 
+    map_doc_ = map_doc;
+
     map_path_ = map_path;
 
     if (controller_) {
 
-        controller_->bind(map_info, map_path);
+        controller_->bind(map_info, map_path, map_doc);
 
     }
 
@@ -2815,7 +2819,7 @@ void MapLayersPanel::set_controller(std::shared_ptr<MapLayersController> control
 
     if (controller_ && map_info_) {
 
-        controller_->bind(map_info_, map_path_);
+        controller_->bind(map_info_, map_path_, map_doc_);
 
     }
 
@@ -5355,6 +5359,18 @@ bool MapLayersPanel::save_layers_to_disk() {
 
     }
 
+    if (map_doc_) {
+
+        map_doc_->mark_dirty();
+
+        map_doc_->save_async();
+
+        mark_clean();
+
+        return true;
+
+    }
+
     std::string path = map_path_.empty() ? std::string{} : (map_path_ + "/map_info.json");
 
     if (path.empty()) return false;
@@ -5393,6 +5409,8 @@ bool MapLayersPanel::reload_layers_from_disk() {
 
     if (path.empty() || !map_info_) return false;
 
+    if (map_doc_) map_doc_->flush();
+
     std::ifstream in(path);
 
     if (!in) {
@@ -16,6 +16,7 @@ class Input;
 union SDL_Event;
 struct SDL_Renderer;
 class MapLayersController;
+class MapDocument;
 class RoomConfigurator;
 
 class MapLayersPanel : public DockableCollapsible {
@@ -25,7 +26,7 @@ public:
     explicit MapLayersPanel(int x = 128, int y = 128);
     ~MapLayersPanel() override;
 
-    void set_map_info(nlohmann::json* map_info, const std::string& map_path);
+    void set_map_info(nlohmann::json* map_info, const std::string& map_path, MapDocument* map_doc = nullptr);
     void set_on_save(SaveCallback cb);
     void set_controller(std::shared_ptr<MapLayersController> controller);
 
@@ -135,6 +136,7 @@ private:
 };
 
     nlohmann::json* map_info_ = nullptr;
+    MapDocument* map_doc_ = nullptr;
     std::string map_path_;
     SaveCallback on_save_;
 
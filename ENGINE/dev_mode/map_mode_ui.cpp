@@ -500,10 +500,11 @@ void MapModeUI::sync_panel_map_info() {
         light_panel_->set_map_info(map_info_, callback);
     }
     if (layers_panel_) {
+        MapDocument* doc = map_document();
         if (layers_controller_) {
-            layers_controller_->bind(map_info_, map_path_);
+            layers_controller_->bind(map_info_, map_path_, doc);
         }
-        layers_panel_->set_map_info(map_info_, map_path_);
+        layers_panel_->set_map_info(map_info_, map_path_, doc);
         layers_panel_->set_on_save([this]() { return save_map_info_to_disk(); });
     }
 }
@@ -657,8 +658,19 @@ bool MapModeUI::is_layers_footer_visible() const {
     return layers_footer_visible_;
 }
 
+MapDocument* MapModeUI::map_document() const {
+    if (!assets_ || !map_info_) return nullptr;
+    MapDocument& doc = assets_->map_document();
+    return &doc.json() == map_info_ ? &doc : nullptr;
+}
+
 bool MapModeUI::save_map_info_to_disk() const {
     if (!map_info_) return false;
+    if (MapDocument* doc = map_document()) {
+        doc->mark_dirty();
+        doc->save_async();
+        return true;
+    }
     std::string path = map_path_.empty() ? std::string{} : (map_path_ + "/map_info.json");
     if (path.empty()) {
         if (assets_) {
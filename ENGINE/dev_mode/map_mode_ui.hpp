@@ -14,6 +14,7 @@ class Input;
 class MapLightPanel;
 class MapLayersPanel;
 class MapLayersController;
+class MapDocument;
 class FullScreenCollapsible;
 class DockableCollapsible;
 struct DMButtonStyle;
@@ -74,6 +75,8 @@ private:
     void ensure_panels();
     void sync_panel_map_info();
     bool save_map_info_to_disk() const;
+    // The shared document when map_info_ is its json(), else nullptr.
+    MapDocument* map_document() const;
     void configure_footer_buttons();
     void sync_footer_button_states();
     void update_footer_visibility();
@@ -1392,6 +1392,7 @@ void RoomEditor::update_drag_session(const SDL_Point& world_mouse) {
         if (!state.asset) continue;
         state.asset->pos.x += delta.x;
         state.asset->pos.y += delta.y;
+        if (assets_) assets_->on_asset_moved(state.asset);
     }
     if (drag_mode_ == DragMode::PerimeterCenter) {
         drag_perimeter_circle_center_.x += delta.x;
@@ -1464,6 +1465,7 @@ void RoomEditor::apply_perimeter_drag(const SDL_Point& world_mouse) {
         if (state.asset->pos.x != new_x || state.asset->pos.y != new_y) {
             state.asset->pos.x = new_x;
             state.asset->pos.y = new_y;
+            if (assets_) assets_->on_asset_moved(state.asset);
             changed = true;
         }
     }
@@ -2218,6 +2220,7 @@ void RoomEditor::regenerate_current_room() {
     int map_radius = 0;
     nlohmann::json map_info_json;
     if (!current_room_->map_path.empty()) {
+        if (assets_) assets_->map_document().flush();
         std::ifstream map_info(current_room_->map_path + "/map_info.json");
         if (map_info.is_open()) {
             map_info >> map_info_json;
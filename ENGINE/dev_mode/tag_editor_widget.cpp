@@ -3,6 +3,7 @@
 #include "dm_styles.hpp"
 #include "tag_library.hpp"
 #include "tag_utils.hpp"
+#include "utils/tag_interner.hpp"
 
 #include <algorithm>
 #include <array>
@@ -24,6 +25,9 @@ constexpr size_t kMaxRecommendations = std::numeric_limits<size_t>::max();
 struct TagDatasetEntry {
     std::vector<std::string> tags;
     std::vector<std::string> anti_tags;
+    TagMask tag_mask;
+    TagMask anti_mask;
+    bool masks_complete = false;
 };
 
 struct TagStats {
@@ -119,6 +123,10 @@ const std::vector<TagDatasetEntry>& tag_dataset() {
         TagDatasetEntry entry;
         entry.tags.assign(tags.begin(), tags.end());
         entry.anti_tags.assign(anti.begin(), anti.end());
+        auto& interner = TagInterner::instance();
+        const bool tags_ok = interner.build_mask(entry.tags, entry.tag_mask);
+        const bool anti_ok = interner.build_mask(entry.anti_tags, entry.anti_mask);
+        entry.masks_complete = tags_ok && anti_ok;
         dataset.push_back(std::move(entry));
 };
 
@@ -362,15 +370,28 @@ void TagEditorWidget::refresh_recommendations() {
     const auto& dataset = tag_dataset();
     std::unordered_map<std::string, TagStats> stats;
 
+    // Look the selection up without interning it; a tag nothing else uses
+    // cannot be shared with a dataset entry, so leaving it out of the mask is exact.
+    TagMask selected_tags;
+    TagMask selected_anti;
+    const auto& interner = TagInterner::instance();
+    interner.find_mask(tags_, selected_tags);
+    interner.find_mask(anti_tags_, selected_anti);
+
     for (const auto& entry : dataset) {
-        bool shares_tag = contains_any(tags_, entry.tags);
-        bool shares_anti = contains_any(anti_tags_, entry.anti_tags);
+        bool shares_tag = false;
+        bool shares_anti = false;
         bool shares_cross = false;
-        if (!shares_cross) {
-            shares_cross = contains_any(anti_tags_, entry.tags);
-        }
-        if (!shares_cross) {
-            shares_cross = contains_any(tags_, entry.anti_tags);
+        if (entry.masks_complete) {
+            shares_tag = (selected_tags & entry.tag_mask).any();
+            shares_anti = (selected_anti & entry.anti_mask).any();
+            shares_cross = (selected_anti & entry.tag_mask).any() ||
+                           (selected_tags & entry.anti_mask).any();
+        } else {
+            shares_tag = contains_any(tags_, entry.tags);
+            shares_anti = contains_any(anti_tags_, entry.anti_tags);
+            shares_cross = contains_any(anti_tags_, entry.tags) ||
+                           contains_any(tags_, entry.anti_tags);
         }
 
         for (const auto& value : entry.tags) {
@@ -5,6 +5,7 @@
 #include <unordered_set>
 
 #include "tag_utils.hpp"
+#include "utils/tag_interner.hpp"
 
 TagLibrary& TagLibrary::instance() {
     static TagLibrary lib;
@@ -80,6 +81,9 @@ void TagLibrary::load_from_disk() {
     }
 
     std::sort(ordered.begin(), ordered.end());
+    for (const auto& value : ordered) {
+        TagInterner::instance().intern(value);
+    }
     tags_ = std::move(ordered);
     loaded_ = true;
     std::error_code stamp_ec;
@@ -10,6 +10,8 @@
 #include "AssetsManager.hpp"
 #include "input.hpp"
 #include "audio/audio_engine.hpp"
+#include "utils/frame_profiler.hpp"
+#include "render/render_target_pool.hpp"
 #include <SDL.h>
 #include <SDL_image.h>
 #include <SDL_mixer.h>
@@ -27,6 +29,7 @@
 #include <algorithm>
 #include <optional>
 #include <cctype>
+#include <cstdlib>
 #include <system_error>
 namespace fs = std::filesystem;
 
@@ -63,7 +66,7 @@ void MainApp::setup() {
                 }
                 int start_px = player_ptr ? player_ptr->pos.x : static_cast<int>(loader_->getMapRadius());
                 int start_py = player_ptr ? player_ptr->pos.y : static_cast<int>(loader_->getMapRadius());
-                game_assets_ = new Assets(std::move(all_assets), *loader_->getAssetLibrary(), player_ptr, loader_->getRooms(), screen_w_, screen_h_, start_px, start_py, static_cast<int>(loader_->getMapRadius() * 1.2), renderer_, map_path_);
+                game_assets_ = new Assets(std::move(all_assets), *loader_->getAssetLibrary(), player_ptr, loader_->getRooms(), screen_w_, screen_h_, start_px, start_py, static_cast<int>(loader_->getMapRadius() * 1.2), renderer_, loader_->getMapDocument());
                 input_ = new Input();
                 game_assets_->set_input(input_);
                 if (!player_ptr) {
@@ -81,39 +84,49 @@ void MainApp::setup() {
 }
 
 void MainApp::game_loop() {
-        constexpr int FRAME_MS = 1000 / 24;
         bool quit = false;
         SDL_Event e;
         int frame_count = 0;
+        clock_.reset();
 	while (!quit) {
-		Uint32 start = SDL_GetTicks();
+		PROFILE_FRAME();
+		clock_.begin_frame();
 		while (SDL_PollEvent(&e)) {
 			if (e.type == SDL_QUIT) quit = true;
 			if (input_) input_->handleEvent(e);
 			if (game_assets_) game_assets_->handle_sdl_event(e);
 		}
-                if (game_assets_) {
-                        int px = 0;
-                        int py = 0;
-                        if (game_assets_->player) {
-                                px = game_assets_->player->pos.x;
-                                py = game_assets_->player->pos.y;
-                        } else {
-                                SDL_Point focus = game_assets_->getView().get_screen_center();
-                                px = focus.x;
-                                py = focus.y;
-                        }
-                        if (input_) {
-                                game_assets_->update(*input_, px, py);
-                        }
+                while (clock_.consume_tick()) {
+                        step_simulation();
                 }
+                if (game_assets_) game_assets_->render(clock_.alpha());
 		++frame_count;
-		if (input_) input_->update();
-		Uint32 elapsed = SDL_GetTicks() - start;
-        if (elapsed < FRAME_MS) SDL_Delay(FRAME_MS - elapsed);
+		clock_.end_frame();
         }
 }
 
+void MainApp::set_frame_timing(double tick_rate, int max_fps) {
+        if (tick_rate > 0.0) clock_.set_tick_rate(tick_rate);
+        clock_.set_max_fps(max_fps);
+}
+
+void MainApp::step_simulation() {
+        if (game_assets_ && input_) {
+                int px = 0;
+                int py = 0;
+                if (game_assets_->player) {
+                        px = game_assets_->player->pos.x;
+                        py = game_assets_->player->pos.y;
+                } else {
+                        SDL_Point focus = game_assets_->getView().get_screen_center();
+                        px = focus.x;
+                        py = focus.y;
+                }
+                game_assets_->update(*input_, px, py);
+        }
+        if (input_) input_->update();
+}
+
 namespace {
 
 std::string trim_copy(const std::string& value) {
@@ -271,7 +284,7 @@ std::optional<std::string> create_new_map_interactively() {
 
 }
 
-void run(SDL_Window* window, SDL_Renderer* renderer, int screen_w, int screen_h, bool rebuild_cache) {
+void run(SDL_Window* window, SDL_Renderer* renderer, int screen_w, int screen_h, bool rebuild_cache, double tick_rate, int max_fps) {
     (void)window;
     while (true) {
         MainMenu menu(renderer, screen_w, screen_h);
@@ -309,6 +322,7 @@ void run(SDL_Window* window, SDL_Renderer* renderer, int screen_w, int screen_h,
             std::cout << "[Main] Asset cache rebuild complete.\n";
         }
         MenuUI app(renderer, screen_w, screen_h, chosen_map);
+        app.set_frame_timing(tick_rate, max_fps);
         app.init();
         if (app.wants_return_to_main_menu()) continue;
         break;
@@ -317,7 +331,22 @@ void run(SDL_Window* window, SDL_Renderer* renderer, int screen_w, int screen_h,
 
 int main(int argc, char* argv[]) {
 	std::cout << "[Main] Starting game engine...\n";
-	const bool rebuild_cache = (argc > 1 && argv[1] && std::string(argv[1]) == "-r");
+	bool rebuild_cache = false;
+	bool vsync = true;
+	double tick_rate = 0.0;
+	int max_fps = 0;
+	for (int i = 1; i < argc; ++i) {
+		const std::string arg = argv[i] ? argv[i] : "";
+		if (arg == "-r") {
+			rebuild_cache = true;
+		} else if (arg == "--no-vsync") {
+			vsync = false;
+		} else if (arg == "--tick-rate" && i + 1 < argc) {
+			tick_rate = std::atof(argv[++i]);
+		} else if (arg == "--max-fps" && i + 1 < argc) {
+			max_fps = std::max(0, std::atoi(argv[++i]));
+		}
+	}
         if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO) < 0) {
                 std::cerr << "SDL_Init failed: " << SDL_GetError() << "\n"; return 1;
         }
@@ -340,7 +369,9 @@ int main(int argc, char* argv[]) {
 		std::cerr << "SDL_CreateWindow failed: " << SDL_GetError() << "\n";
 		IMG_Quit(); TTF_Quit(); SDL_Quit(); return 1;
 	}
-	SDL_Renderer* renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED);
+	Uint32 renderer_flags = SDL_RENDERER_ACCELERATED;
+	if (vsync) renderer_flags |= SDL_RENDERER_PRESENTVSYNC;
+	SDL_Renderer* renderer = SDL_CreateRenderer(window, -1, renderer_flags);
 	if (!renderer) {
 		std::cerr << "SDL_CreateRenderer failed: " << SDL_GetError() << "\n";
 		SDL_DestroyWindow(window); IMG_Quit(); TTF_Quit(); SDL_Quit(); return 1;
@@ -350,7 +381,8 @@ int main(int argc, char* argv[]) {
 	int screen_width = 0, screen_height = 0;
 	SDL_GetRendererOutputSize(renderer, &screen_width, &screen_height);
 	std::cout << "[Main] Screen resolution: " << screen_width << "x" << screen_height << "\n";
-	run(window, renderer, screen_width, screen_height, rebuild_cache);
+	run(window, renderer, screen_width, screen_height, rebuild_cache, tick_rate, max_fps);
+	RenderTargetPool::instance().clear();
 	SDL_DestroyRenderer(renderer);
 	SDL_DestroyWindow(window);
 	IMG_Quit(); TTF_Quit(); SDL_Quit();
@@ -4,6 +4,7 @@
 #include <memory>
 #include <string>
 #include <unordered_set>
+#include "utils/fixed_step_clock.hpp"
 
 class Assets;
 class SceneRenderer;
@@ -18,7 +19,12 @@ class MainApp {
     virtual void init();
     virtual void game_loop();
     virtual void setup();
+    // Simulation ticks per second (ignored if <= 0) and a presentation cap
+    // (0 = uncapped or vsync-paced).
+    void set_frame_timing(double tick_rate, int max_fps);
 	protected:
+    // Runs one fixed simulation tick and consumes this tick's input edges.
+    void step_simulation();
 	protected:
     std::string   map_path_;
     SDL_Renderer* renderer_   = nullptr;
@@ -30,6 +36,7 @@ class MainApp {
     Input*         input_            = nullptr;
     SDL_Texture* overlay_texture_    = nullptr;
     bool dev_mode_ = false;
+    FixedStepClock clock_{24.0};
 };
 
-void run(SDL_Window* window, SDL_Renderer* renderer, int screen_w, int screen_h, bool rebuild_cache);
+void run(SDL_Window* window, SDL_Renderer* renderer, int screen_w, int screen_h, bool rebuild_cache, double tick_rate = 0.0, int max_fps = 0);
@@ -1,9 +1,14 @@
 #include "generate_rooms.hpp"
 #include "generate_trails.hpp"
 #include "spawn/asset_spawner.hpp"
+#include "utils/map_seed.hpp"
 #include <cmath>
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <exception>
 #include <random>
+#include <thread>
 #include <iostream>
 #include <fstream>
 #include <nlohmann/json.hpp>
@@ -13,15 +18,55 @@ GenerateRooms::GenerateRooms(const std::vector<LayerSpec>& layers,
                              int map_cx,
                              int map_cy,
                              const std::string& map_dir,
-                             const std::string& map_info_path)
+                             const std::string& map_info_path,
+                             std::uint32_t seed)
 : map_layers_(layers),
 map_center_x_(map_cx),
 map_center_y_(map_cy),
 map_path_(map_dir),
 map_info_path_(map_info_path),
-rng_(std::random_device{}())
+seed_(seed),
+rng_(map_seed::derive(seed, "layout"))
 {}
 
+std::vector<LayerSpec> load_layer_specs(const nlohmann::json& map_info) {
+        std::vector<LayerSpec> layers;
+        auto layers_it = map_info.find("map_layers");
+        if (layers_it == map_info.end() || !layers_it->is_array()) return layers;
+        for (const auto& layer_entry : *layers_it) {
+                LayerSpec spec;
+                spec.level     = layer_entry.value("level", 0);
+                spec.radius    = layer_entry.value("radius", 0);
+                spec.max_rooms = layer_entry.value("max_rooms", 0);
+
+                auto rooms_it = layer_entry.find("rooms");
+                if (rooms_it != layer_entry.end() && rooms_it->is_array()) {
+                        for (const auto& room_entry : *rooms_it) {
+                                RoomSpec rs;
+                                rs.name          = room_entry.value("name", "unnamed");
+                                rs.max_instances = room_entry.value("max_instances", 1);
+
+                                auto required_it = room_entry.find("required_children");
+                                if (required_it != room_entry.end() && required_it->is_array()) {
+                                        for (const auto& child : *required_it) {
+                                                if (child.is_string()) {
+                                                        rs.required_children.push_back(child.get<std::string>());
+                                                } else {
+                                                        std::cerr << "[GenerateRooms] Room '" << rs.name
+                                                                  << "' has non-string entry in 'required_children'; skipping.\n";
+                                                }
+                                        }
+                                }
+
+                                spec.rooms.push_back(std::move(rs));
+                        }
+                }
+
+                layers.push_back(std::move(spec));
+        }
+        return layers;
+}
+
 SDL_Point GenerateRooms::polar_to_cartesian(int cx, int cy, int radius, float angle_rad) {
 	float x = cx + std::cos(angle_rad) * radius;
 	float y = cy + std::sin(angle_rad) * radius;
@@ -61,6 +106,45 @@ std::vector<RoomSpec> GenerateRooms::get_children_from_layer(const LayerSpec& la
         return result;
 }
 
+void GenerateRooms::spawn_rooms(std::vector<std::unique_ptr<Room>>& rooms) {
+        // Each room spawns from its own seeded generator into its own asset
+        // vector, so the result does not depend on how rooms are split across
+        // threads. Log rows are buffered per room and written in room order.
+        unsigned workers = spawn_workers_;
+        if (workers == 0) {
+                workers = std::max(1u, std::thread::hardware_concurrency());
+        }
+        const int tasks = static_cast<int>(rooms.size());
+        const unsigned threads = static_cast<unsigned>(std::min<int>(static_cast<int>(workers), tasks));
+        stats_.spawn_workers = std::max(1u, threads);
+        std::vector<std::exception_ptr> errors(rooms.size());
+        std::atomic<int> next{0};
+        auto worker = [&]() {
+                for (int task = next.fetch_add(1); task < tasks; task = next.fetch_add(1)) {
+                        try {
+                                rooms[task]->spawn_assets(true);
+                        } catch (...) {
+                                errors[task] = std::current_exception();
+                        }
+                }
+};
+        std::vector<std::thread> pool;
+        if (threads > 1) pool.reserve(threads - 1);
+        for (unsigned i = 1; i < threads; ++i) pool.emplace_back(worker);
+        worker();
+        for (std::thread& th : pool) th.join();
+
+        std::vector<SpawnLogger::Record> log;
+        for (auto& room : rooms) {
+                log.insert(log.end(), room->spawn_log.begin(), room->spawn_log.end());
+                room->spawn_log.clear();
+        }
+        SpawnLogger::write_records(map_path_, log);
+        for (auto& err : errors) {
+                if (err) std::rethrow_exception(err);
+        }
+}
+
 std::vector<std::unique_ptr<Room>> GenerateRooms::build(AssetLibrary* asset_lib,
                                                         double map_radius,
                                                         const nlohmann::json& boundary_data,
@@ -68,7 +152,13 @@ std::vector<std::unique_ptr<Room>> GenerateRooms::build(AssetLibrary* asset_lib,
                                                         nlohmann::json& trails_data,
                                                         const nlohmann::json& map_assets_data) {
         std::vector<std::unique_ptr<Room>> all_rooms;
+        stats_ = BuildStats{};
         if (map_layers_.empty()) return all_rooms;
+        using Clock = std::chrono::steady_clock;
+        auto elapsed_ms = [](Clock::time_point since) {
+                return std::chrono::duration<double, std::milli>(Clock::now() - since).count();
+};
+        const auto rooms_start = Clock::now();
         const auto& root_spec = map_layers_[0].rooms[0];
         if (testing) {
                 std::cout << "[GenerateRooms] Creating root room: " << root_spec.name << "\n";
@@ -90,7 +180,9 @@ std::vector<std::unique_ptr<Room>> GenerateRooms::build(AssetLibrary* asset_lib,
                                         get_room_data(root_spec.name),
                                         map_assets_ptr,
                                         map_radius,
-                                        "rooms_data"
+                                        "rooms_data",
+                                        map_seed::derive(seed_, "room", all_rooms.size()),
+                                        true
  );
         root->layer = 0;
         all_rooms.push_back(std::move(root));
@@ -130,7 +222,9 @@ std::vector<std::unique_ptr<Room>> GenerateRooms::build(AssetLibrary* asset_lib,
                                                 get_room_data(children_specs[i].name),
                                                 map_assets_ptr,
                                                 map_radius,
-                                                "rooms_data"
+                                                "rooms_data",
+                                                map_seed::derive(seed_, "room", all_rooms.size()),
+                                                true
                                         );
 					child->layer = layer.level;
 					if (!next_parents.empty()) {
@@ -194,7 +288,9 @@ std::vector<std::unique_ptr<Room>> GenerateRooms::build(AssetLibrary* asset_lib,
                                                                     get_room_data(kids[i].name),
                                                                     map_assets_ptr,
                                                                     map_radius,
-                                                                    "rooms_data"
+                                                                    "rooms_data",
+                                                                    map_seed::derive(seed_, "room", all_rooms.size()),
+                                                                    true
                                                             );
 								child->layer = layer.level;
 								if (!next_parents.empty()) {
@@ -211,6 +307,11 @@ std::vector<std::unique_ptr<Room>> GenerateRooms::build(AssetLibrary* asset_lib,
 		current_parents = next_parents;
 		current_sectors = next_sectors;
 	}
+	const auto spawn_start = Clock::now();
+	spawn_rooms(all_rooms);
+	stats_.rooms_spawn_ms = elapsed_ms(spawn_start);
+	stats_.rooms    = all_rooms.size();
+	stats_.rooms_ms = elapsed_ms(rooms_start);
 	std::vector<std::pair<Room*,Room*>> connections;
 	for (auto& rp : all_rooms) {
 		for (Room* c : rp->children) {
@@ -225,8 +326,9 @@ std::vector<std::unique_ptr<Room>> GenerateRooms::build(AssetLibrary* asset_lib,
 		std::cout << "[GenerateRooms] Total rooms created (pre-trail): " << all_rooms.size() << "\n";
 		std::cout << "[GenerateRooms] Beginning trail generation...\n";
 	}
+        const auto trails_start = Clock::now();
         if (all_rooms.size() > 1) {
-                GenerateTrails trailgen(trails_data);
+                GenerateTrails trailgen(trails_data, map_seed::derive(seed_, "trails"));
                 std::vector<Room*> room_refs;
                 room_refs.reserve(all_rooms.size());
                 for (auto& room_ptr : all_rooms) {
@@ -234,13 +336,17 @@ std::vector<std::unique_ptr<Room>> GenerateRooms::build(AssetLibrary* asset_lib,
                 }
                 trailgen.set_all_rooms_reference(room_refs);
                 auto trail_objects = trailgen.generate_trails( connections, existing_areas, map_path_, map_info_path_, asset_lib, map_assets_ptr, map_radius);
+                stats_.trails = trail_objects.size();
                 for (auto& t : trail_objects) {
+                        stats_.trails_spawn_ms += t->spawn_ms;
                         all_rooms.push_back(std::move(t));
                 }
         }
+        stats_.trails_ms = elapsed_ms(trails_start);
 	if (testing) {
 		std::cout << "[GenerateRooms] Trail generation complete. Total rooms now: " << all_rooms.size() << "\n";
 	}
+        const auto boundary_start = Clock::now();
         if (!boundary_data.is_null() && !boundary_data.empty()) {
                 std::cout << "[Boundary] Starting boundary asset spawning...\n";
                 std::vector<Area> exclusion_zones;
@@ -252,11 +358,13 @@ std::vector<std::unique_ptr<Room>> GenerateRooms::build(AssetLibrary* asset_lib,
 		int cy = map_radius;
 		int diameter = map_radius * 2;
 		SDL_Point center{cx, cy};
-		Area area("Map", center, diameter, diameter, "Circle", 1, diameter, diameter);
+		std::mt19937 boundary_area_rng(map_seed::derive(seed_, "boundary_area"));
+		Area area("Map", center, diameter, diameter, "Circle", 1, diameter, diameter, boundary_area_rng);
 		std::cout << "[Boundary] Created circular boundary area with diameter " << diameter << "\n";
-		AssetSpawner spawner(asset_lib, exclusion_zones);
+		AssetSpawner spawner(asset_lib, exclusion_zones, map_seed::derive(seed_, "boundary"));
                 std::vector<std::unique_ptr<Asset>> boundary_assets = spawner.spawn_boundary_from_json( boundary_data, area, map_info_path_ + "::map_boundary_data");
 		std::cout << "[Boundary] Extracted " << boundary_assets.size() << " spawned boundary assets\n";
+		stats_.boundary_assets = boundary_assets.size();
 		int assigned_count = 0;
 		for (auto& asset_ptr : boundary_assets) {
 			Asset* asset = asset_ptr.get();
@@ -284,5 +392,6 @@ std::vector<std::unique_ptr<Room>> GenerateRooms::build(AssetLibrary* asset_lib,
 		}
 		std::cout << "[Boundary] Assigned " << assigned_count << " assets to closest rooms\n";
 	}
+	stats_.boundary_ms = elapsed_ms(boundary_start);
 	return all_rooms;
 }
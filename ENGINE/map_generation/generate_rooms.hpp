@@ -7,6 +7,7 @@
 #include <string>
 #include <memory>
 #include <random>
+#include <cstdint>
 #include <unordered_map>
 #include <SDL.h>
 #include <nlohmann/json.hpp>
@@ -24,12 +25,35 @@ struct LayerSpec {
         std::vector<RoomSpec> rooms;
 };
 
+// Reads "map_layers" from a map_info.json document.
+std::vector<LayerSpec> load_layer_specs(const nlohmann::json& map_info);
+
 class GenerateRooms {
 
 	public:
     using Point = SDL_Point;
-    GenerateRooms(const std::vector<LayerSpec>& layers, int map_cx, int map_cy, const std::string& map_dir, const std::string& map_info_path);
+    // Wall time of each stage of the last build(). Room and trail times
+    // include their spawning, reported separately in *_spawn_ms: for rooms
+    // the wall time of the parallel spawn pass over spawn_workers threads,
+    // for trails the sum over trail rooms. boundary_ms is the map-boundary
+    // spawn pass.
+    struct BuildStats {
+        double rooms_ms          = 0.0;
+        double rooms_spawn_ms    = 0.0;
+        double trails_ms         = 0.0;
+        double trails_spawn_ms   = 0.0;
+        double boundary_ms       = 0.0;
+        std::size_t rooms        = 0;
+        std::size_t trails       = 0;
+        std::size_t boundary_assets = 0;
+        unsigned spawn_workers   = 0;
+};
+    GenerateRooms(const std::vector<LayerSpec>& layers, int map_cx, int map_cy, const std::string& map_dir, const std::string& map_info_path, std::uint32_t seed);
     std::vector<std::unique_ptr<Room>> build(AssetLibrary* asset_lib, double map_radius, const nlohmann::json& boundary_data, nlohmann::json& rooms_data, nlohmann::json& trails_data, const nlohmann::json& map_assets_data);
+    const BuildStats& last_build_stats() const { return stats_; }
+    // Threads used to spawn room assets; 0 uses every hardware thread. The
+    // generated map is the same for any value.
+    void set_spawn_workers(unsigned workers) { spawn_workers_ = workers; }
     bool testing = false;
 
 	private:
@@ -40,10 +64,14 @@ class GenerateRooms {
 };
     SDL_Point polar_to_cartesian(int cx, int cy, int radius, float angle_rad);
     std::vector<RoomSpec> get_children_from_layer(const LayerSpec& layer);
+    void spawn_rooms(std::vector<std::unique_ptr<Room>>& rooms);
     std::vector<LayerSpec> map_layers_;
     int map_center_x_;
     int map_center_y_;
     std::string map_path_;
     std::string map_info_path_;
+    std::uint32_t seed_;
     std::mt19937 rng_;
+    BuildStats stats_;
+    unsigned spawn_workers_ = 0;
 };
@@ -85,8 +85,8 @@ std::pair<double, double> room_center(Room* room) {
 }
 
 } // namespace
-GenerateTrails::GenerateTrails(nlohmann::json& trail_data)
-: rng_(std::random_device{}()),
+GenerateTrails::GenerateTrails(nlohmann::json& trail_data, std::uint32_t seed)
+: rng_(seed),
 trails_data_(&trail_data)
 {
         if (trail_data.is_object()) {
@@ -247,12 +247,13 @@ std::vector<std::pair<Room*, Room*>> GenerateTrails::plan_maze_connections(
         for (auto& candidate : candidates) {
                 candidate.jitter = jitter_dist(rng_);
         }
-        std::sort(candidates.begin(), candidates.end(), [](const CandidateEdge& lhs, const CandidateEdge& rhs) {
+        // Ties break on room order, not addresses, so a seed replays exactly.
+        std::sort(candidates.begin(), candidates.end(), [&index](const CandidateEdge& lhs, const CandidateEdge& rhs) {
                 double lw = lhs.distance + lhs.jitter * 25.0;
                 double rw = rhs.distance + rhs.jitter * 25.0;
                 if (lw == rw) {
-                        if (lhs.a == rhs.a) return lhs.b < rhs.b;
-                        return lhs.a < rhs.a;
+                        if (lhs.a == rhs.a) return index.at(lhs.b) < index.at(rhs.b);
+                        return index.at(lhs.a) < index.at(rhs.a);
                 }
                 return lw < rw;
         });
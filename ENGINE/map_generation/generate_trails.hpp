@@ -7,12 +7,13 @@
 #include <vector>
 #include <memory>
 #include <random>
+#include <cstdint>
 #include <nlohmann/json.hpp>
 
 class GenerateTrails {
 
 	public:
-    explicit GenerateTrails(nlohmann::json& trail_data);
+    GenerateTrails(nlohmann::json& trail_data, std::uint32_t seed);
     void set_all_rooms_reference(const std::vector<Room*>& rooms);
     std::vector<std::unique_ptr<Room>> generate_trails( const std::vector<std::pair<Room*, Room*>>& room_pairs, const std::vector<Area>& existing_areas, const std::string& map_dir, const std::string& map_info_path, AssetLibrary* asset_lib, const nlohmann::json* map_assets_data, double map_radius );
     void find_and_connect_isolated( const std::string& map_dir, const std::string& map_info_path, AssetLibrary* asset_lib, std::vector<Area>& existing_areas, std::vector<std::unique_ptr<Room>>& trail_rooms, const nlohmann::json* map_assets_data, double map_radius );
@@ -1,12 +1,14 @@
 #include "room.hpp"
 #include "spawn/asset_spawner.hpp"
 #include "asset/asset_types.hpp"
-#include <fstream>
+#include "utils/map_seed.hpp"
+#include "core/map_document.hpp"
 #include <nlohmann/json.hpp>
 #include <stdexcept>
 #include <algorithm>
 #include <iostream>
 #include <cmath>
+#include <chrono>
 using json = nlohmann::json;
 
 Room::Room(Point origin,
@@ -20,7 +22,9 @@ Room::Room(Point origin,
            nlohmann::json* room_data,
            const nlohmann::json* map_assets_data,
            double map_radius,
-           const std::string& data_section
+           const std::string& data_section,
+           std::uint32_t seed,
+           bool defer_spawn
 )
 : map_origin(origin),
 parent(parent),
@@ -33,7 +37,9 @@ type(type_),
 room_data_ptr_(room_data),
 map_assets_data_ptr_(map_assets_data),
 map_info_path_(map_info_path),
-data_section_(data_section)
+data_section_(data_section),
+asset_lib_(asset_lib),
+seed_(seed)
 {
         if (testing) {
                 std::cout << "[Room] Created room: " << room_name
@@ -99,8 +105,10 @@ data_section_(data_section)
                         << ", geometry: " << geometry
 			<< ", map radius: " << map_radius << "\n";
 		}
-                room_area = std::make_unique<Area>(room_name, SDL_Point{map_origin.first, map_origin.second}, width, height, geometry, edge_smoothness, map_w, map_h);
+                std::mt19937 shape_rng(map_seed::derive(seed, "area"));
+                room_area = std::make_unique<Area>(room_name, SDL_Point{map_origin.first, map_origin.second}, width, height, geometry, edge_smoothness, map_w, map_h, shape_rng);
 	}
+	const auto spawn_start = std::chrono::steady_clock::now();
 	std::vector<json> json_sources;
 	std::vector<std::string> source_paths;
 	json_sources.push_back(assets_json);
@@ -109,10 +117,17 @@ data_section_(data_section)
                 json_sources.push_back(*map_assets_data_ptr_);
                 source_paths.push_back(map_info_path_ + "::map_assets_data");
         }
-        planner = std::make_unique<AssetSpawnPlanner>( json_sources, *room_area, *asset_lib, source_paths );
+        planner = std::make_unique<AssetSpawnPlanner>( json_sources, *room_area, *asset_lib, source_paths, map_seed::derive(seed, "plan") );
+        spawn_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - spawn_start).count();
+        if (!defer_spawn) spawn_assets();
+}
+
+void Room::spawn_assets(bool buffer_log) {
+        const auto spawn_start = std::chrono::steady_clock::now();
         std::vector<Area> exclusion;
-        AssetSpawner spawner(asset_lib, exclusion);
-        spawner.spawn(*this);
+        AssetSpawner spawner(asset_lib_, exclusion, map_seed::derive(seed_, "spawn"));
+        spawner.spawn(*this, buffer_log);
+        spawn_ms += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - spawn_start).count();
 }
 
 void Room::set_sibling_left(Room* left_room) {
@@ -344,27 +359,12 @@ bool Room::is_spawn_room() const {
 }
 
 void Room::save_assets_json() const {
-        if (room_data_ptr_) {
-                *room_data_ptr_ = assets_json;
-        }
-        if (map_info_path_.empty() || data_section_.empty()) {
+        if (!room_data_ptr_) {
                 return;
         }
-        nlohmann::json map_info_json;
-        std::ifstream in(map_info_path_);
-        if (in.is_open()) {
-                in >> map_info_json;
-        }
-        if (!map_info_json.is_object()) {
-                map_info_json = nlohmann::json::object();
-        }
-        nlohmann::json& section = map_info_json[data_section_];
-        if (!section.is_object()) {
-                section = nlohmann::json::object();
-        }
-        section[room_name] = assets_json;
-        std::ofstream out(map_info_path_);
-        if (out.is_open()) {
-                out << map_info_json.dump(2);
+        *room_data_ptr_ = assets_json;
+        if (map_doc_) {
+                map_doc_->mark_dirty();
+                map_doc_->save_async();
         }
 }
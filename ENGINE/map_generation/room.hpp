@@ -3,6 +3,7 @@
 #include "utils/area.hpp"
 #include "asset/asset_library.hpp"
 #include "spawn/asset_spawn_planner.hpp"
+#include "spawn/spawn_logger.hpp"
 #include "asset/Asset.hpp"
 
 #include <string>
@@ -11,13 +12,16 @@
 #include <optional>
 #include <utility>
 #include <tuple>
+#include <cstdint>
 #include <nlohmann/json.hpp>
 
+class MapDocument;
+
 class Room {
 
 	public:
     typedef std::pair<int, int> Point;
-    Room(Point origin, std::string type_, const std::string& room_def_name, Room* parent, const std::string& map_dir, const std::string& map_info_path, AssetLibrary* asset_lib, Area* precomputed_area, nlohmann::json* room_data, const nlohmann::json* map_assets_data, double map_radius, const std::string& data_section);
+    Room(Point origin, std::string type_, const std::string& room_def_name, Room* parent, const std::string& map_dir, const std::string& map_info_path, AssetLibrary* asset_lib, Area* precomputed_area, nlohmann::json* room_data, const nlohmann::json* map_assets_data, double map_radius, const std::string& data_section, std::uint32_t seed, bool defer_spawn = false);
     void set_sibling_left(Room* left_room);
     void set_sibling_right(Room* right_room);
     void add_connecting_room(Room* room);
@@ -26,6 +30,12 @@ class Room {
     void add_room_assets(std::vector<std::unique_ptr<Asset>> new_assets);
     std::vector<std::unique_ptr<Asset>>&& get_room_assets();
     void set_layer(int value);
+    // Spawns the planned assets. The constructor does this itself unless
+    // defer_spawn is set; GenerateRooms defers it to spawn many rooms at once
+    // on worker threads, each room only touching its own area, assets and
+    // seeded generator. With buffer_log the spawn_log.csv rows are kept in
+    // spawn_log for the caller to write once all rooms are done.
+    void spawn_assets(bool buffer_log = false);
     Point map_origin;
     double scale_ = 1.0;
     std::string room_name;
@@ -37,6 +47,8 @@ class Room {
     Room* right_sibling = nullptr;
     int layer = -1;
     bool testing = false;
+    double spawn_ms = 0.0;   // planning + spawning time
+    std::vector<SpawnLogger::Record> spawn_log;
     std::vector<Room*> children;
     std::vector<Room*> connected_rooms;
     std::vector<std::unique_ptr<Asset>> assets;
@@ -45,15 +57,21 @@ class Room {
     std::string type;
     nlohmann::json create_static_room_json(std::string name);
     nlohmann::json& assets_data();
+    // room_data must point into this document's json(); saves then go through
+    // its background writer. Without a document saves only update room_data.
+    void set_map_document(MapDocument* doc) { map_doc_ = doc; }
     void save_assets_json() const;
     bool is_spawn_room() const;
 
 	private:
     nlohmann::json assets_json;
     nlohmann::json* room_data_ptr_ = nullptr;
+    MapDocument* map_doc_ = nullptr;
     const nlohmann::json* map_assets_data_ptr_ = nullptr;
     std::string map_info_path_;
     std::string data_section_;
+    AssetLibrary* asset_lib_ = nullptr;
+    std::uint32_t seed_ = 0;
     int clamp_int(int v, int lo, int hi) const;
     void bounds_to_size(const std::tuple<int,int,int,int>& b, int& w, int& h) const;
 };
@@ -1,4 +1,5 @@
 #include "trail_geometry.hpp"
+#include <algorithm>
 #include <cmath>
 #include <random>
 #include <vector>
@@ -94,20 +95,23 @@ SDL_Point TrailGeometry::compute_edge_point(const SDL_Point& center,
 	double dirX = dx / len;
 	double dirY = dy / len;
 	const int max_steps = 2000;
-	const double step_size = 1.0;
-	SDL_Point edge = center;
-	for (int i = 1; i <= max_steps; ++i) {
-		double px = center.x + dirX * i * step_size;
-		double py = center.y + dirY * i * step_size;
-		int ipx = static_cast<int>(std::lround(px));
-		int ipy = static_cast<int>(std::lround(py));
-		if (area->contains_point(SDL_Point{ ipx, ipy })) {
-			edge = SDL_Point{ ipx, ipy };
-		} else {
-			break;
-		}
+	auto sample = [&](int i) {
+		return SDL_Point{ static_cast<int>(std::lround(center.x + dirX * i)),
+		                  static_cast<int>(std::lround(center.y + dirY * i)) };
+};
+	// Replaces marching out one pixel at a time. The exact exit of the ray
+	// bounds the search; rounded samples can sit up to a pixel past it and
+	// still be inside, so start two samples beyond and walk back to the
+	// first one the area contains. Only rays that graze a vertex, where the
+	// march would have stepped out through a rounding gap, land elsewhere.
+	if (!area->contains_point(sample(1))) return center;
+	const double hit = area->ray_hit_distance(center.x, center.y, dirX, dirY);
+	const int steps = (hit < 0.0) ? max_steps : std::min(max_steps, static_cast<int>(std::floor(hit)) + 2);
+	for (int i = steps; i >= 1; --i) {
+		const SDL_Point p = sample(i);
+		if (area->contains_point(p)) return p;
 	}
-	return edge;
+	return center;
 }
 
 bool TrailGeometry::attempt_trail_connection(Room* a,
@@ -233,7 +237,7 @@ bool TrailGeometry::attempt_trail_connection(Room* a,
 			continue;
 		}
 
-                auto trail_room = std::make_unique<Room>( a->map_origin, "trail", name, nullptr, map_dir, map_info_path, asset_lib, &candidate, trail_config, map_assets_data, map_radius, "trails_data" );
+                auto trail_room = std::make_unique<Room>( a->map_origin, "trail", name, nullptr, map_dir, map_info_path, asset_lib, &candidate, trail_config, map_assets_data, map_radius, "trails_data", static_cast<std::uint32_t>(rng()) );
 		a->add_connecting_room(trail_room.get());
 		b->add_connecting_room(trail_room.get());
 		trail_room->add_connecting_room(a);
@@ -146,6 +146,38 @@ double camera::compute_room_scale_from_area(const Room* room) const {
     return s;
 }
 
+void camera::snapshot_tick_state() {
+    tick_state_.center = screen_center_;
+    tick_state_.scale  = scale_;
+    has_tick_state_    = true;
+}
+
+void camera::begin_interpolated_render(float alpha) {
+    if (interpolating_ || !has_tick_state_ || alpha >= 1.0f) {
+        return;
+    }
+    alpha = std::max(0.0f, alpha);
+    simulated_state_.center = screen_center_;
+    simulated_state_.scale  = scale_;
+    const auto lerp = [alpha](double a, double b) { return a + (b - a) * static_cast<double>(alpha); };
+    screen_center_ = SDL_Point{
+        static_cast<int>(std::lround(lerp(tick_state_.center.x, simulated_state_.center.x))),
+        static_cast<int>(std::lround(lerp(tick_state_.center.y, simulated_state_.center.y))) };
+    scale_ = static_cast<float>(lerp(tick_state_.scale, simulated_state_.scale));
+    recompute_current_view();
+    interpolating_ = true;
+}
+
+void camera::end_interpolated_render() {
+    if (!interpolating_) {
+        return;
+    }
+    screen_center_ = simulated_state_.center;
+    scale_         = simulated_state_.scale;
+    recompute_current_view();
+    interpolating_ = false;
+}
+
 void camera::set_up_rooms(CurrentRoomFinder* finder) {
     if (!finder) return;
     Room* current = finder->getCurrentRoom();
@@ -78,6 +78,14 @@ class camera {
 
     void update();
     void set_up_rooms(CurrentRoomFinder* finder);
+
+    // Fixed-step rendering: snapshot_tick_state() records the view before a
+    // simulation tick. begin_interpolated_render(alpha) blends from that
+    // snapshot toward the simulated view for one frame and
+    // end_interpolated_render() puts the simulated view back.
+    void snapshot_tick_state();
+    void begin_interpolated_render(float alpha);
+    void end_interpolated_render();
     void update_zoom(Room* cur, CurrentRoomFinder* finder, Asset* player);
 
     void pan(const std::vector<SDL_Point>& , int ) {}
@@ -121,6 +129,15 @@ class camera {
     SDL_Point  start_center_{0, 0};
     SDL_Point  target_center_{0, 0};
 
+    struct ViewState {
+        SDL_Point center{0, 0};
+        float     scale = 1.0f;
+};
+    bool       has_tick_state_ = false;
+    ViewState  tick_state_{};
+    bool       interpolating_ = false;
+    ViewState  simulated_state_{};
+
     bool       parallax_enabled_ = true;
     bool       realism_enabled_ = true;
     RealismSettings settings_{};
@@ -0,0 +1,102 @@
+#include "composite_cache.hpp"
+#include "render_target_pool.hpp"
+
+#include <algorithm>
+
+namespace {
+constexpr std::uint64_t kSweepInterval   = 30;
+constexpr std::uint64_t kMaxIdleFrames   = 90;
+}
+
+CompositeTexture::~CompositeTexture() {
+    RenderTargetPool& pool = RenderTargetPool::instance();
+    for (Level& level : mips) {
+        pool.release(level.texture);
+    }
+    pool.release(texture);
+}
+
+std::size_t CompositeTexture::estimated_bytes() const {
+    int w = 0;
+    int h = 0;
+    if (texture) SDL_QueryTexture(texture, nullptr, nullptr, &w, &h);
+    const std::size_t base = static_cast<std::size_t>(std::max(0, w)) * static_cast<std::size_t>(std::max(0, h)) * 4u;
+    // A full half-scale chain adds at most a third.
+    return base + base / 3u;
+}
+
+void CompositeCache::Key::add(std::int64_t v) {
+    words_.push_back(v);
+    std::uint64_t x = static_cast<std::uint64_t>(v);
+    for (int i = 0; i < 8; ++i) {
+        hash_ ^= (x & 0xffu);
+        hash_ *= 0x100000001b3ull;
+        x >>= 8;
+    }
+}
+
+std::shared_ptr<CompositeTexture> CompositeCache::find(const Key& key) {
+    auto range = entries_.equal_range(key.hash());
+    for (auto it = range.first; it != range.second; ++it) {
+        if (it->second.texture->key == key) {
+            it->second.last_used = frame_;
+            return it->second.texture;
+        }
+    }
+    return nullptr;
+}
+
+void CompositeCache::insert(std::shared_ptr<CompositeTexture> tex) {
+    if (!tex) return;
+    Entry entry;
+    entry.bytes     = tex->estimated_bytes();
+    entry.last_used = frame_;
+    const std::uint64_t hash = tex->key.hash();
+    entry.texture   = std::move(tex);
+    bytes_ += entry.bytes;
+    entries_.emplace(hash, std::move(entry));
+    if (bytes_ > kBudgetBytes) {
+        enforce_budget();
+    }
+}
+
+void CompositeCache::end_frame() {
+    ++frame_;
+    if (frame_ % kSweepInterval == 0) {
+        evict_idle(kMaxIdleFrames);
+    }
+}
+
+void CompositeCache::clear() {
+    entries_.clear();
+    bytes_ = 0;
+}
+
+void CompositeCache::evict_idle(std::uint64_t max_idle_frames) {
+    for (auto it = entries_.begin(); it != entries_.end();) {
+        const Entry& e = it->second;
+        if (e.texture.use_count() == 1 && frame_ - e.last_used >= max_idle_frames) {
+            bytes_ -= e.bytes;
+            it = entries_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void CompositeCache::enforce_budget() {
+    // Unreferenced entries go first, least recently used first. Entries still
+    // on screen stay even if that leaves the cache over budget.
+    std::vector<std::pair<std::uint64_t, decltype(entries_)::iterator>> idle;
+    for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+        if (it->second.texture.use_count() == 1) {
+            idle.emplace_back(it->second.last_used, it);
+        }
+    }
+    std::sort(idle.begin(), idle.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+    for (auto& [last_used, it] : idle) {
+        if (bytes_ <= kBudgetBytes) break;
+        bytes_ -= it->second.bytes;
+        entries_.erase(it);
+    }
+}
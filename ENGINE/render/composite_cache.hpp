@@ -0,0 +1,89 @@
+#pragma once
+
+#include <SDL.h>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+struct CompositeTexture;
+
+// Lit asset composites (frame + shadow/light mask) shared between assets.
+// A composite is identified by every input that affects its pixels, written
+// as a flat list of words: the frame, the target size and each light stamp
+// after culling and quantisation. Assets that share an AssetInfo and see the
+// same lighting therefore resolve to the same texture.
+//
+// Composites are handed out as shared_ptrs; an entry is only evicted once no
+// asset holds it and it has gone unused for a while, or sooner when the cache
+// is over its byte budget. Composites whose inputs change every frame
+// (flickering or moving lights) should not be inserted: their keys never
+// repeat, so every frame would mint an entry nobody reuses.
+class CompositeCache {
+public:
+    class Key {
+    public:
+        void clear() { words_.clear(); hash_ = 0xcbf29ce484222325ull; }
+        void add(std::int64_t v);
+        void add(const void* p) { add(static_cast<std::int64_t>(reinterpret_cast<std::uintptr_t>(p))); }
+        std::uint64_t hash() const { return hash_; }
+        bool operator==(const Key& o) const { return hash_ == o.hash_ && words_ == o.words_; }
+
+    private:
+        std::vector<std::int64_t> words_;
+        std::uint64_t hash_ = 0xcbf29ce484222325ull;
+    };
+
+    static constexpr std::size_t kBudgetBytes = 96u * 1024u * 1024u;
+
+    std::shared_ptr<CompositeTexture> find(const Key& key);
+    // tex->key must already hold key.
+    void insert(std::shared_ptr<CompositeTexture> tex);
+
+    // Advances the frame clock and periodically drops idle, unreferenced entries.
+    void end_frame();
+    void clear();
+    std::size_t size() const { return entries_.size(); }
+    std::size_t bytes() const { return bytes_; }
+
+private:
+    struct Entry {
+        std::shared_ptr<CompositeTexture> texture;
+        std::size_t   bytes     = 0;
+        std::uint64_t last_used = 0;
+    };
+
+    void evict_idle(std::uint64_t max_idle_frames);
+    void enforce_budget();
+
+    std::unordered_multimap<std::uint64_t, Entry> entries_;
+    std::size_t   bytes_ = 0;
+    std::uint64_t frame_ = 0;
+};
+
+// One lit asset image and its half-scale chain. mips[i] is the composite at
+// 2^-(i+1) scale; levels are built on first use by RenderAsset and, like the
+// composite itself, shared by every asset showing it. Composites never change
+// after they are drawn, so the chain never needs invalidating. key records
+// the inputs it was drawn from. All textures go back to RenderTargetPool on
+// destruction.
+struct CompositeTexture {
+    struct Level {
+        int          w       = 0;
+        int          h       = 0;
+        SDL_Texture* texture = nullptr;
+    };
+
+    explicit CompositeTexture(SDL_Texture* tex) : texture(tex) {}
+    ~CompositeTexture();
+    CompositeTexture(const CompositeTexture&) = delete;
+    CompositeTexture& operator=(const CompositeTexture&) = delete;
+
+    // Bytes of the composite plus an upper bound for its half-scale chain.
+    std::size_t estimated_bytes() const;
+
+    SDL_Texture*       texture = nullptr;
+    std::vector<Level> mips;
+    CompositeCache::Key key;
+};
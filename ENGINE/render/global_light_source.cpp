@@ -2,7 +2,6 @@
 #include "generate_light.hpp"
 #include "utils/light_source.hpp"
 #include <nlohmann/json.hpp>
-#include <fstream>
 #include <iostream>
 #include <cmath>
 #include <algorithm>
@@ -14,7 +13,7 @@ Global_Light_Source::Global_Light_Source(SDL_Renderer* renderer,
                                          SDL_Point screen_center,
                                          int screen_width,
                                          SDL_Color fallback_base_color,
-                                         const std::string& map_path)
+                                         const json& map_info)
 : renderer_(renderer),
 texture_(nullptr),
 base_color_(fallback_base_color),
@@ -27,7 +26,7 @@ frame_counter_(0),
 light_brightness(255)
 {
         set_defaults(screen_width, fallback_base_color);
-        if (!load_from_map_light(map_path)) {
+        if (!load_from_map_light(map_info)) {
                 build_texture();
                 set_light_brightness();
         }
@@ -48,25 +47,12 @@ void Global_Light_Source::set_defaults(int screen_width, SDL_Color fallback_base
         key_colors_.push_back({0.0f, base_color_});
 }
 
-bool Global_Light_Source::load_from_map_light(const std::string& map_path) {
-        if (map_path.empty()) {
+bool Global_Light_Source::load_from_map_light(const json& map_info) {
+        if (!map_info.is_object()) {
                 return false;
         }
-
-        std::ifstream in(map_path + "/map_info.json");
-        if (!in.is_open()) {
-                std::cerr << "[MapLight] Failed to open map_info.json in " << map_path << "\n";
-                return false;
-        }
-        json j;
-        try {
-                in >> j;
-        } catch (const std::exception& e) {
-                std::cerr << "[MapLight] Failed to parse map_info.json: " << e.what() << "\n";
-                return false;
-        }
-        auto it = j.find("map_light_data");
-        if (it == j.end() || !it->is_object()) {
+        auto it = map_info.find("map_light_data");
+        if (it == map_info.end() || !it->is_object()) {
 
                 std::cerr << "[MapLight] map_info.json has no valid map_light_data object. Using defaults.\n";
                 return false;
@@ -1,10 +1,12 @@
 #include "light_map.hpp"
 #include "render/camera.hpp"
+#include "utils/frame_profiler.hpp"
 #include <algorithm>
 #include <random>
 #include <vector>
 #include <iostream>
 #include <cmath>
+#include <cstdint>
 LightMap::LightMap(SDL_Renderer* renderer,
                    Assets* assets,
                    Global_Light_Source& main_light,
@@ -22,48 +24,88 @@ lowres_w_(0),
 lowres_h_(0)
 {}
 
+namespace {
+constexpr int kLightDownscale = 4;
+constexpr int kLightTilePx    = 32;   // low-res pixels per tile side
+constexpr SDL_Color kLightBase{ 0, 0, 0, 200 };
+
+std::uint64_t light_entry_hash(const LightMap::LightEntry& e) {
+    std::uint64_t h = 0xcbf29ce484222325ull;
+    auto mix = [&h](std::uint64_t v) {
+        h ^= v + 0x9e3779b97f4a7c15ull + (h << 6) + (h >> 2);
+};
+    mix(static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(e.tex)));
+    mix(static_cast<std::uint64_t>(static_cast<std::uint32_t>(e.dst.x)) << 32 | static_cast<std::uint32_t>(e.dst.y));
+    mix(static_cast<std::uint64_t>(static_cast<std::uint32_t>(e.dst.w)) << 32 | static_cast<std::uint32_t>(e.dst.h));
+    mix(static_cast<std::uint64_t>(e.alpha) << 8 | static_cast<std::uint64_t>(e.flip));
+    // Finalise so the per-tile sum below does not cancel structured inputs.
+    h ^= h >> 33; h *= 0xff51afd7ed558ccdull; h ^= h >> 33;
+    return h;
+}
+
+SDL_Rect scaled_light_rect(const SDL_Rect& dst, int downscale) {
+    return SDL_Rect{ dst.x / downscale, dst.y / downscale, dst.w / downscale, dst.h / downscale };
+}
+}
+
 LightMap::~LightMap() {
-        if (lowres_mask_tex_) {
-                SDL_DestroyTexture(lowres_mask_tex_);
-                lowres_mask_tex_ = nullptr;
-                lowres_w_ = 0;
-                lowres_h_ = 0;
+        for (SDL_Texture** tex : { &lowres_mask_tex_, &static_accum_tex_ }) {
+                if (*tex) {
+                        SDL_DestroyTexture(*tex);
+                        *tex = nullptr;
+                }
         }
+        lowres_w_ = lowres_h_ = 0;
+        static_w_ = static_h_ = 0;
 }
 
 void LightMap::render(bool debugging) {
+	PROFILE_SCOPE("LightMap::render");
 	if (debugging) std::cout << "[render_asset_lights_z] start\n";
 	static std::mt19937 flicker_rng{ std::random_device{}() };
-	static std::vector<LightEntry> z_lights;
-	z_lights.clear();
-	collect_layers(z_lights, flicker_rng);
-        const int downscale = 4;
-        const int low_w = std::max(1, screen_width_  / downscale);
-        const int low_h = std::max(1, screen_height_ / downscale);
+	collect_layers(static_lights_, dynamic_lights_, flicker_rng);
+        const int low_w = std::max(1, screen_width_  / kLightDownscale);
+        const int low_h = std::max(1, screen_height_ / kLightDownscale);
         SDL_Texture* prev_target = SDL_GetRenderTarget(renderer_);
-        SDL_Texture* lowres_mask = build_lowres_mask(z_lights, low_w, low_h, downscale);
-        if (lowres_mask) {
-                SDL_SetTextureBlendMode(lowres_mask, SDL_BLENDMODE_MOD);
-
+        SDL_Texture* lowres_mask = ensure_target(lowres_mask_tex_, lowres_w_, lowres_h_, low_w, low_h);
+        if (!lowres_mask) {
                 SDL_SetRenderTarget(renderer_, prev_target);
-                SDL_RenderCopy(renderer_, lowres_mask, nullptr, nullptr);
+                return;
+        }
+
+        // Light layers are all additive, so the static sum can be drawn
+        // first and the dynamic lights on top in any order.
+        SDL_Texture* static_accum = ensure_target(static_accum_tex_, static_w_, static_h_, low_w, low_h);
+        if (static_accum) {
+                update_static_tiles(static_accum, low_w, low_h, kLightDownscale);
+                SDL_SetRenderTarget(renderer_, lowres_mask);
+                SDL_SetTextureBlendMode(static_accum, SDL_BLENDMODE_NONE);
+                SDL_RenderCopy(renderer_, static_accum, nullptr, nullptr);
         } else {
-                SDL_SetRenderTarget(renderer_, prev_target);
+                SDL_SetRenderTarget(renderer_, lowres_mask);
+                SDL_SetRenderDrawColor(renderer_, kLightBase.r, kLightBase.g, kLightBase.b, kLightBase.a);
+                SDL_RenderClear(renderer_);
+                queue_layers(static_lights_, kLightDownscale, nullptr);
         }
+        queue_layers(dynamic_lights_, kLightDownscale, nullptr);
+        queue_.flush(renderer_);
+
+        SDL_SetTextureBlendMode(lowres_mask, SDL_BLENDMODE_MOD);
+        SDL_SetRenderTarget(renderer_, prev_target);
+        SDL_RenderCopy(renderer_, lowres_mask, nullptr, nullptr);
         if (debugging) std::cout << "[render_asset_lights_z] end\n";
 }
 
-void LightMap::collect_layers(std::vector<LightEntry>& out, std::mt19937& rng) {
+void LightMap::collect_layers(std::vector<LightEntry>& statics, std::vector<LightEntry>& dynamics, std::mt19937& rng) {
+	statics.clear();
+	dynamics.clear();
 	const float inv_scale = 1.0f / assets_->getView().get_scale();
 	constexpr int min_visible_w = 1;
 	constexpr int min_visible_h = 1;
+	const SDL_Rect screen{ 0, 0, screen_width_, screen_height_ };
 	Uint8 main_alpha = main_light_.get_current_color().a;
-        const auto& active = assets_->getActive();
-        if (out.capacity() < active.size() + 3) {
-                out.reserve(active.size() + 3);
-        }
 	if (fullscreen_light_tex_) {
-		out.push_back({ fullscreen_light_tex_, { 0, 0, screen_width_, screen_height_ },
+		dynamics.push_back({ fullscreen_light_tex_, { 0, 0, screen_width_, screen_height_ },
 			static_cast<Uint8>(main_alpha / 2), SDL_FLIP_NONE, false });
 	}
 	if (SDL_Texture* map_tex = main_light_.get_texture()) {
@@ -71,13 +113,14 @@ void LightMap::collect_layers(std::vector<LightEntry>& out, std::mt19937& rng) {
 		int lh = main_light_.get_cached_h();
 		if (lw == 0 || lh == 0) SDL_QueryTexture(map_tex, nullptr, nullptr, &lw, &lh);
 		SDL_Rect map_rect = get_scaled_position_rect(main_light_.get_position(), lw, lh, inv_scale, min_visible_w, min_visible_h);
-		if (map_rect.w != 0 || map_rect.h != 0) {
-			out.push_back({ map_tex, map_rect, main_alpha, SDL_FLIP_NONE, false });
+		if ((map_rect.w != 0 || map_rect.h != 0) && SDL_HasIntersection(&map_rect, &screen)) {
+			dynamics.push_back({ map_tex, map_rect, main_alpha, SDL_FLIP_NONE, false });
 		}
 	}
         const float main_brightness = static_cast<float>(main_light_.get_brightness());
-        for (Asset* a : active) {
+        for (Asset* a : assets_->getActive()) {
                 if (!a || !a->info || !a->info->is_light_source) continue;
+                const bool moving = a == assets_->player || a->info->moving_asset;
                 for (auto& light : a->info->light_sources) {
                         if (!light.texture) continue;
                         int offX = a->flipped ? -light.offset_x : light.offset_x;
@@ -87,10 +130,12 @@ void LightMap::collect_layers(std::vector<LightEntry>& out, std::mt19937& rng) {
                                 light.cached_w = lw;
                                 light.cached_h = lh;
                         }
-                        SDL_Rect dst = get_scaled_position_rect(SDL_Point{ a->pos.x + offX, a->pos.y + light.offset_y },
+                        const SDL_Point at = assets_->render_pos(a);
+                        SDL_Rect dst = get_scaled_position_rect(SDL_Point{ at.x + offX, at.y + light.offset_y },
                                            lw, lh, inv_scale,
                                            min_visible_w, min_visible_h);
                         if (dst.w == 0 && dst.h == 0) continue;
+                        if (!SDL_HasIntersection(&dst, &screen)) continue;
                         float alpha_f = main_brightness;
                         if (a == assets_->player) alpha_f *= 0.9f;
                         if (light.flicker > 0) {
@@ -99,61 +144,119 @@ void LightMap::collect_layers(std::vector<LightEntry>& out, std::mt19937& rng) {
                                         alpha_f *= (1.0f + std::uniform_real_distribution<float>(-max_jitter, max_jitter)(rng));
                         }
                         Uint8 alpha = static_cast<Uint8>(std::clamp(alpha_f, 0.0f, 255.0f));
+                        std::vector<LightEntry>& out = (moving || light.flicker > 0) ? dynamics : statics;
                         out.push_back({ light.texture, dst, alpha,
                  a->flipped ? SDL_FLIP_HORIZONTAL : SDL_FLIP_NONE, true });
                 }
         }
 }
 
-SDL_Texture* LightMap::ensure_lowres_target(int low_w, int low_h) {
+void LightMap::queue_layers(const std::vector<LightEntry>& layers, int downscale, const SDL_Rect* clip) {
+        RenderQueue::DrawCommand cmd;
+        cmd.blend = SDL_BLENDMODE_ADD;
+        for (const LightEntry& e : layers) {
+                cmd.dst = scaled_light_rect(e.dst, downscale);
+                if (clip && !SDL_HasIntersection(&cmd.dst, clip)) continue;
+                cmd.texture = e.tex;
+                cmd.flip    = e.flip;
+                cmd.mod     = SDL_Color{ 255, 255, 220, e.alpha };
+                queue_.push(cmd);
+        }
+}
+
+// Each tile keeps an order-independent hash of the static lights touching it;
+// only tiles whose hash changed are cleared and redrawn, in row runs under a
+// clip rect. When most tiles changed (camera moved) the whole buffer is
+// redrawn instead, so each light is drawn once rather than once per tile.
+void LightMap::update_static_tiles(SDL_Texture* target, int low_w, int low_h, int downscale) {
+        const int tiles_x = (low_w + kLightTilePx - 1) / kLightTilePx;
+        const int tiles_y = (low_h + kLightTilePx - 1) / kLightTilePx;
+        const std::size_t tile_count = static_cast<std::size_t>(tiles_x) * static_cast<std::size_t>(tiles_y);
+        if (tiles_x != tiles_x_ || tiles_y != tiles_y_ || tile_hash_.size() != tile_count) {
+                tiles_x_ = tiles_x;
+                tiles_y_ = tiles_y;
+                tile_hash_.assign(tile_count, ~0ull);
+        }
+        next_tile_hash_.assign(tile_count, 0);
+        const SDL_Rect bounds{ 0, 0, low_w, low_h };
+        for (const LightEntry& e : static_lights_) {
+                const SDL_Rect r = scaled_light_rect(e.dst, downscale);
+                SDL_Rect c;
+                if (!SDL_IntersectRect(&r, &bounds, &c)) continue;
+                const std::uint64_t h = light_entry_hash(e);
+                const int tx1 = (c.x + c.w - 1) / kLightTilePx;
+                const int ty1 = (c.y + c.h - 1) / kLightTilePx;
+                for (int ty = c.y / kLightTilePx; ty <= ty1; ++ty) {
+                        for (int tx = c.x / kLightTilePx; tx <= tx1; ++tx) {
+                                next_tile_hash_[static_cast<std::size_t>(ty) * tiles_x + tx] += h;
+                        }
+                }
+        }
+
+        std::size_t dirty = 0;
+        for (std::size_t t = 0; t < tile_count; ++t) {
+                if (next_tile_hash_[t] != tile_hash_[t]) ++dirty;
+        }
+        tile_hash_.swap(next_tile_hash_);
+        if (dirty == 0) return;
+
+        SDL_SetRenderTarget(renderer_, target);
+        SDL_SetRenderDrawColor(renderer_, kLightBase.r, kLightBase.g, kLightBase.b, kLightBase.a);
+        if (dirty * 2 > tile_count) {
+                SDL_RenderClear(renderer_);
+                queue_layers(static_lights_, downscale, nullptr);
+                queue_.flush(renderer_);
+                return;
+        }
+
+        SDL_SetRenderDrawBlendMode(renderer_, SDL_BLENDMODE_NONE);
+        for (int ty = 0; ty < tiles_y; ++ty) {
+                int tx = 0;
+                while (tx < tiles_x) {
+                        const std::size_t row = static_cast<std::size_t>(ty) * tiles_x;
+                        if (tile_hash_[row + tx] == next_tile_hash_[row + tx]) { ++tx; continue; }
+                        const int run_start = tx;
+                        while (tx < tiles_x && tile_hash_[row + tx] != next_tile_hash_[row + tx]) ++tx;
+                        SDL_Rect run{ run_start * kLightTilePx, ty * kLightTilePx,
+                                      (tx - run_start) * kLightTilePx, kLightTilePx };
+                        SDL_IntersectRect(&run, &bounds, &run);
+                        SDL_RenderSetClipRect(renderer_, &run);
+                        SDL_RenderFillRect(renderer_, &run);
+                        queue_layers(static_lights_, downscale, &run);
+                        queue_.flush(renderer_);
+                }
+        }
+        SDL_RenderSetClipRect(renderer_, nullptr);
+        SDL_SetRenderDrawBlendMode(renderer_, SDL_BLENDMODE_BLEND);
+}
+
+SDL_Texture* LightMap::ensure_target(SDL_Texture*& tex, int& tex_w, int& tex_h, int low_w, int low_h) {
         if (low_w <= 0 || low_h <= 0) {
                 return nullptr;
         }
-        if (lowres_mask_tex_ && (lowres_w_ != low_w || lowres_h_ != low_h)) {
-                SDL_DestroyTexture(lowres_mask_tex_);
-                lowres_mask_tex_ = nullptr;
+        if (tex && (tex_w != low_w || tex_h != low_h)) {
+                SDL_DestroyTexture(tex);
+                tex = nullptr;
         }
-        if (!lowres_mask_tex_) {
-                lowres_mask_tex_ = SDL_CreateTexture(renderer_, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, low_w, low_h);
-                if (!lowres_mask_tex_) {
-                        lowres_w_ = 0;
-                        lowres_h_ = 0;
+        if (!tex) {
+                tex = SDL_CreateTexture(renderer_, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, low_w, low_h);
+                if (!tex) {
+                        tex_w = 0;
+                        tex_h = 0;
                         return nullptr;
                 }
-                SDL_SetTextureBlendMode(lowres_mask_tex_, SDL_BLENDMODE_NONE);
+                SDL_SetTextureBlendMode(tex, SDL_BLENDMODE_NONE);
 #if SDL_VERSION_ATLEAST(2,0,12)
-                SDL_SetTextureScaleMode(lowres_mask_tex_, SDL_ScaleModeBest);
+                SDL_SetTextureScaleMode(tex, SDL_ScaleModeBest);
 #endif
-                lowres_w_ = low_w;
-                lowres_h_ = low_h;
-        }
-        return lowres_mask_tex_;
-}
-
-SDL_Texture* LightMap::build_lowres_mask(const std::vector<LightEntry>& layers,
-                                         int low_w, int low_h, int downscale) {
-        SDL_Texture* lowres_mask = ensure_lowres_target(low_w, low_h);
-        if (!lowres_mask) {
-                return nullptr;
+                tex_w = low_w;
+                tex_h = low_h;
+                if (&tex == &static_accum_tex_) {
+                        // Fresh contents are undefined; force every tile dirty.
+                        tile_hash_.clear();
+                }
         }
-        SDL_SetRenderTarget(renderer_, lowres_mask);
-        SDL_SetTextureBlendMode(lowres_mask, SDL_BLENDMODE_NONE);
-        SDL_SetRenderDrawColor(renderer_, 0, 0, 0, 200);
-        SDL_RenderClear(renderer_);
-        SDL_SetRenderDrawBlendMode(renderer_, SDL_BLENDMODE_ADD);
-	for (auto& e : layers) {
-		SDL_SetTextureBlendMode(e.tex, SDL_BLENDMODE_ADD);
-		SDL_SetTextureAlphaMod(e.tex, e.alpha);
-		SDL_SetTextureColorMod(e.tex, 255, 255, 220);
-		SDL_Rect scaled_dst{
-			e.dst.x / downscale,
-			e.dst.y / downscale,
-			e.dst.w / downscale,
-			e.dst.h / downscale
-};
-		SDL_RenderCopyEx(renderer_, e.tex, nullptr, &scaled_dst, 0, nullptr, e.flip);
-	}
-	return lowres_mask;
+        return tex;
 }
 
 SDL_Rect LightMap::get_scaled_position_rect(SDL_Point pos, int fw, int fh,
@@ -3,9 +3,11 @@
 #include <SDL.h>
 #include <vector>
 #include <random>
+#include <cstdint>
 #include "core/AssetsManager.hpp"
 #include "global_light_source.hpp"
 #include "render/camera.hpp"
+#include "render/render_queue.hpp"
 
 class LightMap {
 
@@ -23,10 +25,15 @@ public:
         void render(bool debugging);
 
 private:
-        void collect_layers(std::vector<LightEntry>& out, std::mt19937& rng);
-        SDL_Texture* build_lowres_mask(const std::vector<LightEntry>& layers, int low_w, int low_h, int downscale);
+        // Lights that usually hold still (non-flickering lights on stationary
+        // assets) go to `statics`, which are accumulated per tile; everything
+        // else goes to `dynamics` and is redrawn every frame. Both lists are
+        // already culled to the screen.
+        void collect_layers(std::vector<LightEntry>& statics, std::vector<LightEntry>& dynamics, std::mt19937& rng);
+        void update_static_tiles(SDL_Texture* target, int low_w, int low_h, int downscale);
+        void queue_layers(const std::vector<LightEntry>& layers, int downscale, const SDL_Rect* clip);
         SDL_Rect get_scaled_position_rect(SDL_Point pos, int fw, int fh, float inv_scale, int min_w, int min_h);
-        SDL_Texture* ensure_lowres_target(int low_w, int low_h);
+        SDL_Texture* ensure_target(SDL_Texture*& tex, int& tex_w, int& tex_h, int low_w, int low_h);
 
 private:
         SDL_Renderer* renderer_;
@@ -38,4 +45,16 @@ private:
         SDL_Texture* lowres_mask_tex_ = nullptr;
         int lowres_w_ = 0;
         int lowres_h_ = 0;
+        // Base darkness plus every static light, kept between frames and only
+        // redrawn in tiles whose set of overlapping lights changed.
+        SDL_Texture* static_accum_tex_ = nullptr;
+        int static_w_ = 0;
+        int static_h_ = 0;
+        int tiles_x_ = 0;
+        int tiles_y_ = 0;
+        std::vector<std::uint64_t> tile_hash_;
+        std::vector<std::uint64_t> next_tile_hash_;
+        std::vector<LightEntry> static_lights_;
+        std::vector<LightEntry> dynamic_lights_;
+        RenderQueue queue_;
 };
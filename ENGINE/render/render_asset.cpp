@@ -5,6 +5,7 @@
 #include "core/AssetsManager.hpp"
 #include "utils/light_utils.hpp"
 #include "render/camera.hpp"
+#include "render/render_target_pool.hpp"
 #include <algorithm>
 #include <cmath>
 #include <random>
@@ -21,111 +22,181 @@ RenderAsset::RenderAsset(SDL_Renderer* renderer,
   main_light_source_(main_light),
   p(player) {}
 
-SDL_Texture* RenderAsset::render_shadow_mask(Asset* a, int bw, int bh) {
-    SDL_Texture* mask = SDL_CreateTexture(renderer_, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, bw, bh);
-    if (!mask) return nullptr;
-    SDL_SetTextureBlendMode(mask, SDL_BLENDMODE_BLEND);
+namespace {
+// Light inputs are snapped before they key a composite so that sub-step
+// changes (a few pixels of player motion, one step of day-cycle alpha) reuse
+// the existing texture instead of recompositing.
+constexpr int kLightOffsetStep = 2;
+constexpr int kLightAlphaStep  = 4;
+
+int quantize_light_offset(int v) {
+    const int half = kLightOffsetStep / 2;
+    return v >= 0 ? ((v + half) / kLightOffsetStep) * kLightOffsetStep
+                  : -((-v + half) / kLightOffsetStep) * kLightOffsetStep;
+}
+
+Uint8 quantize_light_alpha(float a) {
+    const int v = static_cast<int>(std::lround(std::clamp(a, 0.0f, 255.0f)));
+    return static_cast<Uint8>(std::min(255, ((v + kLightAlphaStep / 2) / kLightAlphaStep) * kLightAlphaStep));
+}
+}
+
+RenderAsset::~RenderAsset() {
+    composites_.clear();
+}
+
+bool RenderAsset::push_stamp(SDL_Texture* tex, const SDL_Rect& bounds, int dx_world, int dy_world, int lw, int lh, float alpha) {
+    const Uint8 a = quantize_light_alpha(alpha);
+    if (!tex || a == 0 || lw <= 0 || lh <= 0) return false;
+    const SDL_Rect dst{
+        (bounds.w / 2) + quantize_light_offset(dx_world) - (lw / 2),
+        bounds.h + quantize_light_offset(dy_world) - (lh / 2), lw, lh };
+    // Lights that miss the composite contribute nothing and must not split the key.
+    if (!SDL_HasIntersection(&dst, &bounds)) return false;
+    stamps_.push_back(LightStamp{ tex, dst, a });
+    return true;
+}
+
+void RenderAsset::gather_light_stamps(Asset* a, int bw, int bh) {
+    const SDL_Rect bounds{ 0, 0, bw, bh };
+    const Uint8 light_alpha = static_cast<Uint8>(main_light_source_.get_brightness());
+    stamp_received_static_lights(a, bounds, light_alpha);
+    stamp_moving_lights(a, bounds, light_alpha);
+    const Uint8 main_alpha = main_light_source_.get_current_color().a;
+    stamp_orbital_lights(a, bounds, main_alpha);
+}
+
+void RenderAsset::render_shadow_mask(SDL_Texture* mask, const AtlasFrame& base) {
     SDL_Texture* prev_target = SDL_GetRenderTarget(renderer_);
+    SDL_BlendMode prev_draw_blend = SDL_BLENDMODE_BLEND;
+    SDL_GetRenderDrawBlendMode(renderer_, &prev_draw_blend);
     SDL_SetRenderTarget(renderer_, mask);
     SDL_SetRenderDrawColor(renderer_, 255, 255, 255, 0);
     SDL_RenderClear(renderer_);
-    if (SDL_Texture* base = a->get_current_frame()) {
-        SDL_SetTextureBlendMode(base, SDL_BLENDMODE_BLEND);
-        SDL_SetTextureColorMod(base, 0, 0, 0);
-        SDL_RenderCopy(renderer_, base, nullptr, nullptr);
-        SDL_SetTextureColorMod(base, 255, 255, 255);
+    SDL_SetTextureBlendMode(base.texture, SDL_BLENDMODE_BLEND);
+    SDL_SetTextureColorMod(base.texture, 0, 0, 0);
+    base.render(renderer_, nullptr);
+    SDL_SetTextureColorMod(base.texture, 255, 255, 255);
+    for (const LightStamp& st : stamps_) {
+        SDL_SetTextureBlendMode(st.texture, SDL_BLENDMODE_ADD);
+        SDL_SetTextureAlphaMod(st.texture, st.alpha);
+        SDL_RenderCopy(renderer_, st.texture, nullptr, &st.dst);
+        SDL_SetTextureAlphaMod(st.texture, 255);
     }
-    const camera::RenderEffects effects =
-        cam_.compute_render_effects(SDL_Point{a->pos.x, a->pos.y}, 0.0f, 0.0f);
-    SDL_Point parallax_pos = effects.screen_position;
-    SDL_Rect bounds{ parallax_pos.x - bw / 2, parallax_pos.y - bh, bw, bh };
-    const Uint8 light_alpha = static_cast<Uint8>(main_light_source_.get_brightness());
-    render_shadow_received_static_lights(a, bounds, light_alpha);
-    render_shadow_moving_lights(a, bounds, light_alpha);
-    const Uint8 main_alpha = main_light_source_.get_current_color().a;
-    render_shadow_orbital_lights(a, bounds, main_alpha);
     SDL_SetRenderDrawBlendMode(renderer_, SDL_BLENDMODE_MOD);
     SDL_SetRenderDrawColor(renderer_, 255, 255, 255, 204);
     SDL_RenderFillRect(renderer_, nullptr);
+    SDL_SetRenderDrawBlendMode(renderer_, prev_draw_blend);
     SDL_SetRenderTarget(renderer_, prev_target);
-    return mask;
 }
 
-SDL_Texture* RenderAsset::regenerateFinalTexture(Asset* a) {
-    if (!a) return nullptr;
-    SDL_Texture* base = a->get_current_frame();
-    if (!base) return nullptr;
-
-    int bw = a->cached_w, bh = a->cached_h;
-    if (bw == 0 || bh == 0) {
-        SDL_QueryTexture(base, nullptr, nullptr, &bw, &bh);
-    }
-
-    SDL_Texture* existing_final = a->get_final_texture();
-    SDL_Texture* final_tex      = existing_final;
-    bool reuse_texture          = true;
-
-    if (final_tex) {
-        int query_w = 0, query_h = 0;
-        Uint32 fmt = 0; int access = 0;
-        if (SDL_QueryTexture(final_tex, &fmt, &access, &query_w, &query_h) != 0 ||
-            access != SDL_TEXTUREACCESS_TARGET || query_w != bw || query_h != bh) {
-            reuse_texture = false;
-        }
-    } else {
-        reuse_texture = false;
-    }
-
-    if (!reuse_texture) {
-        final_tex = SDL_CreateTexture(renderer_, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, bw, bh);
-        if (!final_tex) {
-            return nullptr;
-        }
+SDL_Texture* RenderAsset::compose(const AtlasFrame& base, int bw, int bh, bool shaded, bool nearest) {
+    RenderTargetPool& pool = RenderTargetPool::instance();
+    SDL_Texture* final_tex = pool.acquire(renderer_, bw, bh);
+    if (!final_tex) {
+        return nullptr;
     }
-
-    const bool low_quality = assets_ && assets_->is_dev_mode();
-
-    SDL_SetTextureBlendMode(final_tex, SDL_BLENDMODE_BLEND);
 #if SDL_VERSION_ATLEAST(2,0,12)
-    SDL_SetTextureScaleMode(
-        final_tex,
-        low_quality ? SDL_ScaleModeNearest
-                    : ((a && a->info && !a->info->smooth_scaling) ? SDL_ScaleModeNearest : SDL_ScaleModeBest));
+    SDL_SetTextureScaleMode(final_tex, nearest ? SDL_ScaleModeNearest : SDL_ScaleModeBest);
+#else
+    (void)nearest;
 #endif
 
-    a->clear_downscale_cache();
-
     SDL_Texture* prev_target = SDL_GetRenderTarget(renderer_);
     SDL_SetRenderTarget(renderer_, final_tex);
     SDL_SetRenderDrawColor(renderer_, 0, 0, 0, 0);
     SDL_RenderClear(renderer_);
 
-    const Uint8 main_alpha = main_light_source_.get_current_color().a;
-    const float c = a->alpha_percentage;
-    int alpha_mod = (c >= 1.0f) ? 255 : int(main_alpha * c);
-    if (a->info->type == asset_types::player) {
-        alpha_mod = std::min(255, alpha_mod * 3);
-    }
-
-    SDL_SetTextureColorMod(base, 255, 255, 255);
-    SDL_RenderCopy(renderer_, base, nullptr, nullptr);
-    SDL_SetTextureColorMod(base, 255, 255, 255);
+    SDL_SetTextureColorMod(base.texture, 255, 255, 255);
+    base.render(renderer_, nullptr);
 
-    if (a->is_shaded && !low_quality) {
-        if (SDL_Texture* mask = render_shadow_mask(a, bw, bh)) {
+    if (shaded) {
+        if (SDL_Texture* mask = pool.acquire(renderer_, bw, bh)) {
+            render_shadow_mask(mask, base);
             SDL_SetRenderTarget(renderer_, final_tex);
             SDL_SetTextureBlendMode(mask, SDL_BLENDMODE_MOD);
             SDL_RenderCopy(renderer_, mask, nullptr, nullptr);
-            SDL_DestroyTexture(mask);
+            pool.release(mask);
         }
     }
 
     SDL_SetRenderTarget(renderer_, prev_target);
-    a->cached_w = bw;
-    a->cached_h = bh;
     return final_tex;
 }
 
+SDL_Texture* RenderAsset::refresh_final_texture(Asset* a) {
+    if (!a || !a->info) return nullptr;
+    const AtlasFrame* base = a->get_current_frame();
+    if (!base || !base->texture) return a->get_final_texture();
+    const int bw = base->width();
+    const int bh = base->height();
+    if (bw <= 0 || bh <= 0) return a->get_final_texture();
+
+    const bool low_quality = assets_ && assets_->is_dev_mode();
+    const bool shaded      = a->is_shaded && !low_quality;
+    const bool nearest     = low_quality || !a->info->smooth_scaling;
+
+    stamps_.clear();
+    volatile_stamps_ = false;
+    if (shaded) {
+        gather_light_stamps(a, bw, bh);
+    }
+
+    key_.clear();
+    key_.add(a->info.get());
+    key_.add(a->info->animations_revision);
+    key_.add(base->texture);
+    key_.add(base->src.x);
+    key_.add(base->src.y);
+    key_.add(base->flipped);
+    key_.add(bw);
+    key_.add(bh);
+    key_.add(shaded);
+    key_.add(nearest);
+    for (const LightStamp& st : stamps_) {
+        key_.add(st.texture);
+        key_.add(st.dst.x);
+        key_.add(st.dst.y);
+        key_.add(st.dst.w);
+        key_.add(st.dst.h);
+        key_.add(st.alpha);
+    }
+
+    if (a->final_texture && a->final_texture->key == key_) {
+        return a->get_final_texture();
+    }
+
+    if (volatile_stamps_) {
+        // Nobody else can reuse this key, so compose into a private target.
+        // Dropping the previous private one first lets the pool hand the same
+        // texture straight back.
+        if (a->final_texture.use_count() == 1) {
+            a->set_final_texture(nullptr);
+        }
+        SDL_Texture* raw = compose(*base, bw, bh, shaded, nearest);
+        if (!raw) return a->get_final_texture();
+        auto tex = std::make_shared<CompositeTexture>(raw);
+        tex->key = key_;
+        a->set_final_texture(std::move(tex));
+        return a->get_final_texture();
+    }
+
+    std::shared_ptr<CompositeTexture> tex = composites_.find(key_);
+    if (!tex) {
+        SDL_Texture* raw = compose(*base, bw, bh, shaded, nearest);
+        if (!raw) return a->get_final_texture();
+        tex = std::make_shared<CompositeTexture>(raw);
+        tex->key = key_;
+        composites_.insert(tex);
+    }
+    a->set_final_texture(std::move(tex));
+    return a->get_final_texture();
+}
+
+void RenderAsset::end_frame() {
+    composites_.end_frame();
+}
+
 namespace {
 
 static SDL_Texture* create_half_scale(SDL_Renderer* renderer,
@@ -142,16 +213,12 @@ static SDL_Texture* create_half_scale(SDL_Renderer* renderer,
     const int dst_w = std::max(1, src_w / 2);
     const int dst_h = std::max(1, src_h / 2);
 
-    SDL_Texture* half = SDL_CreateTexture(renderer, format,
-                                          SDL_TEXTUREACCESS_TARGET,
-                                          dst_w, dst_h);
+    // Pooled targets come back with BLEND, so alpha behaves the same when these are later drawn.
+    SDL_Texture* half = RenderTargetPool::instance().acquire(renderer, dst_w, dst_h, format);
     if (!half) {
         return nullptr;
     }
 
-    // Keep BLEND so alpha behaves the same when these are later drawn.
-    SDL_SetTextureBlendMode(half, SDL_BLENDMODE_BLEND);
-
 #if SDL_VERSION_ATLEAST(2,0,12)
     // Force fastest sampling for this speed mode
     SDL_SetTextureScaleMode(source, SDL_ScaleModeNearest);
@@ -161,7 +228,10 @@ static SDL_Texture* create_half_scale(SDL_Renderer* renderer,
     SDL_Texture* prev_target = SDL_GetRenderTarget(renderer);
     SDL_SetRenderTarget(renderer, half);
 
-    // No clear. We overwrite the full target area below.
+    // Pooled targets keep whatever the previous user drew, and the source is
+    // copied with BLEND, so clear first or stale pixels show through.
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+    SDL_RenderClear(renderer);
     SDL_Rect dst{0, 0, dst_w, dst_h};
     SDL_RenderCopy(renderer, source, nullptr, &dst);
 
@@ -170,37 +240,20 @@ static SDL_Texture* create_half_scale(SDL_Renderer* renderer,
 }
 }
 
-SDL_Texture* RenderAsset::texture_for_scale(Asset* asset,
-                                            SDL_Texture* base_tex,
-                                            int base_w,
-                                            int base_h,
-                                            int target_w,
-                                            int target_h,
-                                            float camera_scale) {
-    if (!asset || !base_tex || base_w <= 0 || base_h <= 0 || target_w <= 0 || target_h <= 0) {
-        return base_tex;
+SDL_Texture* RenderAsset::texture_for_scale(Asset* asset, int target_w, int target_h, float camera_scale) {
+    if (!asset || !asset->final_texture) {
+        return nullptr;
     }
-
-    if (asset->last_scaled_texture_ && asset->last_scaled_source_ == base_tex &&
-        asset->last_scaled_w_ == target_w && asset->last_scaled_h_ == target_h &&
-        std::abs(asset->last_scaled_camera_scale_ - camera_scale) <= 0.0001f) {
-        return asset->last_scaled_texture_;
+    CompositeTexture& comp = *asset->final_texture;
+    const int base_w = asset->cached_w;
+    const int base_h = asset->cached_h;
+    if (!comp.texture || base_w <= 0 || base_h <= 0 || target_w <= 0 || target_h <= 0) {
+        return comp.texture;
     }
 
-    auto remember_result = [&](SDL_Texture* tex) {
-        asset->last_scaled_source_       = base_tex;
-        asset->last_scaled_texture_      = tex;
-        asset->last_scaled_w_            = target_w;
-        asset->last_scaled_h_            = target_h;
-        asset->last_scaled_camera_scale_ = camera_scale;
-        return tex ? tex : base_tex;
-    };
-
-    const bool low_quality     = assets_ && assets_->is_dev_mode();
-    const bool smooth_scaling  = (asset && asset->info && asset->info->smooth_scaling);
-
+    const bool low_quality = assets_ && assets_->is_dev_mode();
     if (low_quality) {
-        return remember_result(base_tex);
+        return comp.texture;
     }
 
     const float ratio_w = static_cast<float>(target_w) / static_cast<float>(base_w);
@@ -212,7 +265,7 @@ SDL_Texture* RenderAsset::texture_for_scale(Asset* asset,
         ratio *= std::max(0.0001f, bias);
     }
     if (ratio >= 0.95f) {
-        return remember_result(base_tex);
+        return comp.texture;
     }
 
     int levels = 0;
@@ -229,78 +282,41 @@ SDL_Texture* RenderAsset::texture_for_scale(Asset* asset,
     }
 
     if (levels <= 0) {
-        return remember_result(base_tex);
+        return comp.texture;
     }
 
-    Uint32 format = SDL_PIXELFORMAT_RGBA8888;
-    if (SDL_QueryTexture(base_tex, &format, nullptr, nullptr, nullptr) != 0) {
-        format = SDL_PIXELFORMAT_RGBA8888;
-    }
-
-    SDL_Texture* current_tex   = base_tex;
-    int          current_w     = base_w;
-    int          current_h     = base_h;
-    float        current_scale = 1.0f;
-
-    for (int level = 0; level < levels; ++level) {
-        float next_scale = current_scale * 0.5f;
-        const int next_w = std::max(1, current_w / 2);
-        const int next_h = std::max(1, current_h / 2);
-
-        auto it = std::find_if(asset->downscale_cache_.begin(),
-                               asset->downscale_cache_.end(),
-                               [next_scale](const Asset::DownscaleCacheEntry& entry) {
-                                   return std::abs(entry.scale - next_scale) <= 0.0001f;
-                               });
-
-        if (it == asset->downscale_cache_.end() || !it->texture || it->width != next_w || it->height != next_h) {
-            SDL_Texture* created = create_half_scale(renderer_,
-                                                     current_tex,
-                                                     format,
-                                                     current_w,
-                                                     current_h,
-                                                     low_quality,
-                                                     smooth_scaling);
-            if (!created) {
-                SDL_Texture* fallback = (level == 0) ? base_tex : current_tex;
-                return remember_result(fallback);
-            }
-            Asset::DownscaleCacheEntry entry;
-            entry.scale   = next_scale;
-            entry.width   = next_w;
-            entry.height  = next_h;
-            entry.texture = created;
-            if (it == asset->downscale_cache_.end()) {
-                asset->downscale_cache_.push_back(entry);
-                it = asset->downscale_cache_.begin() + (asset->downscale_cache_.size() - 1);
-            } else {
-                if (it->texture) {
-                    SDL_DestroyTexture(it->texture);
-                }
-                *it = entry;
-            }
+    // Missing levels are appended in order, each halved from the one above,
+    // and stay with the composite for every asset that shares it.
+    if (static_cast<int>(comp.mips.size()) < levels) {
+        Uint32 format = SDL_PIXELFORMAT_RGBA8888;
+        if (SDL_QueryTexture(comp.texture, &format, nullptr, nullptr, nullptr) != 0) {
+            format = SDL_PIXELFORMAT_RGBA8888;
+        }
+        const bool smooth_scaling = asset->info && asset->info->smooth_scaling;
+        while (static_cast<int>(comp.mips.size()) < levels) {
+            SDL_Texture* src = comp.mips.empty() ? comp.texture : comp.mips.back().texture;
+            const int src_w  = comp.mips.empty() ? base_w : comp.mips.back().w;
+            const int src_h  = comp.mips.empty() ? base_h : comp.mips.back().h;
+            SDL_Texture* half = create_half_scale(renderer_, src, format, src_w, src_h, low_quality, smooth_scaling);
+            if (!half) break;
+            comp.mips.push_back(CompositeTexture::Level{ std::max(1, src_w / 2), std::max(1, src_h / 2), half });
+        }
+        if (comp.mips.empty()) {
+            return comp.texture;
         }
-
-        current_tex   = it->texture;
-        current_w     = it->width;
-        current_h     = it->height;
-        current_scale = next_scale;
     }
 
-    return remember_result(current_tex ? current_tex : base_tex);
+    const std::size_t level = std::min(static_cast<std::size_t>(levels), comp.mips.size());
+    return comp.mips[level - 1].texture;
 }
 
-void RenderAsset::render_shadow_moving_lights(Asset* a, const SDL_Rect& bounds, Uint8 alpha) {
+void RenderAsset::stamp_moving_lights(Asset* a, const SDL_Rect& bounds, Uint8 alpha) {
     if (!p || !p->info || !a) return;
+    const double factor = LightUtils::calculate_static_alpha_percentage(a, p);
     for (auto& light : p->info->light_sources) {
         if (!light.texture) continue;
         const int world_lx = p->pos.x + light.offset_x;
         const int world_ly = p->pos.y + light.offset_y;
-        const double factor = LightUtils::calculate_static_alpha_percentage(a, p);
-        const Uint8 inten = static_cast<Uint8>(alpha * factor);
-
-        const int dx_world = world_lx - a->pos.x;
-        const int dy_world = world_ly - a->pos.y;
 
         int lw = light.cached_w, lh = light.cached_h;
         if (lw == 0 || lh == 0) {
@@ -308,20 +324,15 @@ void RenderAsset::render_shadow_moving_lights(Asset* a, const SDL_Rect& bounds,
             light.cached_w = lw;
             light.cached_h = lh;
         }
-
-        const int bw = bounds.w;
-        const int bh = bounds.h;
-        SDL_Rect dst{
-            (bw / 2) + dx_world - (lw / 2), bh + dy_world - (lh / 2), lw, lh };
-
-        SDL_SetTextureBlendMode(light.texture, SDL_BLENDMODE_ADD);
-        SDL_SetTextureAlphaMod(light.texture, inten);
-        SDL_RenderCopy(renderer_, light.texture, nullptr, &dst);
-        SDL_SetTextureAlphaMod(light.texture, 255);
+        // Follows the player, so the offset changes whenever either side moves.
+        if (push_stamp(light.texture, bounds, world_lx - a->pos.x, world_ly - a->pos.y, lw, lh,
+                       static_cast<float>(alpha * factor))) {
+            volatile_stamps_ = true;
+        }
     }
 }
 
-void RenderAsset::render_shadow_orbital_lights(Asset* a, const SDL_Rect& bounds, Uint8 alpha) {
+void RenderAsset::stamp_orbital_lights(Asset* a, const SDL_Rect& bounds, Uint8 alpha) {
     if (!a || !a->info) return;
     const float angle = main_light_source_.get_angle();
     for (auto& light : a->info->orbital_light_sources) {
@@ -333,36 +344,24 @@ void RenderAsset::render_shadow_orbital_lights(Asset* a, const SDL_Rect& bounds,
         const float lx = static_cast<float>(a->pos.x) + offset_x + orbit_x;
         const float ly = static_cast<float>(a->pos.y) + light.offset_y - std::sin(angle) * light.y_radius;
 
-        const int dx_world = static_cast<int>(std::lround(lx)) - a->pos.x;
-        const int dy_world = static_cast<int>(std::lround(ly)) - a->pos.y;
-
         int lw = light.cached_w, lh = light.cached_h;
         if (lw == 0 || lh == 0) {
             SDL_QueryTexture(light.texture, nullptr, nullptr, &lw, &lh);
             light.cached_w = lw;
             light.cached_h = lh;
         }
-
-        const int bw = bounds.w;
-        const int bh = bounds.h;
-        SDL_Rect dst{
-            (bw / 2) + dx_world - (lw / 2), bh + dy_world - (lh / 2), lw, lh };
-
-        SDL_SetTextureBlendMode(light.texture, SDL_BLENDMODE_ADD);
-        SDL_SetTextureAlphaMod(light.texture, alpha);
-        SDL_RenderCopy(renderer_, light.texture, nullptr, &dst);
+        push_stamp(light.texture, bounds,
+                   static_cast<int>(std::lround(lx)) - a->pos.x,
+                   static_cast<int>(std::lround(ly)) - a->pos.y, lw, lh, static_cast<float>(alpha));
     }
 }
 
-void RenderAsset::render_shadow_received_static_lights(Asset* a, const SDL_Rect& bounds, Uint8 alpha) {
+void RenderAsset::stamp_received_static_lights(Asset* a, const SDL_Rect& bounds, Uint8 alpha) {
     if (!a) return;
     static std::mt19937 flicker_rng{ std::random_device{}() };
     for (const auto& sl : a->static_lights) {
         if (!sl.source || !sl.source->texture) continue;
 
-        const int dx_world = sl.offset.x;
-        const int dy_world = sl.offset.y;
-
         int lw = sl.source->cached_w, lh = sl.source->cached_h;
         if (lw == 0 || lh == 0) {
             SDL_QueryTexture(sl.source->texture, nullptr, nullptr, &lw, &lh);
@@ -370,12 +369,6 @@ void RenderAsset::render_shadow_received_static_lights(Asset* a, const SDL_Rect&
             sl.source->cached_h = lh;
         }
 
-        const int bw = bounds.w;
-        const int bh = bounds.h;
-        SDL_Rect dst{
-            (bw / 2) + dx_world - (lw / 2), bh + dy_world - (lh / 2), lw, lh };
-
-        SDL_SetTextureBlendMode(sl.source->texture, SDL_BLENDMODE_ADD);
         float base_alpha = static_cast<float>(alpha) * sl.alpha_percentage;
         if (sl.source->flicker > 0) {
             const float brightness_scale = std::clamp(sl.source->intensity / 255.0f, 0.0f, 1.0f);
@@ -383,7 +376,9 @@ void RenderAsset::render_shadow_received_static_lights(Asset* a, const SDL_Rect&
             std::uniform_real_distribution<float> dist(-max_jitter, max_jitter);
             base_alpha *= (1.0f + dist(flicker_rng));
         }
-        SDL_SetTextureAlphaMod(sl.source->texture, static_cast<Uint8>(std::clamp(base_alpha, 0.0f, 255.0f)));
-        SDL_RenderCopy(renderer_, sl.source->texture, nullptr, &dst);
+        if (push_stamp(sl.source->texture, bounds, sl.offset.x, sl.offset.y, lw, lh, base_alpha) &&
+            sl.source->flicker > 0) {
+            volatile_stamps_ = true;
+        }
     }
 }
@@ -2,29 +2,56 @@
 
 #include <SDL.h>
 #include <string>
+#include <utility>
+#include <vector>
 #include "render/camera.hpp"
+#include "render/composite_cache.hpp"
 
 class Asset;
 class Global_Light_Source;
+struct AtlasFrame;
 class Assets;
 
 class RenderAsset {
 
         public:
     RenderAsset(SDL_Renderer* renderer, Assets* assets, camera& cam, Global_Light_Source& main_light, Asset* player);
-    SDL_Texture* regenerateFinalTexture(Asset* a);
-    SDL_Texture* texture_for_scale(Asset* asset, SDL_Texture* base_tex, int base_w, int base_h, int target_w, int target_h, float camera_scale);
+    ~RenderAsset();
+    // Points a's final texture at the composite for its current frame and
+    // lighting, building it only when no asset has that composite yet.
+    // Composites lit by flickering or moving lights are private to the asset
+    // and kept out of the shared cache.
+    SDL_Texture* refresh_final_texture(Asset* a);
+    // Composite or one of its shared half-scale levels, whichever best fits target_w x target_h.
+    SDL_Texture* texture_for_scale(Asset* asset, int target_w, int target_h, float camera_scale);
+    void end_frame();
 
 	private:
+    // One additive light blit into the shadow mask, in composite pixels.
+    struct LightStamp {
+        SDL_Texture* texture = nullptr;
+        SDL_Rect     dst{0, 0, 0, 0};
+        Uint8        alpha = 0;
+    };
+
     Asset* p;
-    SDL_Texture* render_shadow_mask(Asset* a, int bw, int bh);
-    void render_shadow_moving_lights(Asset* a, const SDL_Rect& bounds, Uint8 alpha);
-    void render_shadow_orbital_lights(Asset* a, const SDL_Rect& bounds, Uint8 alpha);
-    void render_shadow_received_static_lights(Asset* a, const SDL_Rect& bounds, Uint8 alpha);
+    void gather_light_stamps(Asset* a, int bw, int bh);
+    void stamp_moving_lights(Asset* a, const SDL_Rect& bounds, Uint8 alpha);
+    void stamp_orbital_lights(Asset* a, const SDL_Rect& bounds, Uint8 alpha);
+    void stamp_received_static_lights(Asset* a, const SDL_Rect& bounds, Uint8 alpha);
+    // Returns false when the light misses the composite or is fully transparent.
+    bool push_stamp(SDL_Texture* tex, const SDL_Rect& bounds, int dx_world, int dy_world, int lw, int lh, float alpha);
+    SDL_Texture* compose(const AtlasFrame& base, int bw, int bh, bool shaded, bool nearest);
+    void render_shadow_mask(SDL_Texture* mask, const AtlasFrame& base);
 
 	private:
     SDL_Renderer* renderer_;
     Assets* assets_ = nullptr;
     camera& cam_;
     Global_Light_Source& main_light_source_;
+    CompositeCache composites_;
+    CompositeCache::Key key_;
+    std::vector<LightStamp> stamps_;
+    // Set while gathering when a stamp is expected to change next frame.
+    bool volatile_stamps_ = false;
 };
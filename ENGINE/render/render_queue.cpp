@@ -0,0 +1,135 @@
+#include "render_queue.hpp"
+#include "utils/frame_profiler.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <iostream>
+
+namespace {
+bool same_batch(const RenderQueue::DrawCommand& a, const RenderQueue::DrawCommand& b) {
+    return a.texture == b.texture && a.blend == b.blend;
+}
+}
+
+void RenderQueue::clear() {
+    commands_.clear();
+}
+
+void RenderQueue::push(const DrawCommand& cmd) {
+    if (!cmd.texture || cmd.dst.w <= 0 || cmd.dst.h <= 0) return;
+    commands_.push_back(cmd);
+}
+
+// Only equal-band neighbours may trade places: anything across a band
+// boundary keeps painter's order.
+void RenderQueue::sort_bands() {
+    auto by_texture = [](const DrawCommand& a, const DrawCommand& b) {
+        return std::less<SDL_Texture*>{}(a.texture, b.texture);
+};
+    std::size_t begin = 0;
+    while (begin < commands_.size()) {
+        std::size_t end = begin + 1;
+        while (end < commands_.size() && commands_[end].band == commands_[begin].band) {
+            ++end;
+        }
+        if (end - begin > 2) {
+            std::stable_sort(commands_.begin() + static_cast<std::ptrdiff_t>(begin),
+                             commands_.begin() + static_cast<std::ptrdiff_t>(end), by_texture);
+        }
+        begin = end;
+    }
+}
+
+void RenderQueue::flush(SDL_Renderer* renderer) {
+    PROFILE_SCOPE("RenderQueue::flush");
+    stats_ = Stats{};
+    stats_.commands = commands_.size();
+    if (!renderer || commands_.empty()) {
+        commands_.clear();
+        return;
+    }
+
+    sort_bands();
+
+    std::size_t begin = 0;
+    while (begin < commands_.size()) {
+        std::size_t end = begin + 1;
+        while (end < commands_.size() && same_batch(commands_[begin], commands_[end])) {
+            ++end;
+        }
+        submit_batch(renderer, begin, end);
+        begin = end;
+    }
+    commands_.clear();
+}
+
+void RenderQueue::submit_batch(SDL_Renderer* renderer, std::size_t begin, std::size_t end) {
+#if SDL_VERSION_ATLEAST(2,0,18)
+    if (geometry_ok_) {
+        SDL_Texture* tex = commands_[begin].texture;
+        int tex_w = 0, tex_h = 0;
+        bool sized = false;
+
+        vertices_.clear();
+        indices_.clear();
+        for (std::size_t i = begin; i < end; ++i) {
+            const DrawCommand& c = commands_[i];
+            float u0 = 0.0f, v0 = 0.0f, u1 = 1.0f, v1 = 1.0f;
+            if (c.src.w > 0 && c.src.h > 0) {
+                if (!sized) {
+                    SDL_QueryTexture(tex, nullptr, nullptr, &tex_w, &tex_h);
+                    sized = true;
+                }
+                if (tex_w > 0 && tex_h > 0) {
+                    u0 = static_cast<float>(c.src.x) / tex_w;
+                    v0 = static_cast<float>(c.src.y) / tex_h;
+                    u1 = static_cast<float>(c.src.x + c.src.w) / tex_w;
+                    v1 = static_cast<float>(c.src.y + c.src.h) / tex_h;
+                }
+            }
+            if (c.flip & SDL_FLIP_HORIZONTAL) std::swap(u0, u1);
+            if (c.flip & SDL_FLIP_VERTICAL)   std::swap(v0, v1);
+
+            const float x0 = static_cast<float>(c.dst.x);
+            const float y0 = static_cast<float>(c.dst.y);
+            const float x1 = static_cast<float>(c.dst.x + c.dst.w);
+            const float y1 = static_cast<float>(c.dst.y + c.dst.h);
+            const int base = static_cast<int>(vertices_.size());
+            vertices_.push_back(SDL_Vertex{ SDL_FPoint{x0, y0}, c.mod, SDL_FPoint{u0, v0} });
+            vertices_.push_back(SDL_Vertex{ SDL_FPoint{x1, y0}, c.mod, SDL_FPoint{u1, v0} });
+            vertices_.push_back(SDL_Vertex{ SDL_FPoint{x1, y1}, c.mod, SDL_FPoint{u1, v1} });
+            vertices_.push_back(SDL_Vertex{ SDL_FPoint{x0, y1}, c.mod, SDL_FPoint{u0, v1} });
+            indices_.insert(indices_.end(), { base, base + 1, base + 2, base, base + 2, base + 3 });
+        }
+
+        // Vertex colours multiply with the texture mods, so those stay neutral.
+        SDL_SetTextureBlendMode(tex, commands_[begin].blend);
+        SDL_SetTextureColorMod(tex, 255, 255, 255);
+        SDL_SetTextureAlphaMod(tex, 255);
+        if (SDL_RenderGeometry(renderer, tex,
+                               vertices_.data(), static_cast<int>(vertices_.size()),
+                               indices_.data(), static_cast<int>(indices_.size())) == 0) {
+            ++stats_.calls;
+            return;
+        }
+        std::cerr << "[RenderQueue] SDL_RenderGeometry failed, using per-copy path: " << SDL_GetError() << "\n";
+        geometry_ok_ = false;
+    }
+#endif
+    submit_copies(renderer, begin, end);
+}
+
+void RenderQueue::submit_copies(SDL_Renderer* renderer, std::size_t begin, std::size_t end) {
+    SDL_Texture* tex = commands_[begin].texture;
+    SDL_SetTextureBlendMode(tex, commands_[begin].blend);
+    for (std::size_t i = begin; i < end; ++i) {
+        const DrawCommand& c = commands_[i];
+        SDL_SetTextureColorMod(tex, c.mod.r, c.mod.g, c.mod.b);
+        SDL_SetTextureAlphaMod(tex, c.mod.a);
+        const SDL_Rect* src = (c.src.w > 0 && c.src.h > 0) ? &c.src : nullptr;
+        SDL_RenderCopyEx(renderer, tex, src, &c.dst, 0, nullptr, c.flip);
+        ++stats_.calls;
+    }
+    SDL_SetTextureColorMod(tex, 255, 255, 255);
+    SDL_SetTextureAlphaMod(tex, 255);
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <SDL.h>
+#include <cstddef>
+#include <vector>
+
+// Collects the sprite copies of one frame and submits them in as few render
+// calls as possible. Commands keep their push order except inside a band
+// (consecutive commands with the same band value, i.e. the same z), where they
+// are grouped by texture. Runs that share a texture and blend mode go out as a
+// single SDL_RenderGeometry call with the colour/alpha mod baked into the
+// vertex colours, so no per-copy texture state is touched. Without
+// SDL_RenderGeometry (SDL < 2.0.18, or a renderer that rejects it) every
+// command falls back to SDL_RenderCopyEx with texture mods.
+class RenderQueue {
+public:
+    struct DrawCommand {
+        SDL_Texture*     texture  = nullptr;
+        SDL_Rect         src{0, 0, 0, 0};          // w/h == 0 means the whole texture
+        SDL_Rect         dst{0, 0, 0, 0};
+        SDL_RendererFlip flip     = SDL_FLIP_NONE;
+        SDL_Color        mod{255, 255, 255, 255};
+        SDL_BlendMode    blend    = SDL_BLENDMODE_BLEND;
+        int              band     = 0;
+    };
+
+    struct Stats {
+        std::size_t commands = 0;
+        std::size_t calls    = 0;   // draw calls actually issued
+    };
+
+    void clear();
+    void push(const DrawCommand& cmd);
+    bool empty() const { return commands_.empty(); }
+
+    // Sorts, batches and draws everything queued onto the current render
+    // target, then clears the queue.
+    void flush(SDL_Renderer* renderer);
+
+    const Stats& last_stats() const { return stats_; }
+
+private:
+    void sort_bands();
+    void submit_batch(SDL_Renderer* renderer, std::size_t begin, std::size_t end);
+    void submit_copies(SDL_Renderer* renderer, std::size_t begin, std::size_t end);
+
+    std::vector<DrawCommand> commands_;
+#if SDL_VERSION_ATLEAST(2,0,18)
+    std::vector<SDL_Vertex>  vertices_;
+    std::vector<int>         indices_;
+#endif
+    Stats stats_;
+    bool  geometry_ok_ = true;
+};
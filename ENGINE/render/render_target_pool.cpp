@@ -0,0 +1,126 @@
+#include "render_target_pool.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <iostream>
+
+RenderTargetPool& RenderTargetPool::instance() {
+    static RenderTargetPool pool;
+    return pool;
+}
+
+std::size_t RenderTargetPool::KeyHash::operator()(const Key& k) const {
+    std::size_t h = std::hash<const void*>{}(k.renderer);
+    auto mix = [&h](std::size_t v) { h ^= v + 0x9e3779b97f4a7c15ull + (h << 6) + (h >> 2); };
+    mix(static_cast<std::size_t>(k.w));
+    mix(static_cast<std::size_t>(k.h));
+    mix(static_cast<std::size_t>(k.format));
+    mix(static_cast<std::size_t>(k.access));
+    return h;
+}
+
+std::size_t RenderTargetPool::texture_bytes(const Key& key) {
+    std::size_t bpp = SDL_BYTESPERPIXEL(key.format);
+    if (bpp == 0) bpp = 4;
+    return static_cast<std::size_t>(key.w) * static_cast<std::size_t>(key.h) * bpp;
+}
+
+SDL_Texture* RenderTargetPool::acquire(SDL_Renderer* renderer, int w, int h, Uint32 format, int access) {
+    if (!renderer || w <= 0 || h <= 0) return nullptr;
+    const Key key{ renderer, w, h, format, access };
+
+    auto bucket = buckets_.find(key);
+    if (bucket != buckets_.end() && !bucket->second.empty()) {
+        IdleList::iterator it = bucket->second.back();
+        bucket->second.pop_back();
+        SDL_Texture* tex = *it;
+        lru_.erase(it);
+        Owned& o = owned_[tex];
+        o.idle = false;
+        stats_.idle_textures -= 1;
+        stats_.idle_bytes    -= o.bytes;
+        stats_.live_textures += 1;
+        stats_.live_bytes    += o.bytes;
+        ++stats_.hits;
+        SDL_SetTextureBlendMode(tex, SDL_BLENDMODE_BLEND);
+        SDL_SetTextureColorMod(tex, 255, 255, 255);
+        SDL_SetTextureAlphaMod(tex, 255);
+        return tex;
+    }
+
+    SDL_Texture* tex = SDL_CreateTexture(renderer, format, access, w, h);
+    if (!tex) {
+        std::cerr << "[RenderTargetPool] Failed to create " << w << "x" << h << " texture: " << SDL_GetError() << "\n";
+        return nullptr;
+    }
+    SDL_SetTextureBlendMode(tex, SDL_BLENDMODE_BLEND);
+    Owned o;
+    o.key   = key;
+    o.bytes = texture_bytes(key);
+    owned_[tex] = o;
+    stats_.live_textures += 1;
+    stats_.live_bytes    += o.bytes;
+    ++stats_.misses;
+    return tex;
+}
+
+void RenderTargetPool::release(SDL_Texture* tex) {
+    if (!tex) return;
+    auto it = owned_.find(tex);
+    if (it == owned_.end()) {
+        SDL_DestroyTexture(tex);
+        return;
+    }
+    Owned& o = it->second;
+    if (o.idle) {
+        std::cerr << "[RenderTargetPool] Texture released twice\n";
+        return;
+    }
+    o.idle = true;
+    stats_.live_textures -= 1;
+    stats_.live_bytes    -= o.bytes;
+    stats_.idle_textures += 1;
+    stats_.idle_bytes    += o.bytes;
+    buckets_[o.key].push_back(lru_.insert(lru_.end(), tex));
+    enforce_budget();
+}
+
+void RenderTargetPool::set_budget_bytes(std::size_t bytes) {
+    budget_bytes_ = bytes;
+    enforce_budget();
+}
+
+void RenderTargetPool::destroy_idle(IdleList::iterator it) {
+    SDL_Texture* tex = *it;
+    auto owned = owned_.find(tex);
+    if (owned != owned_.end()) {
+        auto bucket = buckets_.find(owned->second.key);
+        if (bucket != buckets_.end()) {
+            auto& v = bucket->second;
+            v.erase(std::remove(v.begin(), v.end(), it), v.end());
+            if (v.empty()) buckets_.erase(bucket);
+        }
+        stats_.idle_textures -= 1;
+        stats_.idle_bytes    -= owned->second.bytes;
+        owned_.erase(owned);
+    }
+    lru_.erase(it);
+    SDL_DestroyTexture(tex);
+}
+
+void RenderTargetPool::enforce_budget() {
+    while (stats_.idle_bytes > budget_bytes_ && !lru_.empty()) {
+        destroy_idle(lru_.begin());
+        ++stats_.evictions;
+    }
+}
+
+void RenderTargetPool::clear() {
+    while (!lru_.empty()) {
+        destroy_idle(lru_.begin());
+    }
+    buckets_.clear();
+    owned_.clear();
+    stats_.live_textures = 0;
+    stats_.live_bytes    = 0;
+}
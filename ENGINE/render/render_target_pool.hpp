@@ -0,0 +1,81 @@
+#pragma once
+
+#include <SDL.h>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+// Reuses transient render-target textures instead of creating and destroying
+// them on hot paths. Textures are bucketed by exact (renderer, w, h, format,
+// access); acquire() hands back the most recently released texture of a bucket
+// (contents undefined, blend BLEND and neutral colour/alpha mods) or creates
+// one. Released textures stay idle until the idle byte budget is exceeded, at
+// which point the least recently released are destroyed.
+//
+// Render thread only. release() accepts textures the pool did not create and
+// simply destroys them, so call sites can switch over one side at a time.
+class RenderTargetPool {
+public:
+    struct Stats {
+        std::size_t   live_textures = 0;   // acquired and not yet released
+        std::size_t   live_bytes    = 0;
+        std::size_t   idle_textures = 0;
+        std::size_t   idle_bytes    = 0;
+        std::uint64_t hits          = 0;
+        std::uint64_t misses        = 0;
+        std::uint64_t evictions     = 0;
+    };
+
+    static constexpr std::size_t kDefaultBudgetBytes = 64u * 1024u * 1024u;
+
+    static RenderTargetPool& instance();
+
+    SDL_Texture* acquire(SDL_Renderer* renderer, int w, int h,
+                         Uint32 format = SDL_PIXELFORMAT_RGBA8888,
+                         int access = SDL_TEXTUREACCESS_TARGET);
+    void release(SDL_Texture* tex);
+
+    void set_budget_bytes(std::size_t bytes);
+    std::size_t budget_bytes() const { return budget_bytes_; }
+
+    // Destroys every idle texture and forgets live ones (their later release
+    // destroys them directly). Call before the renderer is destroyed.
+    void clear();
+
+    const Stats& stats() const { return stats_; }
+
+private:
+    RenderTargetPool() = default;
+
+    struct Key {
+        SDL_Renderer* renderer = nullptr;
+        int    w      = 0;
+        int    h      = 0;
+        Uint32 format = 0;
+        int    access = 0;
+        bool operator==(const Key& o) const {
+            return renderer == o.renderer && w == o.w && h == o.h && format == o.format && access == o.access;
+        }
+    };
+    struct KeyHash {
+        std::size_t operator()(const Key& k) const;
+    };
+    struct Owned {
+        Key         key;
+        std::size_t bytes = 0;
+        bool        idle  = false;
+    };
+    using IdleList = std::list<SDL_Texture*>;
+
+    static std::size_t texture_bytes(const Key& key);
+    void destroy_idle(IdleList::iterator it);
+    void enforce_budget();
+
+    std::unordered_map<SDL_Texture*, Owned> owned_;
+    std::unordered_map<Key, std::vector<IdleList::iterator>, KeyHash> buckets_;
+    IdleList lru_;   // idle textures, least recently released first
+    std::size_t budget_bytes_ = kDefaultBudgetBytes;
+    Stats stats_;
+};
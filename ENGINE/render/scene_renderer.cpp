@@ -3,6 +3,7 @@
 #include "asset/Asset.hpp"
 #include "light_map.hpp"
 #include "render/camera.hpp"
+#include "utils/frame_profiler.hpp"
 #include <algorithm>
 #include <cmath>
 #include <iostream>
@@ -27,15 +28,13 @@ constexpr std::array<SDL_Point, 9> HIGHLIGHT_OFFSETS = {
 SceneRenderer::SceneRenderer(SDL_Renderer* renderer,
                              Assets* assets,
                              int screen_width,
-                             int screen_height,
-                             const std::string& map_path)
-: map_path_(map_path),
-  renderer_(renderer),
+                             int screen_height)
+: renderer_(renderer),
   assets_(assets),
   screen_width_(screen_width),
   screen_height_(screen_height),
   main_light_source_(renderer, SDL_Point{ screen_width / 2, screen_height / 2 },
-                     screen_width, SDL_Color{255, 255, 255, 255}, map_path),
+                     screen_width, SDL_Color{255, 255, 255, 255}, assets->map_info_json()),
   fullscreen_light_tex_(nullptr),
   render_asset_(renderer, assets, assets->getView(), main_light_source_, assets->player)
 {
@@ -106,6 +105,10 @@ bool SceneRenderer::shouldRegen(Asset* a) {
 	        a->get_shading_group() == current_shading_group_) || (!a->get_final_texture() || !a->static_frame || a->get_render_player_light());
 }
 
+void SceneRenderer::step() {
+        main_light_source_.update();
+}
+
 SDL_Rect SceneRenderer::get_scaled_position_rect(Asset* a,
                                                  int fw,
                                                  int fh,
@@ -117,7 +120,7 @@ SDL_Rect SceneRenderer::get_scaled_position_rect(Asset* a,
         float base_sh = static_cast<float>(fh) * inv_scale;
 
         const camera::RenderEffects effects = assets_->getView().compute_render_effects(
-            SDL_Point{a->pos.x, a->pos.y}, base_sh, reference_screen_height);
+            assets_->render_pos(a), base_sh, reference_screen_height);
 
         float scaled_sw = base_sw * effects.distance_scale;
         float scaled_sh = base_sh * effects.distance_scale;
@@ -140,11 +143,11 @@ SDL_Rect SceneRenderer::get_scaled_position_rect(Asset* a,
         return SDL_Rect{ cp.x - sw / 2, cp.y - sh, sw, sh };
 }
 void SceneRenderer::render() {
+    PROFILE_SCOPE("SceneRenderer::render");
     static int render_call_count = 0;
     ++render_call_count;
 
     update_shading_groups();
-    main_light_source_.update();
 
     auto ensure_target = [&](SDL_Texture*& tex, int w, int h) {
         if (low_quality_mode_) {
@@ -190,10 +193,10 @@ void SceneRenderer::render() {
     Asset* player_asset = assets_ ? assets_->player : nullptr;
     if (player_asset) {
         SDL_Texture* player_final = player_asset->get_final_texture();
-        SDL_Texture* player_frame = player_asset->get_current_frame();
+        const AtlasFrame* player_frame = player_asset->get_current_frame();
         int pw = player_asset->cached_w, ph = player_asset->cached_h;
         if ((pw == 0 || ph == 0) && player_final) SDL_QueryTexture(player_final, nullptr, nullptr, &pw, &ph);
-        if ((pw == 0 || ph == 0) && player_frame) SDL_QueryTexture(player_frame, nullptr, nullptr, &pw, &ph);
+        if ((pw == 0 || ph == 0) && player_frame) { pw = player_frame->width(); ph = player_frame->height(); }
         if (pw != 0) player_asset->cached_w = pw;
         if (ph != 0) player_asset->cached_h = ph;
         if (ph > 0) player_screen_height = static_cast<float>(ph) * inv_scale;
@@ -203,19 +206,16 @@ void SceneRenderer::render() {
     const auto& active_assets = assets_->getActive();
     const float highlight_pulse = 0.45f + 0.55f * std::sin(render_call_count * 0.18f);
 
+    // Regeneration switches render targets, so all of it happens while the
+    // copies are only being queued; the queue then draws the scene in one go.
+    render_queue_.clear();
     for (Asset* a : active_assets) {
         if (!a || !a->info) continue;
 
-        SDL_Texture* final_tex = a->get_final_texture();
-        if (shouldRegen(a)) {
-            SDL_Texture* previous_final = final_tex;
-            final_tex = render_asset_.regenerateFinalTexture(a);
-            if (!final_tex) {
-                final_tex = previous_final;
-            } else if (final_tex != previous_final) {
-                a->set_final_texture(final_tex);
-            }
-        }
+        // Cheap when nothing changed: the composite key still matches and no
+        // drawing happens. Otherwise the asset picks up a shared composite.
+        SDL_Texture* final_tex = shouldRegen(a) ? render_asset_.refresh_final_texture(a)
+                                                : a->get_final_texture();
         if (!final_tex) continue;
 
         int fw = a->cached_w, fh = a->cached_h;
@@ -227,21 +227,17 @@ void SceneRenderer::render() {
         SDL_Rect fb = get_scaled_position_rect(a, fw, fh, inv_scale, min_visible_w, min_visible_h, player_screen_height);
         if (fb.w == 0 && fb.h == 0) continue;
 
-        SDL_Texture* draw_tex = render_asset_.texture_for_scale(a, final_tex, fw, fh, fb.w, fb.h, scale);
-        SDL_Texture* mod_target = draw_tex ? draw_tex : final_tex;
+        SDL_Texture* draw_tex = render_asset_.texture_for_scale(a, fb.w, fb.h, scale);
 
         const bool is_highlighted = a->is_highlighted();
         const bool is_selected   = a->is_selected();
-        const SDL_RendererFlip flip_mode = a->flipped ? SDL_FLIP_HORIZONTAL : SDL_FLIP_NONE;
 
-        if (is_highlighted || is_selected) {
-            SDL_BlendMode previous_blend_mode = SDL_BLENDMODE_BLEND;
-            SDL_GetTextureBlendMode(mod_target, &previous_blend_mode);
-
-            Uint8 prev_r = 255, prev_g = 255, prev_b = 255, prev_a = 255;
-            SDL_GetTextureColorMod(mod_target, &prev_r, &prev_g, &prev_b);
-            SDL_GetTextureAlphaMod(mod_target, &prev_a);
+        RenderQueue::DrawCommand cmd;
+        cmd.texture = draw_tex ? draw_tex : final_tex;
+        cmd.flip    = a->flipped ? SDL_FLIP_HORIZONTAL : SDL_FLIP_NONE;
+        cmd.band    = a->z_index;
 
+        if (is_highlighted || is_selected) {
             SDL_Rect glow_rect = fb;
             const int min_dimension = std::max(1, std::min(fb.w, fb.h));
             const int glow_margin = std::max( 8, static_cast<int>(std::round(min_dimension * 0.2f)));
@@ -250,14 +246,14 @@ void SceneRenderer::render() {
             glow_rect.w += glow_margin * 2;
             glow_rect.h += glow_margin * 2;
 
-            auto apply_tinted_copy = [&](const SDL_Color& color, SDL_Rect rect) {
-                SDL_SetTextureColorMod(mod_target, color.r, color.g, color.b);
-                SDL_SetTextureAlphaMod(mod_target, color.a);
-                SDL_RenderCopyEx(renderer_, mod_target, nullptr, &rect, 0, nullptr, flip_mode);
+            auto queue_tinted_copy = [&](const SDL_Color& color, SDL_BlendMode blend, SDL_Rect rect) {
+                RenderQueue::DrawCommand tinted = cmd;
+                tinted.mod   = color;
+                tinted.blend = blend;
+                tinted.dst   = rect;
+                render_queue_.push(tinted);
 };
 
-            SDL_SetTextureBlendMode(mod_target, SDL_BLENDMODE_ADD);
-
             const Uint8 base_alpha = static_cast<Uint8>(std::clamp(160.f + 70.f * highlight_pulse, 0.f, 255.f));
             SDL_Color outer_color = is_highlighted
                                         ? SDL_Color{90, 220, 255, base_alpha}
@@ -272,33 +268,23 @@ void SceneRenderer::render() {
                 SDL_Rect rect = glow_rect;
                 rect.x += pt.x * offset;
                 rect.y += pt.y * offset;
-                apply_tinted_copy(outer_color, rect);
+                queue_tinted_copy(outer_color, SDL_BLENDMODE_ADD, rect);
             }
 
             if (is_selected) {
-                SDL_SetTextureBlendMode(mod_target, SDL_BLENDMODE_BLEND);
                 Uint8 inner_alpha = static_cast<Uint8>(std::clamp(150.f + 80.f * highlight_pulse, 0.f, 255.f));
                 SDL_Color inner_color = is_highlighted
                                             ? SDL_Color{255, 245, 200, inner_alpha}
                                             : SDL_Color{255, 215, 120, inner_alpha};
-                apply_tinted_copy(inner_color, fb);
+                queue_tinted_copy(inner_color, SDL_BLENDMODE_BLEND, fb);
             }
-
-            SDL_SetTextureColorMod(mod_target, prev_r, prev_g, prev_b);
-            SDL_SetTextureAlphaMod(mod_target, prev_a);
-            SDL_SetTextureBlendMode(mod_target, previous_blend_mode);
-        } else {
-            SDL_SetTextureColorMod(mod_target, 255, 255, 255);
         }
 
-        SDL_RenderCopyEx(renderer_, mod_target, nullptr, &fb, 0, nullptr, flip_mode);
-        SDL_SetTextureColorMod(mod_target, 255, 255, 255);
-        SDL_SetTextureAlphaMod(mod_target, 255);
-        if (draw_tex && draw_tex != final_tex) {
-            SDL_SetTextureColorMod(final_tex, 255, 255, 255);
-            SDL_SetTextureAlphaMod(final_tex, 255);
-        }
+        cmd.dst = fb;
+        render_queue_.push(cmd);
     }
+    render_queue_.flush(renderer_);
+    render_asset_.end_frame();
 
     SDL_SetRenderTarget(renderer_, scene_target_tex_);
     if (!low_quality_mode_ && z_light_pass_) {
@@ -8,6 +8,7 @@
 #include "light_map.hpp"
 #include "global_light_source.hpp"
 #include "render_asset.hpp"
+#include "render_queue.hpp"
 #include "render/camera.hpp"
 
 class Assets;
@@ -16,9 +17,11 @@ class Asset;
 class SceneRenderer {
 
 	public:
-    SceneRenderer(SDL_Renderer* renderer, Assets* assets, int screen_width, int screen_height, const std::string& map_path);
+    SceneRenderer(SDL_Renderer* renderer, Assets* assets, int screen_width, int screen_height);
     ~SceneRenderer();
     void render();
+    // Advances the day/night light by one simulation tick.
+    void step();
     void apply_map_light_config(const nlohmann::json& data);
     SDL_Renderer* get_renderer() const;
     void set_low_quality_rendering(bool low_quality);
@@ -28,7 +31,6 @@ class SceneRenderer {
     bool shouldRegen(Asset* a);
     SDL_Rect get_scaled_position_rect(Asset* a, int fw, int fh, float inv_scale, int min_w, int min_h, float reference_screen_height);
 
-    std::string    map_path_;
     SDL_Renderer*  renderer_;
     Assets*        assets_;
     int            screen_width_;
@@ -36,6 +38,7 @@ class SceneRenderer {
     Global_Light_Source main_light_source_;
     SDL_Texture*   fullscreen_light_tex_;
     RenderAsset    render_asset_;
+    RenderQueue    render_queue_;
     std::unique_ptr<LightMap> z_light_pass_;
     int            current_shading_group_ = 0;
     int            num_groups_ = 20;
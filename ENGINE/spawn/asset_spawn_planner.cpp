@@ -13,8 +13,10 @@ namespace fs = std::filesystem;
 AssetSpawnPlanner::AssetSpawnPlanner(const std::vector<nlohmann::json>& json_sources,
                                      const Area& area,
                                      AssetLibrary& asset_library,
-                                     const std::vector<std::string>& source_paths)
-: asset_library_(&asset_library) {
+                                     const std::vector<std::string>& source_paths,
+                                     std::uint32_t seed)
+: asset_library_(&asset_library),
+rng_(seed) {
     source_jsons_ = json_sources;
     source_paths_ = source_paths;
     if (source_paths_.size() < source_jsons_.size()) {
@@ -50,7 +52,6 @@ const std::vector<SpawnInfo>& AssetSpawnPlanner::get_spawn_queue() const {
 }
 
 void AssetSpawnPlanner::parse_asset_spawns(const Area& area) {
-    std::mt19937 rng(std::random_device{}());
     if (!root_json_.contains("spawn_groups") || !root_json_["spawn_groups"].is_array()) return;
 
     auto get_opt_str = [](const nlohmann::json& j, const char* k) -> std::string {
@@ -91,7 +92,7 @@ void AssetSpawnPlanner::parse_asset_spawns(const Area& area) {
         if (min_num < 0) min_num = 0;
         if (max_num < 0) max_num = 0;
         if (max_num < min_num) std::swap(max_num, min_num);
-        int quantity = std::uniform_int_distribution<int>(min_num, max_num)(rng);
+        int quantity = std::uniform_int_distribution<int>(min_num, max_num)(rng_);
 
         const bool need_orig = (position == "Exact" || position == "Perimeter");
         if (need_orig) {
@@ -399,7 +400,6 @@ std::string AssetSpawnPlanner::resolve_asset_from_tag(
     const std::unordered_set<std::string>* banned_assets,
     const std::unordered_set<std::string>* candidate_tags)
 {
-    static std::mt19937 rng(std::random_device{}());
     if (tag.empty()) {
         throw std::runtime_error("Empty tag provided to resolve_asset_from_tag");
     }
@@ -442,5 +442,5 @@ std::string AssetSpawnPlanner::resolve_asset_from_tag(
     }
 
     std::uniform_int_distribution<size_t> dist(0, matches.size() - 1);
-    return matches[dist(rng)];
+    return matches[dist(rng_)];
 }
@@ -5,10 +5,13 @@
 #include <string>
 #include <filesystem>
 #include <unordered_set>
+#include <random>
+#include <cstdint>
 #include <SDL.h>
 #include "asset/asset_info.hpp"
 #include "asset/asset_library.hpp"
 #include "utils/area.hpp"
+#include "utils/map_seed.hpp"
 #include "spawn_info.hpp"
 
 constexpr double REPRESENTATIVE_SPAWN_AREA = 4096.0 * 4096.0;
@@ -19,7 +22,8 @@ class AssetSpawnPlanner {
     AssetSpawnPlanner(const std::vector<nlohmann::json>& json_sources,
                       const Area& area,
                       AssetLibrary& asset_library,
-                      const std::vector<std::string>& source_paths = {});
+                      const std::vector<std::string>& source_paths = {},
+                      std::uint32_t seed = map_seed::random());
     const std::vector<SpawnInfo>& get_spawn_queue() const;
 
         private:
@@ -39,5 +43,6 @@ class AssetSpawnPlanner {
     std::vector<SourceRef> assets_provenance_;
     std::vector<bool> source_changed_;
     AssetLibrary* asset_library_;
+    std::mt19937 rng_;
     std::vector<SpawnInfo> spawn_queue_;
 };
\ No newline at end of file
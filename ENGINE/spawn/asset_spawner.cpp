@@ -20,22 +20,25 @@
 namespace fs = std::filesystem;
 
 AssetSpawner::AssetSpawner(AssetLibrary* asset_library,
-                           std::vector<Area> exclusion_zones)
+                           std::vector<Area> exclusion_zones,
+                           std::uint32_t seed)
 : asset_library_(asset_library),
 exclusion_zones(std::move(exclusion_zones)),
-rng_(std::random_device{}()),
+rng_(seed),
 checker_(false),
 logger_("", "") {}
 
-void AssetSpawner::spawn(Room& room) {
+void AssetSpawner::spawn(Room& room, bool buffer_log) {
 	if (!room.planner) {
 		std::cerr << "[AssetSpawner] Room planner is null — skipping room: " << room.room_name << "\n";
 		return;
 	}
 	const Area& spawn_area = *room.room_area;
 	logger_ = SpawnLogger(room.map_path, room.room_directory);
+	logger_.set_buffered(buffer_log);
 	run_spawning(room.planner.get(), spawn_area);
 	room.add_room_assets(std::move(all_));
+	if (buffer_log) room.spawn_log = logger_.take_records();
 }
 
 std::vector<std::unique_ptr<Asset>> AssetSpawner::spawn_boundary_from_json(const nlohmann::json& boundary_json,
@@ -49,7 +52,7 @@ std::vector<std::unique_ptr<Asset>> AssetSpawner::spawn_boundary_from_json(const
         if (!source_name.empty()) {
                 source_paths.push_back(source_name);
         }
-        AssetSpawnPlanner planner(json_sources, spawn_area, *asset_library_, source_paths);
+        AssetSpawnPlanner planner(json_sources, spawn_area, *asset_library_, source_paths, static_cast<std::uint32_t>(rng_()));
 	logger_ = SpawnLogger("", "");
         boundary_mode_ = true;
         run_spawning(&planner, spawn_area);
@@ -144,7 +147,7 @@ void AssetSpawner::run_spawning(AssetSpawnPlanner* planner, const Area& area) {
                                                 placed = true;
                                                 break;
                                         }
-                                        if (ctx.checker().check(candidate.info, spawn_pos, ctx.exclusion_zones(), ctx.all_assets(), true, true, true, 5)) {
+                                        if (ctx.checker().check(candidate.info, spawn_pos, ctx.exclusion_zones(), ctx.spawn_index(), true, true, true, 5)) {
                                                 attempt_weights[idx] = 0;
                                                 continue;
                                         }
@@ -254,7 +257,7 @@ void AssetSpawner::run_boundary_spawning(const Area& area) {
                                         break;
                                 }
 
-                                if (ctx.checker().check(candidate.info, spawn_pos, ctx.exclusion_zones(), ctx.all_assets(), true, true, true, 5)) {
+                                if (ctx.checker().check(candidate.info, spawn_pos, ctx.exclusion_zones(), ctx.spawn_index(), true, true, true, 5)) {
                                         attempt_weights[idx] = 0;
                                         continue;
                                 }
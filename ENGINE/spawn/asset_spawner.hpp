@@ -4,6 +4,7 @@
 #include <string>
 #include <memory>
 #include <random>
+#include <cstdint>
 #include <unordered_map>
 #include <nlohmann/json.hpp>
 #include "utils/area.hpp"
@@ -20,8 +21,10 @@ class AssetSpawner {
 
 	public:
     using Point = std::pair<int, int>;
-    AssetSpawner(AssetLibrary* asset_library, std::vector<Area> exclusion_zones);
-    void spawn(Room& room);
+    AssetSpawner(AssetLibrary* asset_library, std::vector<Area> exclusion_zones, std::uint32_t seed);
+    // With buffer_log the room's spawn_log.csv rows are left in room.spawn_log
+    // instead of being written, for callers spawning rooms in parallel.
+    void spawn(Room& room, bool buffer_log = false);
     void spawn_children(const Area& spawn_area, AssetSpawnPlanner* planner);
     std::vector<std::unique_ptr<Asset>> spawn_boundary_from_json(const nlohmann::json& boundary_json, const Area& spawn_area, const std::string& source_name);
     std::vector<std::unique_ptr<Asset>> extract_all_assets();
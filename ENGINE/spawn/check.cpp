@@ -1,10 +1,8 @@
 #include "check.hpp"
 #include <algorithm>
-#include <limits>
 #include <cmath>
 #include <iostream>
 #include <SDL.h>
-#include "utils/range_util.hpp"
 #include "asset/asset_types.hpp"
 
 Check::Check(bool debug)
@@ -18,7 +16,7 @@ void Check::setDebug(bool debug) {
 bool Check::check(const std::shared_ptr<AssetInfo>& info,
                   const SDL_Point& test_pos,
                   const std::vector<Area>& exclusion_areas,
-                  const std::vector<std::unique_ptr<Asset>>& assets,
+                  const SpawnIndex& placed,
                   bool check_spacing,
                   bool check_min_distance,
                   bool check_min_distance_all,
@@ -38,7 +36,7 @@ bool Check::check(const std::shared_ptr<AssetInfo>& info,
 		return true;
 	}
 	if (check_min_distance_all && info->min_distance_all > 0) {
-		if (this->check_min_distance_all(info, test_pos, assets)) {
+		if (this->check_min_distance_all(info, test_pos, placed)) {
 			if (debug_) std::cout << "[Check] Minimum distance (all) violated.\n";
 			return true;
 		}
@@ -47,16 +45,17 @@ bool Check::check(const std::shared_ptr<AssetInfo>& info,
                 if (debug_) std::cout << "[Check] boundary asset; skipping spacing and type distance checks.\n";
                 return false;
         }
-	auto nearest = get_closest_assets(test_pos, num_neighbors, assets);
+	std::vector<const SpawnIndex::Entry*> nearest;
+	get_closest_assets(test_pos, num_neighbors, placed, nearest);
 	if (debug_) std::cout << "[Check] Found " << nearest.size() << " nearest assets.\n";
 	if (check_spacing && info->find_area("spacing_area")) {
-		if (check_spacing_overlap(info, test_pos, nearest)) {
+		if (check_spacing_overlap(info, test_pos, placed, nearest)) {
 			if (debug_) std::cout << "[Check] Spacing overlap detected.\n";
 			return true;
 		}
 	}
 	if (check_min_distance && info->min_same_type_distance > 0) {
-		if (check_min_type_distance(info, test_pos, assets)) {
+		if (check_min_type_distance(info, test_pos, placed)) {
 			if (debug_) std::cout << "[Check] Minimum type distance violated.\n";
 			return true;
 		}
@@ -75,63 +74,36 @@ bool Check::is_in_exclusion_zone(const SDL_Point& pos, const std::vector<Area>&
 	return false;
 }
 
-std::vector<Asset*> Check::get_closest_assets(const SDL_Point& pos, int max_count,
-                                              const std::vector<std::unique_ptr<Asset>>& assets) const
+void Check::get_closest_assets(const SDL_Point& pos, int max_count,
+                               const SpawnIndex& placed,
+                               std::vector<const SpawnIndex::Entry*>& out) const
 {
-	std::vector<std::pair<double, Asset*>> pairs;
-	pairs.reserve(assets.size());
-	for (const auto& uptr : assets) {
-		Asset* a = uptr.get();
-		if (!a || !a->info) continue;
-		const double d = Range::get_distance(SDL_Point{ pos.x, pos.y }, a);
-		pairs.emplace_back(d * d, a);
-	}
-	if (pairs.size() > static_cast<size_t>(max_count)) {
-		std::nth_element(pairs.begin(),
-		pairs.begin() + max_count,
-		pairs.end(),
-		[](auto& a, auto& b) { return a.first < b.first; });
-		pairs.resize(max_count);
-	}
-	std::sort(pairs.begin(), pairs.end(),
-	[](auto& a, auto& b) { return a.first < b.first; });
-	std::vector<Asset*> closest;
-	closest.reserve(pairs.size());
-	for (auto& p : pairs) {
-		closest.push_back(p.second);
-		if (debug_) {
-			std::cout << "[Check] Closest asset: " << p.second->info->name
-			<< " at (" << p.second->pos.x << ", " << p.second->pos.y
-			<< "), dist_sq=" << p.first << "\n";
+	placed.nearest(pos, max_count, out);
+	if (debug_) {
+		for (const SpawnIndex::Entry* e : out) {
+			const double dx = static_cast<double>(e->pos.x) - pos.x;
+			const double dy = static_cast<double>(e->pos.y) - pos.y;
+			std::cout << "[Check] Closest asset: " << e->asset->info->name
+			<< " at (" << e->pos.x << ", " << e->pos.y
+			<< "), dist_sq=" << (dx * dx + dy * dy) << "\n";
 		}
 	}
-	return closest;
 }
 
 bool Check::check_spacing_overlap(const std::shared_ptr<AssetInfo>& info,
                                   const SDL_Point& test_pos,
-                                  const std::vector<Asset*>& closest_assets) const
+                                  const SpawnIndex& placed,
+                                  const std::vector<const SpawnIndex::Entry*>& closest) const
 {
-	if (!info) return false;
-	Area* spacing = info->find_area("spacing_area");
-	if (!spacing) return false;
-	Area test_area = *spacing;
-	auto [tminx, tminy, tmaxx, tmaxy] = test_area.get_bounds();
-	int th = tmaxy - tminy + 1;
-        test_area.align(SDL_Point{test_pos.x, test_pos.y - th / 2});
-	for (Asset* other : closest_assets) {
-		if (!other || !other->info) continue;
-                Area other_area("fallback", SDL_Point{other->pos.x, other->pos.y}, 1, 1, "Square", 0, std::numeric_limits<int>::max(), std::numeric_limits<int>::max());
-		Area* o_spacing = other->info->find_area("spacing_area");
-		if (o_spacing) {
-			other_area = *o_spacing;
-			auto [ominx, ominy, omaxx, omaxy] = other_area.get_bounds();
-			int oh = omaxy - ominy + 1;
-                        other_area.align(SDL_Point{other->pos.x, other->pos.y - oh / 2});
-		}
-		if (test_area.intersects(other_area)) {
+	if (!info || !info->find_area("spacing_area")) return false;
+	// Spacing areas are compared by bounding box; the index keeps each placed
+	// asset's box, so nothing is copied or aligned per neighbour.
+	const SpawnIndex::Box t = placed.spacing_box(info, test_pos);
+	for (const SpawnIndex::Entry* other : closest) {
+		const SpawnIndex::Box& o = other->spacing;
+		if (!(t.maxx < o.minx || o.maxx < t.minx || t.maxy < o.miny || o.maxy < t.miny)) {
 			if (debug_) std::cout << "[Check] Overlap found between test area and asset: "
-			<< other->info->name << "\n";
+			<< other->asset->info->name << "\n";
 			return true;
 		}
 	}
@@ -140,44 +112,34 @@ bool Check::check_spacing_overlap(const std::shared_ptr<AssetInfo>& info,
 
 bool Check::check_min_distance_all(const std::shared_ptr<AssetInfo>& info,
                                    const SDL_Point& pos,
-                                   const std::vector<std::unique_ptr<Asset>>& assets) const
+                                   const SpawnIndex& placed) const
 {
 	if (!info || info->min_distance_all <= 0)
 	return false;
-	for (const auto& uptr : assets) {
-		Asset* existing = uptr.get();
-		if (!existing || !existing->info) continue;
-		if (Range::is_in_range(existing, pos, info->min_distance_all)) {
-			if (debug_) {
-					std::cout << "[Check] Min distance (all) violated by asset: "
-					<< existing->info->name << " at ("
-					<< existing->pos.x << ", " << existing->pos.y << ")\n";
-			}
-			return true;
+	if (const SpawnIndex::Entry* existing = placed.any_within(pos, info->min_distance_all)) {
+		if (debug_) {
+				std::cout << "[Check] Min distance (all) violated by asset: "
+				<< existing->asset->info->name << " at ("
+				<< existing->pos.x << ", " << existing->pos.y << ")\n";
 		}
+		return true;
 	}
 	return false;
 }
 
 bool Check::check_min_type_distance(const std::shared_ptr<AssetInfo>& info,
                                     const SDL_Point& pos,
-                                    const std::vector<std::unique_ptr<Asset>>& assets) const
+                                    const SpawnIndex& placed) const
 {
 	if (!info || info->name.empty() || info->min_same_type_distance <= 0)
 	return false;
-	for (const auto& uptr : assets) {
-		Asset* existing = uptr.get();
-		if (!existing || !existing->info) continue;
-		if (existing->info->name != info->name)
-		continue;
-		if (Range::is_in_range(existing, pos, info->min_same_type_distance)) {
-			if (debug_) {
-					std::cout << "[Check] Min type distance violated by same-name asset: "
-					<< existing->info->name << " at ("
-					<< existing->pos.x << ", " << existing->pos.y << ")\n";
-			}
-			return true;
+	if (const SpawnIndex::Entry* existing = placed.any_within(pos, info->min_same_type_distance, info->name)) {
+		if (debug_) {
+				std::cout << "[Check] Min type distance violated by same-name asset: "
+				<< existing->asset->info->name << " at ("
+				<< existing->pos.x << ", " << existing->pos.y << ")\n";
 		}
+		return true;
 	}
 	return false;
 }
@@ -32,7 +32,7 @@ void CenterSpawner::spawn(const SpawnInfo& item, const Area* area, SpawnContext&
 
         auto& info = candidate->info;
 
-        if (ctx.checker().check(info, center, ctx.exclusion_zones(), ctx.all_assets(),
+        if (ctx.checker().check(info, center, ctx.exclusion_zones(), ctx.spawn_index(),
                                 item.check_spacing,  false,
                                  false,  5)) {
             continue;
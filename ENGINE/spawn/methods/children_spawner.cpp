@@ -30,7 +30,7 @@ void ChildrenSpawner::spawn(const SpawnInfo& item, const Area* area, SpawnContex
         bool violate = ctx.checker().check(candidate->info,
                                            pos,
                                             std::vector<Area>{},
-                                           ctx.all_assets(),
+                                           ctx.spawn_index(),
                                             false,
                                             false,
                                             false,
@@ -45,7 +45,7 @@ void ExactSpawner::spawn(const SpawnInfo& item, const Area* area, SpawnContext&
             if (snapped) pos = snapped->pos;
         }
 
-        if (ctx.checker().check(info, pos, ctx.exclusion_zones(), ctx.all_assets(),
+        if (ctx.checker().check(info, pos, ctx.exclusion_zones(), ctx.spawn_index(),
                                 item.check_spacing,  false,
                                  false,  5)) {
             continue;
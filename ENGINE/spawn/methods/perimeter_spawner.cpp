@@ -52,7 +52,7 @@ void PerimeterSpawner::spawn(const SpawnInfo& item, const Area* area, SpawnConte
 
         auto& info = candidate->info;
 
-        if (ctx.checker().check(info, pos, ctx.exclusion_zones(), ctx.all_assets(),
+        if (ctx.checker().check(info, pos, ctx.exclusion_zones(), ctx.spawn_index(),
                                 item.check_spacing,  false,
                                  false,  5)) {
             continue;
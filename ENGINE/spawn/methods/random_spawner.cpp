@@ -32,7 +32,7 @@ void RandomSpawner::spawn(const SpawnInfo& item, const Area* area, SpawnContext&
         }
 
         auto& info = candidate->info;
-        if (ctx.checker().check(info, pos, ctx.exclusion_zones(), ctx.all_assets(), true, true, true, 5)) {
+        if (ctx.checker().check(info, pos, ctx.exclusion_zones(), ctx.spawn_index(), true, true, true, 5)) {
             continue;
         }
 
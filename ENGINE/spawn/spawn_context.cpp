@@ -30,6 +30,11 @@ asset_library_(asset_library),
 grid_(grid)
 {}
 
+const SpawnIndex& SpawnContext::spawn_index() {
+        spawn_index_.sync(all_);
+        return spawn_index_;
+}
+
 SpawnContext::Point SpawnContext::get_area_center(const Area& area) const {
 	return area.get_center();
 }
@@ -54,6 +59,7 @@ Asset* SpawnContext::spawnAsset(const std::string& name,
                                 const std::string& spawn_method)
 {
         auto assetPtr = std::make_unique<Asset>(info, area, pos, depth, parent, spawn_id, spawn_method);
+        assetPtr->set_flip(rng_);
         Asset* raw = assetPtr.get();
         all_.push_back(std::move(assetPtr));
 	if (raw->info && !raw->info->children.empty()) {
@@ -65,9 +71,7 @@ Asset* SpawnContext::spawnAsset(const std::string& name,
 		std::vector<ChildInfo*> shuffled_children;
 		for (auto& c : raw->info->children)
 		shuffled_children.push_back(&c);
-		std::random_device rd;
-		std::mt19937 g(rd());
-		std::shuffle(shuffled_children.begin(), shuffled_children.end(), g);
+		std::shuffle(shuffled_children.begin(), shuffled_children.end(), rng_);
         for (auto* childInfo : shuffled_children) {
             Area* base_area = raw->info->find_area(childInfo->area_name);
             if (!base_area) {
@@ -108,8 +112,9 @@ Asset* SpawnContext::spawnAsset(const std::string& name,
             AssetSpawnPlanner childPlanner(std::vector<nlohmann::json>{ j },
                                   childArea,
                                   *asset_library_,
-                                  std::vector<std::string>{});
-            AssetSpawner childSpawner(asset_library_, exclusion_zones_);
+                                  std::vector<std::string>{},
+                                  static_cast<std::uint32_t>(rng_()));
+            AssetSpawner childSpawner(asset_library_, exclusion_zones_, static_cast<std::uint32_t>(rng_()));
             childSpawner.spawn_children(childArea, &childPlanner);
             auto kids = childSpawner.extract_all_assets();
             std::cout << "[Spawn]  Spawned " << kids.size() << " children for \"" << raw->info->name << "\"\n";
@@ -10,6 +10,7 @@
 #include "utils/area.hpp"
 #include "asset/asset_info.hpp"
 #include "spawn/check.hpp"
+#include "spawn/spawn_index.hpp"
 #include "utils/map_grid.hpp"
 
 class Asset;
@@ -41,6 +42,8 @@ class SpawnContext {
     std::vector<Area>& exclusion_zones() { return exclusion_zones_; }
     std::unordered_map<std::string, std::shared_ptr<AssetInfo>>& info_library() { return asset_info_library_; }
     std::vector<std::unique_ptr<Asset>>& all_assets() { return all_; }
+    // Buckets over all_assets() for Check, brought up to date on each call.
+    const SpawnIndex& spawn_index();
     MapGrid* grid() { return grid_; }
 
 	private:
@@ -52,4 +55,5 @@ class SpawnContext {
     std::vector<std::unique_ptr<Asset>>& all_;
     AssetLibrary* asset_library_;
     MapGrid* grid_ = nullptr;
+    SpawnIndex spawn_index_;
 };
@@ -0,0 +1,201 @@
+#include "spawn_index.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+#include "asset/Asset.hpp"
+#include "asset/asset_info.hpp"
+#include "utils/area.hpp"
+
+SpawnIndex::SpawnIndex(int cell_size)
+    : cell_size_(std::max(1, cell_size))
+{}
+
+int SpawnIndex::cell_of(int v) const {
+    return (v >= 0) ? v / cell_size_ : -((-v + cell_size_ - 1) / cell_size_);
+}
+
+SpawnIndex::CellKey SpawnIndex::key(int cx, int cy) {
+    return (static_cast<CellKey>(static_cast<std::uint32_t>(cx)) << 32) | static_cast<std::uint32_t>(cy);
+}
+
+void SpawnIndex::clear() {
+    last_synced_ = nullptr;
+    synced_count_ = 0;
+    entries_.clear();
+    all_ = Buckets{};
+    by_name_.clear();
+}
+
+void SpawnIndex::sync(const std::vector<std::unique_ptr<Asset>>& all) {
+    if (all.size() < synced_count_ ||
+        (synced_count_ > 0 && all[synced_count_ - 1].get() != last_synced_)) {
+        clear();
+    }
+    for (std::size_t i = synced_count_; i < all.size(); ++i) {
+        add(all[i].get());
+    }
+    synced_count_ = all.size();
+    last_synced_ = all.empty() ? nullptr : all.back().get();
+}
+
+SpawnIndex::Box SpawnIndex::spacing_box(const std::shared_ptr<AssetInfo>& info, SDL_Point pos) const {
+    SpacingOffsets offsets;
+    if (info) {
+        auto it = spacing_cache_.find(info.get());
+        if (it == spacing_cache_.end() || it->second.revision != info->areas_revision) {
+            SpacingOffsets computed;
+            computed.revision = info->areas_revision;
+            const Area* spacing = info->find_area("spacing_area");
+            if (spacing && !spacing->get_points().empty()) {
+                // Check aligns a spacing area so its anchor sits half its
+                // height above the spawn point.
+                auto [minx, miny, maxx, maxy] = spacing->get_bounds();
+                const int lift = (maxy - miny + 1) / 2;
+                computed.has_area = true;
+                computed.rel = Box{ minx - spacing->pos.x, miny - spacing->pos.y - lift,
+                                    maxx - spacing->pos.x, maxy - spacing->pos.y - lift };
+            }
+            it = spacing_cache_.insert_or_assign(info.get(), computed).first;
+        }
+        offsets = it->second;
+    }
+    if (!offsets.has_area) {
+        // Matches the 1x1 square Check used to build for neighbours without a
+        // spacing area, which clamps to the non-negative map range.
+        const int x = std::max(0, pos.x);
+        const int y = std::max(0, pos.y);
+        return Box{ x, y, x, y };
+    }
+    return Box{ pos.x + offsets.rel.minx, pos.y + offsets.rel.miny,
+                pos.x + offsets.rel.maxx, pos.y + offsets.rel.maxy };
+}
+
+void SpawnIndex::add(Asset* asset) {
+    if (!asset || !asset->info) return;
+    const auto id = static_cast<std::uint32_t>(entries_.size());
+    Entry entry;
+    entry.asset = asset;
+    entry.pos = asset->pos;
+    entry.spacing = spacing_box(asset->info, asset->pos);
+    entries_.push_back(entry);
+    insert(all_, id, entry.pos);
+    if (!asset->info->name.empty()) {
+        insert(by_name_[asset->info->name], id, entry.pos);
+    }
+}
+
+void SpawnIndex::insert(Buckets& b, std::uint32_t id, SDL_Point pos) {
+    const int cx = cell_of(pos.x);
+    const int cy = cell_of(pos.y);
+    if (b.ids.empty()) {
+        b.min_cx = b.max_cx = cx;
+        b.min_cy = b.max_cy = cy;
+    } else {
+        b.min_cx = std::min(b.min_cx, cx);
+        b.max_cx = std::max(b.max_cx, cx);
+        b.min_cy = std::min(b.min_cy, cy);
+        b.max_cy = std::max(b.max_cy, cy);
+    }
+    b.ids.push_back(id);
+    b.cells[key(cx, cy)].push_back(id);
+}
+
+void SpawnIndex::nearest(SDL_Point pos, int max_count, std::vector<const Entry*>& out) const {
+    out.clear();
+    if (max_count <= 0 || all_.ids.empty()) return;
+    const std::size_t k = static_cast<std::size_t>(max_count);
+
+    std::vector<std::pair<double, std::uint32_t>> found;
+    auto take = [&](std::uint32_t id) {
+        const double dx = static_cast<double>(entries_[id].pos.x) - pos.x;
+        const double dy = static_cast<double>(entries_[id].pos.y) - pos.y;
+        found.emplace_back(dx * dx + dy * dy, id);
+};
+    auto take_cell = [&](int cx, int cy) {
+        auto it = all_.cells.find(key(cx, cy));
+        if (it == all_.cells.end()) return;
+        for (std::uint32_t id : it->second) take(id);
+};
+
+    if (all_.ids.size() <= k) {
+        for (std::uint32_t id : all_.ids) take(id);
+    } else {
+        // Walk square rings of cells outward. Anything outside ring r is at
+        // least r cells away, so stop once the k-th best is that close.
+        const int cx = cell_of(pos.x);
+        const int cy = cell_of(pos.y);
+        const int max_r = std::max(std::max(std::abs(cx - all_.min_cx), std::abs(cx - all_.max_cx)),
+                                   std::max(std::abs(cy - all_.min_cy), std::abs(cy - all_.max_cy)));
+        for (int r = 0; r <= max_r; ++r) {
+            if (r == 0) {
+                take_cell(cx, cy);
+            } else {
+                for (int dx = -r; dx <= r; ++dx) {
+                    take_cell(cx + dx, cy - r);
+                    take_cell(cx + dx, cy + r);
+                }
+                for (int dy = -r + 1; dy <= r - 1; ++dy) {
+                    take_cell(cx - r, cy + dy);
+                    take_cell(cx + r, cy + dy);
+                }
+            }
+            if (found.size() >= k) {
+                std::nth_element(found.begin(), found.begin() + static_cast<std::ptrdiff_t>(k - 1), found.end(),
+                                 [](const auto& a, const auto& b) { return a.first < b.first; });
+                found.resize(k);
+                const double reach = static_cast<double>(r) * cell_size_;
+                if (found[k - 1].first <= reach * reach) break;
+            }
+        }
+    }
+
+    std::sort(found.begin(), found.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+    if (found.size() > k) found.resize(k);
+    out.reserve(found.size());
+    for (const auto& f : found) out.push_back(&entries_[f.second]);
+}
+
+const SpawnIndex::Entry* SpawnIndex::first_within(const Buckets& b, SDL_Point pos, int radius) const {
+    if (b.ids.empty()) return nullptr;
+    const double r2 = static_cast<double>(radius) * static_cast<double>(radius);
+    auto hit = [&](std::uint32_t id) {
+        const double dx = static_cast<double>(entries_[id].pos.x) - pos.x;
+        const double dy = static_cast<double>(entries_[id].pos.y) - pos.y;
+        return dx * dx + dy * dy <= r2;
+};
+    const int reach = std::abs(radius);
+    const int x0 = std::max(b.min_cx, cell_of(pos.x - reach));
+    const int x1 = std::min(b.max_cx, cell_of(pos.x + reach));
+    const int y0 = std::max(b.min_cy, cell_of(pos.y - reach));
+    const int y1 = std::min(b.max_cy, cell_of(pos.y + reach));
+    if (x0 > x1 || y0 > y1) return nullptr;
+
+    const double cell_count = (static_cast<double>(x1) - x0 + 1) * (static_cast<double>(y1) - y0 + 1);
+    if (cell_count >= static_cast<double>(b.ids.size())) {
+        for (std::uint32_t id : b.ids) {
+            if (hit(id)) return &entries_[id];
+        }
+        return nullptr;
+    }
+    for (int cy = y0; cy <= y1; ++cy) {
+        for (int cx = x0; cx <= x1; ++cx) {
+            auto it = b.cells.find(key(cx, cy));
+            if (it == b.cells.end()) continue;
+            for (std::uint32_t id : it->second) {
+                if (hit(id)) return &entries_[id];
+            }
+        }
+    }
+    return nullptr;
+}
+
+const SpawnIndex::Entry* SpawnIndex::any_within(SDL_Point pos, int radius) const {
+    return first_within(all_, pos, radius);
+}
+
+const SpawnIndex::Entry* SpawnIndex::any_within(SDL_Point pos, int radius, const std::string& name) const {
+    auto it = by_name_.find(name);
+    if (it == by_name_.end()) return nullptr;
+    return first_within(it->second, pos, radius);
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <SDL.h>
+
+class Asset;
+class AssetInfo;
+
+// Spatial buckets over the assets a spawn run has placed so far, so Check can
+// look at nearby assets instead of scanning every asset for every attempt.
+// Assets are bucketed by position into square cells, once overall and once per
+// asset name (for same-type distance), and each entry carries its spacing-area
+// bounding box aligned the way Check aligns spacing areas.
+//
+// The index follows an append-only asset list: sync() adds whatever was pushed
+// since the last call and rebuilds if the list shrank or was replaced.
+// Positions are read when an asset is added; spawned assets do not move while
+// a room is being filled.
+class SpawnIndex {
+public:
+    struct Box {
+        int minx = 0;
+        int miny = 0;
+        int maxx = 0;
+        int maxy = 0;
+};
+
+    struct Entry {
+        Asset* asset = nullptr;
+        SDL_Point pos{0, 0};
+        Box spacing;
+};
+
+    explicit SpawnIndex(int cell_size = 256);
+
+    void sync(const std::vector<std::unique_ptr<Asset>>& all);
+    void clear();
+    std::size_t size() const { return entries_.size(); }
+
+    // Spacing-area bounds of info placed at pos; for assets without a spacing
+    // area this is the single point at pos.
+    Box spacing_box(const std::shared_ptr<AssetInfo>& info, SDL_Point pos) const;
+
+    // Up to max_count entries closest to pos, nearest first.
+    void nearest(SDL_Point pos, int max_count, std::vector<const Entry*>& out) const;
+
+    // First entry within radius of pos (inclusive), optionally restricted to
+    // assets with the given info name; nullptr if there is none.
+    const Entry* any_within(SDL_Point pos, int radius) const;
+    const Entry* any_within(SDL_Point pos, int radius, const std::string& name) const;
+
+private:
+    using CellKey = std::uint64_t;
+
+    struct Buckets {
+        std::unordered_map<CellKey, std::vector<std::uint32_t>> cells;
+        std::vector<std::uint32_t> ids;
+        int min_cx = 0;
+        int min_cy = 0;
+        int max_cx = -1;
+        int max_cy = -1;
+};
+
+    // Spacing-area bounds relative to the spawn point, per AssetInfo and
+    // rebuilt when the info's areas_revision moves on.
+    struct SpacingOffsets {
+        std::uint32_t revision = 0;
+        bool has_area = false;
+        Box rel;
+};
+
+    int cell_size_ = 256;
+    const Asset* last_synced_ = nullptr;
+    std::size_t synced_count_ = 0;
+    std::vector<Entry> entries_;
+    Buckets all_;
+    std::unordered_map<std::string, Buckets> by_name_;
+    mutable std::unordered_map<const AssetInfo*, SpacingOffsets> spacing_cache_;
+
+    int cell_of(int v) const;
+    static CellKey key(int cx, int cy);
+    void add(Asset* asset);
+    void insert(Buckets& b, std::uint32_t id, SDL_Point pos);
+    const Entry* first_within(const Buckets& b, SDL_Point pos, int radius) const;
+};
@@ -23,22 +23,39 @@ void SpawnLogger::output_and_log(const std::string& asset_name,
                                  int max_attempts,
                                  const std::string& method) {
 	auto end_time = std::chrono::steady_clock::now();
-	double duration_ms = std::chrono::duration<double, std::milli>(end_time - start_time_).count();
-	const std::string csv_path = map_dir_ + "/spawn_log.csv";
-	std::ifstream infile(csv_path);
-	std::vector<std::string> lines;
-	if (infile.is_open()) {
-		std::string line;
-		while (std::getline(infile, line)) {
-			lines.push_back(line);
-		}
-		infile.close();
+	Record record;
+	record.room_dir    = room_dir_;
+	record.asset_name  = asset_name;
+	record.method      = method;
+	record.spawned     = spawned;
+	record.attempts    = attempts;
+	record.duration_ms = std::chrono::duration<double, std::milli>(end_time - start_time_).count();
+	if (buffered_) {
+		records_.push_back(std::move(record));
+		return;
 	}
+	write_records(map_dir_, std::vector<Record>{ std::move(record) });
+}
+
+std::vector<SpawnLogger::Record> SpawnLogger::take_records() {
+	std::vector<Record> out = std::move(records_);
+	records_.clear();
+	return out;
+}
+
+namespace {
+void apply_spawn_record(std::vector<std::string>& lines, const SpawnLogger::Record& rec) {
+	const std::string& room_dir = rec.room_dir;
+	const std::string& asset_name = rec.asset_name;
+	const std::string& method = rec.method;
+	const int spawned = rec.spawned;
+	const int attempts = rec.attempts;
+	const double duration_ms = rec.duration_ms;
 	int room_line_index = -1;
 	for (size_t i = 0; i < lines.size(); ++i) {
 		if (lines[i].empty() && i + 3 < lines.size()
 		&& lines[i + 1].empty() && lines[i + 2].empty()
-      && lines[i + 3] == room_dir_) {
+      && lines[i + 3] == room_dir) {
 			room_line_index = static_cast<int>(i + 3);
 			break;
 		}
@@ -48,7 +65,7 @@ void SpawnLogger::output_and_log(const std::string& asset_name,
 		lines.emplace_back("");
 		lines.emplace_back("");
 		room_line_index = static_cast<int>(lines.size());
-		lines.push_back(room_dir_);
+		lines.push_back(room_dir);
 	}
 	int insert_index = room_line_index + 1;
 	int asset_line_index = -1;
@@ -103,6 +120,26 @@ void SpawnLogger::output_and_log(const std::string& asset_name,
 	updated_line << asset_name << ","
 	<< std::fixed << std::setprecision(3) << new_percent << "," << total_success << "," << total_attempts << "," << method << "," << std::fixed << std::setprecision(3) << average_time << "," << times_generated << "," << std::fixed << std::setprecision(3) << delta_time;
 	lines[asset_line_index] = updated_line.str();
+}
+}
+
+void SpawnLogger::write_records(const std::string& map_dir, const std::vector<Record>& records) {
+	// Loggers built without a map directory (child and boundary spawns) have
+	// nowhere to keep a log.
+	if (map_dir.empty() || records.empty()) return;
+	const std::string csv_path = map_dir + "/spawn_log.csv";
+	std::ifstream infile(csv_path);
+	std::vector<std::string> lines;
+	if (infile.is_open()) {
+		std::string line;
+		while (std::getline(infile, line)) {
+			lines.push_back(line);
+		}
+		infile.close();
+	}
+	for (const Record& rec : records) {
+		apply_spawn_record(lines, rec);
+	}
 	std::ofstream outfile(csv_path);
 	if (outfile.is_open()) {
 		for (const auto& l : lines) {
@@ -113,6 +150,7 @@ void SpawnLogger::output_and_log(const std::string& asset_name,
 }
 
 void SpawnLogger::progress(const std::shared_ptr<AssetInfo>& info, int current, int total) {
+	if (buffered_) return;
 	const int bar_width = 50;
 	double percent = (total > 0) ? static_cast<double>(current) / total : 0.0;
 	int filled = static_cast<int>(percent * bar_width);
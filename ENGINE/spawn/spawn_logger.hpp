@@ -3,18 +3,38 @@
 #include <string>
 #include <chrono>
 #include <memory>
+#include <vector>
 #include "asset/asset_info.hpp"
 
 class SpawnLogger {
 
 	public:
+    // One spawn_log.csv row update: the result of one spawn group in one room.
+    struct Record {
+        std::string room_dir;
+        std::string asset_name;
+        std::string method;
+        int spawned = 0;
+        int attempts = 0;
+        double duration_ms = 0.0;
+};
+
     SpawnLogger(const std::string& map_dir, std::string room_dir);
     void start_timer();
     void output_and_log(const std::string& asset_name, int quantity, int spawned, int attempts, int max_attempts, const std::string& method);
     void progress(const std::shared_ptr<AssetInfo>& info, int current, int total);
 
+    // A buffered logger keeps its rows instead of rewriting spawn_log.csv per
+    // group and draws no progress bar, so rooms can spawn on worker threads;
+    // the caller collects the rows and writes them once with write_records.
+    void set_buffered(bool buffered) { buffered_ = buffered; }
+    std::vector<Record> take_records();
+    static void write_records(const std::string& map_dir, const std::vector<Record>& records);
+
 	private:
     std::string map_dir_;
     std::string room_dir_;
     std::chrono::time_point<std::chrono::steady_clock> start_time_;
+    bool buffered_ = false;
+    std::vector<Record> records_;
 };
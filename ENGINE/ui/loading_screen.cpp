@@ -1,5 +1,6 @@
 #include "loading_screen.hpp"
 #include <SDL_image.h>
+#include <algorithm>
 #include <fstream>
 #include <sstream>
 #include <random>
@@ -118,27 +119,54 @@ void LoadingScreen::init() {
 	last_switch_time_ = SDL_GetTicks();
 }
 
+void LoadingScreen::set_progress(float fraction, const std::string& stage) {
+	progress_ = std::clamp(fraction, 0.0f, 1.0f);
+	stage_ = stage;
+}
+
+void LoadingScreen::draw_progress_bar(TTF_Font* font, SDL_Color col) {
+	if (progress_ < 0.0f) return;
+	const int bar_w = screen_w_ / 3;
+	const int bar_h = 12;
+	SDL_Rect outline{ (screen_w_ - bar_w) / 2, screen_h_ - screen_h_ / 10, bar_w, bar_h };
+	SDL_Rect fill{ outline.x + 2, outline.y + 2, static_cast<int>((outline.w - 4) * progress_), outline.h - 4 };
+	SDL_SetRenderDrawColor(renderer_, col.r, col.g, col.b, col.a);
+	SDL_RenderDrawRect(renderer_, &outline);
+	SDL_RenderFillRect(renderer_, &fill);
+	if (font && !stage_.empty()) {
+		int tw = 0, th = 0;
+		TTF_SizeText(font, stage_.c_str(), &tw, &th);
+		draw_text(font, stage_, (screen_w_ - tw) / 2, outline.y - th - 6, col);
+	}
+}
+
 void LoadingScreen::draw_frame() {
-	if (images_.empty()) return;
-	Uint32 now = SDL_GetTicks();
-	if (now - last_switch_time_ > 250) {
-		current_index_ = (current_index_ + 1) % images_.size();
-		last_switch_time_ = now;
+	if (images_.empty() && progress_ < 0.0f) return;
+	SDL_Texture* tex = nullptr;
+	if (!images_.empty()) {
+		Uint32 now = SDL_GetTicks();
+		if (now - last_switch_time_ > 250) {
+			current_index_ = (current_index_ + 1) % images_.size();
+			last_switch_time_ = now;
+		}
+		SDL_Surface* surf = IMG_Load(images_[current_index_].string().c_str());
+		if (surf) {
+			tex = SDL_CreateTextureFromSurface(renderer_, surf);
+			SDL_FreeSurface(surf);
+		}
+		if (!tex && progress_ < 0.0f) return;
 	}
-	SDL_Surface* surf = IMG_Load(images_[current_index_].string().c_str());
-	if (!surf) return;
-	SDL_Texture* tex = SDL_CreateTextureFromSurface(renderer_, surf);
-	SDL_FreeSurface(surf);
-	if (!tex) return;
 	SDL_SetRenderDrawColor(renderer_,0,0,0,255); SDL_RenderClear(renderer_);
 	const std::string mono_font = ui_fonts::monospace();
 	TTF_Font* title_font=TTF_OpenFont(mono_font.c_str(),48);
 	SDL_Color white={255,255,255,255};
 	if(title_font){int tw,th; TTF_SizeText(title_font,"LOADING...",&tw,&th); int tx=(screen_w_-tw)/2;
 		draw_text(title_font,"LOADING...",tx,40,white); TTF_CloseFont(title_font);}
-	render_scaled_center(tex,screen_w_/3,screen_h_/3,screen_w_/2,screen_h_/2);
+	if (tex) render_scaled_center(tex,screen_w_/3,screen_h_/3,screen_w_/2,screen_h_/2);
         TTF_Font* body_font=TTF_OpenFont(mono_font.c_str(),26);
 	SDL_Rect msg_rect{screen_w_/3,(screen_h_*2)/3,screen_w_/3,screen_h_/4};
-	if(body_font && !message_.empty()){render_justified_text(body_font,message_,msg_rect,white); TTF_CloseFont(body_font);}
-	SDL_DestroyTexture(tex);
+	if(body_font && !message_.empty()){render_justified_text(body_font,message_,msg_rect,white);}
+	draw_progress_bar(body_font, white);
+	if(body_font) TTF_CloseFont(body_font);
+	if (tex) SDL_DestroyTexture(tex);
 }
@@ -12,6 +12,8 @@ class LoadingScreen {
     LoadingScreen(SDL_Renderer* renderer, int screen_w, int screen_h);
     void init();
     void draw_frame();
+    // Shown as a bar under the slideshow once set; fraction is clamped to [0, 1].
+    void set_progress(float fraction, const std::string& stage);
 
 	private:
     SDL_Renderer* renderer_;
@@ -21,10 +23,13 @@ class LoadingScreen {
     std::string message_;
     size_t current_index_ = 0;
     Uint32 last_switch_time_ = 0;
+    float progress_ = -1.0f;
+    std::string stage_;
     std::filesystem::path pick_random_loading_folder();
     std::vector<std::filesystem::path> list_images_in(const std::filesystem::path& dir);
     std::string pick_random_message_from_csv(const std::filesystem::path& csv_path);
     void draw_text(TTF_Font* font, const std::string& txt, int x, int y, SDL_Color col);
     void render_justified_text(TTF_Font* font, const std::string& text, const SDL_Rect& rect, SDL_Color col);
     void render_scaled_center(SDL_Texture* tex, int target_w, int target_h, int cx, int cy);
+    void draw_progress_bar(TTF_Font* font, SDL_Color col);
 };
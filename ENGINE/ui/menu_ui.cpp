@@ -6,6 +6,7 @@
 #include "scene_renderer.hpp"
 #include "AssetsManager.hpp"
 #include "input.hpp"
+#include "utils/frame_profiler.hpp"
 
 #include <iostream>
 #include <fstream>
@@ -28,6 +29,7 @@ MenuUI::MenuUI(SDL_Renderer* renderer,
 		}
 	}
 	menu_active_ = false;
+	clock_.set_tick_rate(60.0);
 }
 
 MenuUI::~MenuUI() = default;
@@ -43,13 +45,14 @@ bool MenuUI::wants_return_to_main_menu() const {
 }
 
 void MenuUI::game_loop() {
-	const int FRAME_MS = 1000 / 60;
 	bool quit = false;
 	SDL_Event e;
 	int frame_count = 0;
 	return_to_main_menu_ = false;
+	clock_.reset();
 	while (!quit) {
-		Uint32 start = SDL_GetTicks();
+		PROFILE_FRAME();
+		clock_.begin_frame();
 		while (SDL_PollEvent(&e)) {
 			if (e.type == SDL_QUIT) {
 					quit = true;
@@ -78,35 +81,22 @@ void MenuUI::game_loop() {
                         if (game_assets_) game_assets_->handle_sdl_event(e);
                         if (menu_active_) handle_event(e);
                 }
-                if (game_assets_) {
-                        int px = 0;
-                        int py = 0;
-                        if (game_assets_->player) {
-                                px = game_assets_->player->pos.x;
-                                py = game_assets_->player->pos.y;
-                        } else {
-                                SDL_Point focus = game_assets_->getView().get_screen_center();
-                                px = focus.x;
-                                py = focus.y;
-                        }
-                        if (input_) {
-                                game_assets_->update(*input_, px, py);
-                        }
+                while (clock_.consume_tick()) {
+                        step_simulation();
                 }
+                if (game_assets_) game_assets_->render(clock_.alpha());
                 if (menu_active_) {
                         render();
                         switch (consumeAction()) {
                                         case MenuAction::EXIT:            doExit();         quit = true;        break;
-                                        case MenuAction::RESTART:         doRestart();      frame_count = 0;    break;
+                                        case MenuAction::RESTART:         doRestart();      frame_count = 0;    clock_.reset(); break;
                                         case MenuAction::SETTINGS:        doSettings();                         break;
                                         default: break;
                         }
                 }
                 SDL_RenderPresent(renderer_);
 		++frame_count;
-		if (input_) input_->update();
-		Uint32 elapsed = SDL_GetTicks() - start;
-		if (elapsed < FRAME_MS) SDL_Delay(FRAME_MS - elapsed);
+		clock_.end_frame();
 	}
 }
 
@@ -245,7 +235,7 @@ void MenuUI::doRestart() {
                 }
                 int start_px = player_ptr ? player_ptr->pos.x : static_cast<int>(loader_->getMapRadius());
                 int start_py = player_ptr ? player_ptr->pos.y : static_cast<int>(loader_->getMapRadius());
-                game_assets_ = new Assets(std::move(all_assets), *loader_->getAssetLibrary(), player_ptr, loader_->getRooms(), screen_w_, screen_h_, start_px, start_py, static_cast<int>(loader_->getMapRadius() * 1.2), renderer_, map_path_);
+                game_assets_ = new Assets(std::move(all_assets), *loader_->getAssetLibrary(), player_ptr, loader_->getRooms(), screen_w_, screen_h_, start_px, start_py, static_cast<int>(loader_->getMapRadius() * 1.2), renderer_, loader_->getMapDocument());
                 if (!input_) input_ = new Input();
                 game_assets_->set_input(input_);
                 if (!player_ptr) {
@@ -10,12 +10,17 @@
 #include <filesystem>
 #include <sstream>
 #include <optional>
+#if defined(__AVX__)
+#include <immintrin.h>
+#define AREA_SIMD_AVX 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define AREA_SIMD_SSE2 1
+#endif
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
 #endif
 
-static std::mt19937 rng{std::random_device{}()};
-
 Area::Area(const std::string& name)
 : pos{0, 0}, area_name_(name) {}
 
@@ -35,14 +40,34 @@ Area::Area(const std::string& name, SDL_Point center, int w, int h,
            int edge_smoothness,
            int map_width, int map_height)
 : area_name_(name)
+{
+        std::mt19937 shape_rng{std::random_device{}()};
+        build_shape(center, w, h, geometry, edge_smoothness, map_width, map_height, shape_rng);
+}
+
+Area::Area(const std::string& name, SDL_Point center, int w, int h,
+           const std::string& geometry,
+           int edge_smoothness,
+           int map_width, int map_height,
+           std::mt19937& shape_rng)
+: area_name_(name)
+{
+        build_shape(center, w, h, geometry, edge_smoothness, map_width, map_height, shape_rng);
+}
+
+void Area::build_shape(SDL_Point center, int w, int h,
+                       const std::string& geometry,
+                       int edge_smoothness,
+                       int map_width, int map_height,
+                       std::mt19937& shape_rng)
 {
         if (w <= 0 || h <= 0 || map_width <= 0 || map_height <= 0) {
                 throw std::runtime_error("[Area: " + area_name_ + "] Invalid dimensions");
         }
         if (geometry == "Circle") {
-                generate_circle(center, w / 2, edge_smoothness, map_width, map_height);
+                generate_circle(center, w / 2, edge_smoothness, map_width, map_height, shape_rng);
         } else if (geometry == "Square") {
-                generate_square(center, w, h, edge_smoothness, map_width, map_height);
+                generate_square(center, w, h, edge_smoothness, map_width, map_height, shape_rng);
         } else if (geometry == "Point") {
                 generate_point(center, map_width, map_height);
         } else {
@@ -103,7 +128,23 @@ void Area::apply_offset(int dx, int dy) {
         }
         pos.x += dx;
         pos.y += dy;
-	update_geometry_data();
+        if (points.empty()) return;
+        // A translation keeps the shape, so shift the cached bounds and edge table
+        // instead of rebuilding them; this keeps moving collision areas allocation-free.
+        // The ray index is relative to its origin, so it is dropped instead.
+        ray_index_ = RaySectorIndex{};
+        min_x_ += dx; max_x_ += dx;
+        min_y_ += dy; max_y_ += dy;
+        center_x += dx;
+        center_y += dy;
+        if (edges_.vertex_count == points.size()) {
+                for (double& v : edges_.xi) v += dx;
+                for (double& v : edges_.yi) v += dy;
+                for (double& v : edges_.yj) v += dy;
+                edges_.band_min_y += dy;
+        } else {
+                update_geometry_data();
+        }
 }
 
 void Area::align(SDL_Point target) {
@@ -136,7 +177,7 @@ void Area::generate_point(SDL_Point center, int map_width, int map_height) {
         points.emplace_back(SDL_Point{ std::clamp(center.x, 0, map_width), std::clamp(center.y, 0, map_height) });
 }
 
-void Area::generate_circle(SDL_Point center, int radius, int edge_smoothness, int map_width, int map_height) {
+void Area::generate_circle(SDL_Point center, int radius, int edge_smoothness, int map_width, int map_height, std::mt19937& rng) {
 	int s = std::clamp(edge_smoothness, 0, 100);
 	int count = std::max(12, 6 + s * 2);
 	double max_dev = 0.20 * (100 - s) / 100.0;
@@ -154,7 +195,7 @@ void Area::generate_circle(SDL_Point center, int radius, int edge_smoothness, in
 	}
 }
 
-void Area::generate_square(SDL_Point center, int w, int h, int edge_smoothness, int map_width, int map_height) {
+void Area::generate_square(SDL_Point center, int w, int h, int edge_smoothness, int map_width, int map_height, std::mt19937& rng) {
 	int s = std::clamp(edge_smoothness, 0, 100);
 	double max_dev = 0.25 * (100 - s) / 100.0;
 	std::uniform_real_distribution<double> xoff(-max_dev * w, max_dev * w);
@@ -205,6 +246,9 @@ bool Area::contains_point(const Point& pt) const {
         if (pt.x < minx || pt.x > maxx || pt.y < miny || pt.y > maxy) {
                 return false;
         }
+        if (edges_.vertex_count == n) {
+                return edge_table_crossing_odd(pt);
+        }
         bool inside = false;
         const double x = pt.x;
         const double y = pt.y;
@@ -219,13 +263,235 @@ bool Area::contains_point(const Point& pt) const {
         return inside;
 }
 
+void Area::contains_points(const Point* pts, std::size_t count, std::vector<std::uint8_t>& out) const {
+        out.assign(count, 0);
+        const size_t n = points.size();
+        if (count == 0 || n == 0) return;
+        if (n < 3 || edges_.vertex_count != n) {
+                for (std::size_t k = 0; k < count; ++k) {
+                        out[k] = contains_point(pts[k]) ? 1 : 0;
+                }
+                return;
+        }
+        auto [minx, miny, maxx, maxy] = get_bounds();
+        for (std::size_t k = 0; k < count; ++k) {
+                const Point& p = pts[k];
+                if (p.x < minx || p.x > maxx || p.y < miny || p.y > maxy) continue;
+                out[k] = edge_table_crossing_odd(p) ? 1 : 0;
+        }
+}
+
 bool Area::intersects(const Area& other) const {
 	auto [a0, a1, a2, a3] = get_bounds();
 	auto [b0, b1, b2, b3] = other.get_bounds();
 	return !(a2 < b0 || b2 < a0 || a3 < b1 || b3 < a1);
 }
 
+namespace {
+        constexpr std::size_t kAreaEdgeLanes = 4;
+}
+
+void Area::build_edge_table() {
+        EdgeTable table;
+        const size_t n = points.size();
+        if (n < 3) {
+                edges_ = std::move(table);
+                return;
+        }
+
+        const int miny = min_y_;
+        const int maxy = max_y_;
+        const int bands = static_cast<int>(std::clamp<size_t>(n / 4, 1, 64));
+        table.band_min_y = miny;
+        table.band_height = std::max(1, (maxy - miny + bands) / bands);
+
+        auto band_of = [&](int y) {
+                return std::clamp((y - table.band_min_y) / table.band_height, 0, bands - 1);
+};
+
+        std::vector<std::vector<std::uint32_t>> members(static_cast<size_t>(bands));
+        for (size_t i = 0, j = n - 1; i < n; j = i++) {
+                const int y0 = std::min(points[i].y, points[j].y);
+                const int y1 = std::max(points[i].y, points[j].y);
+                if (y0 == y1) continue;
+                // The straddle test only passes for y0 <= y < y1.
+                for (int b = band_of(y0); b <= band_of(y1 - 1); ++b) {
+                        members[static_cast<size_t>(b)].push_back(static_cast<std::uint32_t>(i));
+                }
+        }
+
+        table.band_start.reserve(static_cast<size_t>(bands) + 1);
+        for (const auto& band : members) {
+                table.band_start.push_back(static_cast<std::uint32_t>(table.xi.size()));
+                for (std::uint32_t i : band) {
+                        const size_t j = (i == 0) ? n - 1 : i - 1;
+                        const double dy = static_cast<double>(points[j].y) - points[i].y;
+                        const double dx = static_cast<double>(points[j].x) - points[i].x;
+                        table.xi.push_back(points[i].x);
+                        table.yi.push_back(points[i].y);
+                        table.yj.push_back(points[j].y);
+                        table.ady.push_back(std::abs(dy));
+                        table.sdx.push_back(dy > 0 ? dx : -dx);
+                }
+                while (table.xi.size() % kAreaEdgeLanes != 0) {
+                        table.xi.push_back(0.0);
+                        table.yi.push_back(0.0);
+                        table.yj.push_back(0.0);
+                        table.ady.push_back(0.0);
+                        table.sdx.push_back(0.0);
+                }
+        }
+        table.band_start.push_back(static_cast<std::uint32_t>(table.xi.size()));
+        table.vertex_count = n;
+        edges_ = std::move(table);
+}
+
+bool Area::edge_table_crossing_odd(const Point& pt) const {
+        const int bands = static_cast<int>(edges_.band_start.size()) - 1;
+        if (bands <= 0) return false;
+        const int band = std::clamp((pt.y - edges_.band_min_y) / edges_.band_height, 0, bands - 1);
+        const std::size_t begin = edges_.band_start[static_cast<size_t>(band)];
+        const std::size_t end = edges_.band_start[static_cast<size_t>(band) + 1];
+        const double x = pt.x;
+        const double y = pt.y;
+
+#if defined(AREA_SIMD_AVX)
+        const __m256d vx = _mm256_set1_pd(x);
+        const __m256d vy = _mm256_set1_pd(y);
+        int parity = 0;
+        for (std::size_t i = begin; i < end; i += 4) {
+                const __m256d yi = _mm256_loadu_pd(&edges_.yi[i]);
+                const __m256d straddle = _mm256_xor_pd(_mm256_cmp_pd(yi, vy, _CMP_GT_OQ),
+                                                       _mm256_cmp_pd(_mm256_loadu_pd(&edges_.yj[i]), vy, _CMP_GT_OQ));
+                const __m256d lhs = _mm256_mul_pd(_mm256_sub_pd(vx, _mm256_loadu_pd(&edges_.xi[i])), _mm256_loadu_pd(&edges_.ady[i]));
+                const __m256d rhs = _mm256_mul_pd(_mm256_loadu_pd(&edges_.sdx[i]), _mm256_sub_pd(vy, yi));
+                parity ^= _mm256_movemask_pd(_mm256_and_pd(straddle, _mm256_cmp_pd(lhs, rhs, _CMP_LT_OQ)));
+        }
+        return ((parity ^ (parity >> 1) ^ (parity >> 2) ^ (parity >> 3)) & 1) != 0;
+#elif defined(AREA_SIMD_SSE2)
+        const __m128d vx = _mm_set1_pd(x);
+        const __m128d vy = _mm_set1_pd(y);
+        int parity = 0;
+        for (std::size_t i = begin; i < end; i += 2) {
+                const __m128d yi = _mm_loadu_pd(&edges_.yi[i]);
+                const __m128d straddle = _mm_xor_pd(_mm_cmpgt_pd(yi, vy), _mm_cmpgt_pd(_mm_loadu_pd(&edges_.yj[i]), vy));
+                const __m128d lhs = _mm_mul_pd(_mm_sub_pd(vx, _mm_loadu_pd(&edges_.xi[i])), _mm_loadu_pd(&edges_.ady[i]));
+                const __m128d rhs = _mm_mul_pd(_mm_loadu_pd(&edges_.sdx[i]), _mm_sub_pd(vy, yi));
+                parity ^= _mm_movemask_pd(_mm_and_pd(straddle, _mm_cmplt_pd(lhs, rhs)));
+        }
+        return ((parity ^ (parity >> 1)) & 1) != 0;
+#else
+        bool inside = false;
+        for (std::size_t i = begin; i < end; ++i) {
+                const bool straddle = (edges_.yi[i] > y) != (edges_.yj[i] > y);
+                if (straddle && (x - edges_.xi[i]) * edges_.ady[i] < edges_.sdx[i] * (y - edges_.yi[i])) {
+                        inside = !inside;
+                }
+        }
+        return inside;
+#endif
+}
+
+namespace {
+        // Below this many edges a linear scan beats building the sector index.
+        constexpr std::size_t kRayIndexMinEdges = 24;
+        constexpr int         kRaySectors       = 64;
+
+        int ray_sector_of(double angle) {
+                const double turn = (angle + M_PI) / (2.0 * M_PI);
+                const int s = static_cast<int>(turn * kRaySectors);
+                return ((s % kRaySectors) + kRaySectors) % kRaySectors;
+        }
+
+        // Ray parameter t at which o + t*d crosses segment a-b, or -1.
+        double ray_segment_hit(double ox, double oy, double dx, double dy,
+                               const SDL_Point& a, const SDL_Point& b) {
+                const double ex = static_cast<double>(b.x) - a.x;
+                const double ey = static_cast<double>(b.y) - a.y;
+                const double denom = dx * ey - dy * ex;
+                if (denom == 0.0) return -1.0;
+                const double wx = a.x - ox;
+                const double wy = a.y - oy;
+                const double t = (wx * ey - wy * ex) / denom;
+                const double u = (wx * dy - wy * dx) / denom;
+                if (t <= 1e-9 || u < 0.0 || u > 1.0) return -1.0;
+                return t;
+        }
+}
+
+void Area::build_ray_index(double origin_x, double origin_y) const {
+        RaySectorIndex index;
+        index.valid = true;
+        index.origin_x = origin_x;
+        index.origin_y = origin_y;
+        const size_t n = points.size();
+
+        // First pass records each edge's sector range, second pass fills CSR.
+        std::vector<std::pair<int, int>> ranges(n);
+        std::vector<std::uint32_t> counts(kRaySectors, 0);
+        for (size_t i = 0, j = n - 1; i < n; j = i++) {
+                const double ax = points[j].x - origin_x, ay = points[j].y - origin_y;
+                const double bx = points[i].x - origin_x, by = points[i].y - origin_y;
+                const double cross = ax * by - ay * bx;
+                int first = 0;
+                int span  = kRaySectors - 1;
+                if (cross != 0.0 || ax * bx + ay * by > 0.0) {
+                        // Walk the shorter arc counter-clockwise, padded one
+                        // sector each side against atan2 rounding at the seams.
+                        const bool ccw = cross >= 0.0;
+                        const int s0 = ray_sector_of(std::atan2(ccw ? ay : by, ccw ? ax : bx));
+                        const int s1 = ray_sector_of(std::atan2(ccw ? by : ay, ccw ? bx : ax));
+                        first = s0 - 1;
+                        span  = std::min(kRaySectors - 1, ((s1 - s0 + kRaySectors) % kRaySectors) + 2);
+                }
+                // else: the origin lies on this edge and every ray may touch it.
+                ranges[i] = { first, span };
+                for (int k = 0; k <= span; ++k) {
+                        ++counts[static_cast<size_t>(((first + k) % kRaySectors + kRaySectors) % kRaySectors)];
+                }
+        }
+        index.sector_start.assign(kRaySectors + 1, 0);
+        for (int s = 0; s < kRaySectors; ++s) {
+                index.sector_start[s + 1] = index.sector_start[s] + counts[static_cast<size_t>(s)];
+        }
+        index.edge_ids.resize(index.sector_start.back());
+        std::vector<std::uint32_t> fill(index.sector_start.begin(), index.sector_start.end() - 1);
+        for (size_t i = 0; i < n; ++i) {
+                const auto [first, span] = ranges[i];
+                for (int k = 0; k <= span; ++k) {
+                        const int s = ((first + k) % kRaySectors + kRaySectors) % kRaySectors;
+                        index.edge_ids[fill[static_cast<size_t>(s)]++] = static_cast<std::uint32_t>(i);
+                }
+        }
+        ray_index_ = std::move(index);
+}
+
+double Area::ray_hit_distance(double origin_x, double origin_y, double dir_x, double dir_y) const {
+        const size_t n = points.size();
+        if (n < 2) return -1.0;
+        double best = -1.0;
+        auto test_edge = [&](size_t i) {
+                const size_t j = (i == 0) ? n - 1 : i - 1;
+                const double t = ray_segment_hit(origin_x, origin_y, dir_x, dir_y, points[j], points[i]);
+                if (t >= 0.0 && (best < 0.0 || t < best)) best = t;
+};
+        if (n < kRayIndexMinEdges) {
+                for (size_t i = 0; i < n; ++i) test_edge(i);
+                return best;
+        }
+        if (!ray_index_.valid || ray_index_.origin_x != origin_x || ray_index_.origin_y != origin_y) {
+                build_ray_index(origin_x, origin_y);
+        }
+        const int sector = ray_sector_of(std::atan2(dir_y, dir_x));
+        const std::uint32_t begin = ray_index_.sector_start[static_cast<size_t>(sector)];
+        const std::uint32_t end   = ray_index_.sector_start[static_cast<size_t>(sector) + 1];
+        for (std::uint32_t k = begin; k < end; ++k) test_edge(ray_index_.edge_ids[k]);
+        return best;
+}
+
 void Area::update_geometry_data() {
+	edges_ = EdgeTable{};
+	ray_index_ = RaySectorIndex{};
 	if (points.empty()) {
 		center_x = 0;
 		center_y = 0;
@@ -251,12 +517,13 @@ void Area::update_geometry_data() {
         }
 	min_x_ = minx; min_y_ = miny; max_x_ = maxx; max_y_ = maxy;
 	bounds_valid_ = true;
+	build_edge_table();
 	center_x = (minx + maxx) / 2;
 	center_y = (miny + maxy) / 2;
 	area_size = std::abs(static_cast<double>(twice_area)) * 0.5;
 }
 
-Area::Point Area::random_point_within() const {
+Area::Point Area::random_point_within(std::mt19937& rng) const {
         if (points.size() == 1) {
                 return points[0];
         }
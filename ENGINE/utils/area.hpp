@@ -1,9 +1,12 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <vector>
 #include <string>
 #include <tuple>
 #include <optional>
+#include <random>
 #include <SDL.h>
 
 class Area {
@@ -17,7 +20,12 @@ class Area {
 	public:
     explicit Area(const std::string& name);
     Area(const std::string& name, const std::vector<Point>& pts);
+    // Edge jitter comes from a freshly seeded generator, so the shape differs
+    // per call. Map generation must use the overload below with its seeded rng.
     Area(const std::string& name, SDL_Point center, int w, int h, const std::string& geometry, int edge_smoothness, int map_width, int map_height);
+    // Same shape generation, drawing the edge jitter from `rng` so map
+    // generation can reproduce it from a seed.
+    Area(const std::string& name, SDL_Point center, int w, int h, const std::string& geometry, int edge_smoothness, int map_width, int map_height, std::mt19937& rng);
     Area(const std::string& name, const std::string& json_path, float scale);
     Area(const std::string& name, const Area& base, SDL_Renderer* renderer, int window_w = 0, int window_h = 0);
     Area(const std::string& name, SDL_Texture* background, SDL_Renderer* renderer, int window_w = 0, int window_h = 0);
@@ -26,17 +34,29 @@ class Area {
     void apply_offset(int dx, int dy);
     void align(SDL_Point target);
     std::tuple<int, int, int, int> get_bounds() const;
-    void generate_circle(SDL_Point center, int radius, int edge_smoothness, int map_width, int map_height);
-    void generate_square(SDL_Point center, int w, int h, int edge_smoothness, int map_width, int map_height);
+    void generate_circle(SDL_Point center, int radius, int edge_smoothness, int map_width, int map_height, std::mt19937& rng);
+    void generate_square(SDL_Point center, int w, int h, int edge_smoothness, int map_width, int map_height, std::mt19937& rng);
     void generate_point(SDL_Point center, int map_width, int map_height);
+    void build_shape(SDL_Point center, int w, int h, const std::string& geometry, int edge_smoothness, int map_width, int map_height, std::mt19937& rng);
     void contract(int inset);
     double get_area() const;
     const std::vector<Point>& get_points() const;
     void union_with(const Area& other);
     bool contains_point(const Point& pt) const;
+    // Batched even-odd test; out[i] is 1 when pts[i] lies inside. Both this and
+    // contains_point walk the banded edge table, several edges per step when
+    // SSE2/AVX is available at compile time.
+    void contains_points(const Point* pts, std::size_t count, std::vector<std::uint8_t>& out) const;
     bool intersects(const Area& other) const;
+    // Distance from (origin_x, origin_y) along the unit direction (dir_x,
+    // dir_y) to the nearest polygon edge the ray crosses, or -1 if it crosses
+    // none. Polygons with many vertices keep their edges bucketed by angle
+    // around the last origin queried (trail generation fires every ray of a
+    // room from its centre), so a ray only tests the edges in its sector. The
+    // index is a lazily built cache: do not query one Area from two threads.
+    double ray_hit_distance(double origin_x, double origin_y, double dir_x, double dir_y) const;
     void update_geometry_data();
-    Point random_point_within() const;
+    Point random_point_within(std::mt19937& rng) const;
     Point get_center() const;
     double get_size() const;
 
@@ -50,7 +70,42 @@ class Area {
     void scale(float factor);
 
 	private:
+    // Crossing-test data rebuilt by update_geometry_data(). Non-horizontal edges
+    // are stored structure-of-arrays and bucketed into horizontal bands, so a
+    // query only visits edges that span its row. The ray from (x, y) crosses an
+    // edge when (yi > y) != (yj > y) and (x - xi) * ady < sdx * (y - yi), which
+    // is exact for integer vertices. Each band is padded with edges that never
+    // straddle so SIMD loads can run in fixed-width steps.
+    struct EdgeTable {
+        std::vector<double> xi;
+        std::vector<double> yi;
+        std::vector<double> yj;
+        std::vector<double> ady;
+        std::vector<double> sdx;
+        std::vector<std::uint32_t> band_start;
+        int band_min_y = 0;
+        int band_height = 1;
+        std::size_t vertex_count = 0;
+};
+
+    void build_edge_table();
+    bool edge_table_crossing_odd(const Point& pt) const;
+
+    // Edge ids (index of each edge's end vertex) grouped into equal angular
+    // sectors around origin; an edge is listed in every sector it subtends.
+    struct RaySectorIndex {
+        bool   valid    = false;
+        double origin_x = 0.0;
+        double origin_y = 0.0;
+        std::vector<std::uint32_t> sector_start;
+        std::vector<std::uint32_t> edge_ids;
+};
+
+    void build_ray_index(double origin_x, double origin_y) const;
+
     std::vector<Point> points;
+    EdgeTable edges_;
+    mutable RaySectorIndex ray_index_;
     std::string area_name_;
     int center_x = 0;
     int center_y = 0;
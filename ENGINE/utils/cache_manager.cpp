@@ -4,9 +4,12 @@
 #include <nlohmann/json.hpp>
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
+#include <cstring>
 #include <fstream>
 #include <filesystem>
 #include <iostream>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -31,8 +34,65 @@ static SDL_Surface* to_rgba8888(SDL_Surface* s) {
     return SDL_ConvertSurfaceFormat(s, SDL_PIXELFORMAT_RGBA8888, 0);
 }
 
+static void free_surfaces(std::vector<SDL_Surface*>& surfaces) {
+    for (SDL_Surface* s : surfaces) if (s) SDL_FreeSurface(s);
+    surfaces.clear();
+}
+
+static constexpr char     kPackMagic[4]  = { 'V', 'F', 'P', 'K' };
+static constexpr uint32_t kPackVersion   = 1;
+static constexpr size_t   kPackHeaderSize = 16; // magic, version, frame_count, meta_size
+static constexpr size_t   kPackEntrySize  = 32; // w, h, trim x/y/w/h, data offset (u64)
+
+static void put_u32(std::vector<char>& buf, uint32_t v) {
+    const char* p = reinterpret_cast<const char*>(&v);
+    buf.insert(buf.end(), p, p + sizeof(v));
+}
+
+static void put_u64(std::vector<char>& buf, uint64_t v) {
+    const char* p = reinterpret_cast<const char*>(&v);
+    buf.insert(buf.end(), p, p + sizeof(v));
+}
+
+static uint32_t get_u32(const char* p) {
+    uint32_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static uint64_t get_u64(const char* p) {
+    uint64_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+// Smallest rect holding every pixel with non-zero alpha; empty when fully transparent.
+static SDL_Rect opaque_bounds(SDL_Surface* s) {
+    const Uint32 amask = s->format->Amask;
+    int min_x = s->w, min_y = s->h, max_x = -1, max_y = -1;
+    for (int y = 0; y < s->h; ++y) {
+        const Uint32* row = reinterpret_cast<const Uint32*>(static_cast<const Uint8*>(s->pixels) + y * s->pitch);
+        int first = -1, last = -1;
+        for (int x = 0; x < s->w; ++x) {
+            if (row[x] & amask) {
+                if (first < 0) first = x;
+                last = x;
+            }
+        }
+        if (first < 0) continue;
+        min_x = std::min(min_x, first);
+        max_x = std::max(max_x, last);
+        if (min_y > y) min_y = y;
+        max_y = y;
+    }
+    if (max_x < 0) return SDL_Rect{ 0, 0, 0, 0 };
+    return SDL_Rect{ min_x, min_y, max_x - min_x + 1, max_y - min_y + 1 };
+}
+
+// Frames are scaled on loader worker threads; set the hint once rather than racing on it.
 static void set_best_scale_hint() {
-    SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, "best");
+    static std::once_flag once;
+    std::call_once(once, []() { SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, "best"); });
 }
 
 bool CacheManager::load_metadata(const std::string& meta_file, nlohmann::json& out_meta) {
@@ -120,6 +180,134 @@ bool CacheManager::save_surface_sequence(const std::string& folder, const std::v
     return true;
 }
 
+std::string CacheManager::source_stamp(const std::string& path) {
+    std::error_code ec;
+    const auto size = fs::file_size(path, ec);
+    if (ec) return {};
+    const auto mtime = fs::last_write_time(path, ec);
+    if (ec) return {};
+    return std::to_string(size) + ":" + std::to_string(mtime.time_since_epoch().count());
+}
+
+bool CacheManager::load_packed_sequence(const std::string& pack_file, nlohmann::json& out_meta, std::vector<SDL_Surface*>& surfaces) {
+    surfaces.clear();
+    std::ifstream in(pack_file, std::ios::binary | std::ios::ate);
+    if (!in) return false;
+    const std::streamoff size = in.tellg();
+    if (size < static_cast<std::streamoff>(kPackHeaderSize)) return false;
+    std::vector<char> buf(static_cast<size_t>(size));
+    in.seekg(0);
+    if (!in.read(buf.data(), size)) return false;
+
+    const char* base = buf.data();
+    if (std::memcmp(base, kPackMagic, sizeof(kPackMagic)) != 0 || get_u32(base + 4) != kPackVersion) {
+        return false;
+    }
+    const uint32_t frame_count = get_u32(base + 8);
+    const uint32_t meta_size   = get_u32(base + 12);
+    const size_t table_at = kPackHeaderSize + meta_size;
+    if (table_at + static_cast<size_t>(frame_count) * kPackEntrySize > buf.size()) return false;
+
+    try {
+        out_meta = nlohmann::json::parse(base + kPackHeaderSize, base + table_at);
+    } catch (...) {
+        return false;
+    }
+
+    surfaces.reserve(frame_count);
+    for (uint32_t i = 0; i < frame_count; ++i) {
+        const char* e = base + table_at + static_cast<size_t>(i) * kPackEntrySize;
+        const int w  = static_cast<int>(get_u32(e));
+        const int h  = static_cast<int>(get_u32(e + 4));
+        const SDL_Rect trim{ static_cast<int>(get_u32(e + 8)),  static_cast<int>(get_u32(e + 12)),
+                             static_cast<int>(get_u32(e + 16)), static_cast<int>(get_u32(e + 20)) };
+        const uint64_t offset = get_u64(e + 24);
+        const size_t row_bytes = static_cast<size_t>(trim.w) * 4;
+        if (w <= 0 || h <= 0 || trim.x < 0 || trim.y < 0 || trim.x + trim.w > w || trim.y + trim.h > h ||
+            offset + row_bytes * static_cast<size_t>(trim.h) > buf.size()) {
+            free_surfaces(surfaces);
+            return false;
+        }
+        SDL_Surface* s = SDL_CreateRGBSurfaceWithFormat(0, w, h, 32, SDL_PIXELFORMAT_RGBA8888);
+        if (!s) {
+            free_surfaces(surfaces);
+            return false;
+        }
+        std::memset(s->pixels, 0, static_cast<size_t>(s->pitch) * h);
+        const char* src = base + offset;
+        for (int y = 0; y < trim.h; ++y) {
+            Uint8* dst = static_cast<Uint8*>(s->pixels) + (trim.y + y) * s->pitch + trim.x * 4;
+            std::memcpy(dst, src, row_bytes);
+            src += row_bytes;
+        }
+        surfaces.push_back(s);
+    }
+    return true;
+}
+
+bool CacheManager::save_packed_sequence(const std::string& pack_file, const nlohmann::json& meta, const std::vector<SDL_Surface*>& surfaces) {
+    std::vector<SDL_Surface*> converted;
+    converted.reserve(surfaces.size());
+    for (SDL_Surface* s : surfaces) {
+        SDL_Surface* c = s ? to_rgba8888(s) : nullptr;
+        if (!c) {
+            free_surfaces(converted);
+            return false;
+        }
+        converted.push_back(c);
+    }
+
+    const std::string meta_text = meta.dump();
+    std::vector<char> buf;
+    buf.insert(buf.end(), kPackMagic, kPackMagic + sizeof(kPackMagic));
+    put_u32(buf, kPackVersion);
+    put_u32(buf, static_cast<uint32_t>(converted.size()));
+    put_u32(buf, static_cast<uint32_t>(meta_text.size()));
+    buf.insert(buf.end(), meta_text.begin(), meta_text.end());
+
+    std::vector<SDL_Rect> trims;
+    trims.reserve(converted.size());
+    uint64_t offset = buf.size() + converted.size() * kPackEntrySize;
+    for (SDL_Surface* s : converted) {
+        const SDL_Rect trim = opaque_bounds(s);
+        trims.push_back(trim);
+        put_u32(buf, static_cast<uint32_t>(s->w));
+        put_u32(buf, static_cast<uint32_t>(s->h));
+        put_u32(buf, static_cast<uint32_t>(trim.x));
+        put_u32(buf, static_cast<uint32_t>(trim.y));
+        put_u32(buf, static_cast<uint32_t>(trim.w));
+        put_u32(buf, static_cast<uint32_t>(trim.h));
+        put_u64(buf, offset);
+        offset += static_cast<uint64_t>(trim.w) * trim.h * 4;
+    }
+    for (size_t i = 0; i < converted.size(); ++i) {
+        SDL_Surface* s = converted[i];
+        const SDL_Rect& trim = trims[i];
+        for (int y = 0; y < trim.h; ++y) {
+            const char* row = static_cast<const char*>(s->pixels) + (trim.y + y) * s->pitch + trim.x * 4;
+            buf.insert(buf.end(), row, row + static_cast<size_t>(trim.w) * 4);
+        }
+    }
+    free_surfaces(converted);
+
+    // Write to a sibling file first so an interrupted save never leaves a truncated pack behind.
+    ensure_dirs_for(pack_file);
+    const std::string tmp = pack_file + ".tmp";
+    {
+        std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+        if (!out || !out.write(buf.data(), static_cast<std::streamsize>(buf.size()))) {
+            return false;
+        }
+    }
+    std::error_code ec;
+    fs::rename(tmp, pack_file, ec);
+    if (ec) {
+        fs::remove(tmp, ec);
+        return false;
+    }
+    return true;
+}
+
 SDL_Surface* CacheManager::load_and_scale_surface(const std::string& path, float scale, int& out_w, int& out_h) {
     out_w = 0; out_h = 0;
 
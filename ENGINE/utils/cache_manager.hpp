@@ -14,6 +14,15 @@ class CacheManager {
     static bool save_surface_as_png(SDL_Surface* surface, const std::string& path);
     static bool load_surface_sequence(const std::string& folder, int frame_count, std::vector<SDL_Surface*>& surfaces);
     static bool save_surface_sequence(const std::string& folder, const std::vector<SDL_Surface*>& surfaces);
+    // Packed sequence: one file holding the metadata block and every frame as
+    // alpha-trimmed RGBA8888 rows, read back with a single bulk read. The PNG
+    // sequence stays the export format and the fallback when the pack is stale.
+    static bool load_packed_sequence(const std::string& pack_file, nlohmann::json& out_meta, std::vector<SDL_Surface*>& surfaces);
+    static bool save_packed_sequence(const std::string& pack_file, const nlohmann::json& meta, const std::vector<SDL_Surface*>& surfaces);
+    // "size:mtime" of a source file, stored as "source_stamp" in pack metadata
+    // so a stale pack is detected without decoding the source. Empty if the
+    // file cannot be stat'ed.
+    static std::string source_stamp(const std::string& path);
     static SDL_Surface* load_and_scale_surface(const std::string& path, float scale, int& out_w, int& out_h);
     static SDL_Texture* surface_to_texture(SDL_Renderer* renderer, SDL_Surface* surface);
     static std::vector<SDL_Texture*> surfaces_to_textures(SDL_Renderer* renderer, const std::vector<SDL_Surface*>& surfaces);
@@ -0,0 +1,66 @@
+#include "fixed_step_clock.hpp"
+
+#include <algorithm>
+
+FixedStepClock::FixedStepClock(double tick_rate, int max_ticks_per_frame)
+: max_ticks_(std::max(1, max_ticks_per_frame)),
+  frequency_(std::max<Uint64>(1, SDL_GetPerformanceFrequency()))
+{
+        set_tick_rate(tick_rate);
+}
+
+void FixedStepClock::set_tick_rate(double hz) {
+        tick_rate_    = (hz > 0.0) ? hz : 24.0;
+        tick_seconds_ = 1.0 / tick_rate_;
+}
+
+void FixedStepClock::reset() {
+        accumulator_ = 0.0;
+        started_     = false;
+}
+
+double FixedStepClock::seconds_since(Uint64 from, Uint64 to) const {
+        return static_cast<double>(to - from) / static_cast<double>(frequency_);
+}
+
+void FixedStepClock::begin_frame() {
+        const Uint64 now = SDL_GetPerformanceCounter();
+        frame_start_ = now;
+        if (!started_) {
+                // The first frame runs one tick so there is a state to draw.
+                last_        = now;
+                accumulator_ = tick_seconds_;
+                started_     = true;
+                return;
+        }
+        accumulator_ += seconds_since(last_, now);
+        last_ = now;
+        accumulator_ = std::min(accumulator_, tick_seconds_ * max_ticks_);
+}
+
+bool FixedStepClock::consume_tick() {
+        if (accumulator_ < tick_seconds_) {
+                return false;
+        }
+        accumulator_ -= tick_seconds_;
+        return true;
+}
+
+float FixedStepClock::alpha() const {
+        return static_cast<float>(std::clamp(accumulator_ / tick_seconds_, 0.0, 1.0));
+}
+
+void FixedStepClock::end_frame() {
+        if (max_fps_ <= 0) {
+                return;
+        }
+        const double budget = 1.0 / static_cast<double>(max_fps_);
+        double elapsed = seconds_since(frame_start_, SDL_GetPerformanceCounter());
+        // SDL_Delay only has millisecond granularity; sleep the bulk of the
+        // remainder and spin the last couple of milliseconds.
+        if (budget - elapsed > 0.002) {
+                SDL_Delay(static_cast<Uint32>((budget - elapsed - 0.002) * 1000.0));
+        }
+        while (seconds_since(frame_start_, SDL_GetPerformanceCounter()) < budget) {
+        }
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <SDL.h>
+
+// Fixed-timestep frame clock. The simulation advances in whole ticks of
+// 1 / tick_rate seconds while rendering runs once per loop iteration:
+//
+//     clock.begin_frame();
+//     while (clock.consume_tick()) simulate();
+//     render(clock.alpha());
+//     clock.end_frame();
+//
+// alpha() is how far real time has moved into the next tick, so a render can
+// blend between the last two simulated states. Time is read from
+// SDL_GetPerformanceCounter. A long stall (debugger, window drag) is capped at
+// max_ticks_per_frame ticks so the loop does not spiral trying to catch up.
+class FixedStepClock {
+public:
+    explicit FixedStepClock(double tick_rate = 24.0, int max_ticks_per_frame = 5);
+
+    void   set_tick_rate(double hz);
+    double tick_rate() const { return tick_rate_; }
+    double tick_seconds() const { return tick_seconds_; }
+
+    // 0 leaves presentation uncapped (or paced by vsync).
+    void set_max_fps(int fps) { max_fps_ = fps > 0 ? fps : 0; }
+    int  max_fps() const { return max_fps_; }
+
+    void  reset();
+    void  begin_frame();
+    bool  consume_tick();
+    float alpha() const;
+    // Sleeps out the rest of the frame when max_fps is set.
+    void  end_frame();
+
+private:
+    double seconds_since(Uint64 from, Uint64 to) const;
+
+    double tick_rate_    = 24.0;
+    double tick_seconds_ = 1.0 / 24.0;
+    int    max_ticks_    = 5;
+    int    max_fps_      = 0;
+    double accumulator_  = 0.0;
+    Uint64 frequency_    = 1;
+    Uint64 last_         = 0;
+    Uint64 frame_start_  = 0;
+    bool   started_      = false;
+};
@@ -0,0 +1,193 @@
+#include "frame_profiler.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+#include <nlohmann/json.hpp>
+
+namespace {
+double percentile_of(std::vector<float>& samples, double pct) {
+    if (samples.empty()) return 0.0;
+    const std::size_t idx = std::min(samples.size() - 1,
+                                     static_cast<std::size_t>(pct * static_cast<double>(samples.size() - 1) + 0.5));
+    std::nth_element(samples.begin(), samples.begin() + static_cast<std::ptrdiff_t>(idx), samples.end());
+    return samples[idx];
+}
+}
+
+FrameProfiler& FrameProfiler::instance() {
+    static FrameProfiler profiler;
+    return profiler;
+}
+
+FrameProfiler::FrameProfiler()
+    : epoch_(Clock::now()),
+      frame_start_(epoch_),
+      frame_history_us_(kHistoryFrames, 0.0f) {
+    scopes_.reserve(32);
+}
+
+int FrameProfiler::register_scope(const char* name) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (std::size_t i = 0; i < scopes_.size(); ++i) {
+        if (scopes_[i].name == name || std::strcmp(scopes_[i].name, name) == 0) {
+            return static_cast<int>(i);
+        }
+    }
+    ScopeData data;
+    data.name = name;
+    data.history_us.assign(kHistoryFrames, 0.0f);
+    data.history_calls.assign(kHistoryFrames, 0);
+    scopes_.push_back(std::move(data));
+    return static_cast<int>(scopes_.size()) - 1;
+}
+
+FrameProfiler::ThreadBuffer& FrameProfiler::thread_buffer() {
+    thread_local ThreadBuffer* buffer = nullptr;
+    if (!buffer) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        buffers_.push_back(std::make_unique<ThreadBuffer>());
+        buffer = buffers_.back().get();
+        buffer->tid = static_cast<std::uint32_t>(buffers_.size() - 1);
+        buffer->events.reserve(256);
+    }
+    return *buffer;
+}
+
+void FrameProfiler::record(int id, Clock::time_point start, Clock::time_point end) {
+    using std::chrono::duration_cast;
+    using std::chrono::nanoseconds;
+    ThreadBuffer& buf = thread_buffer();
+    TraceEvent ev{ id,
+                   buf.tid,
+                   duration_cast<nanoseconds>(start - epoch_).count(),
+                   duration_cast<nanoseconds>(end - start).count() };
+
+    std::lock_guard<std::mutex> lock(buf.mutex);
+    // Without PROFILE_FRAME nothing drains the buffer; stop growing it.
+    if (buf.events.size() < kMaxTraceEvents) {
+        buf.events.push_back(ev);
+    }
+}
+
+void FrameProfiler::push_trace(const TraceEvent& ev) {
+    if (trace_.size() < kMaxTraceEvents) {
+        trace_.push_back(ev);
+    } else {
+        trace_[trace_cursor_] = ev;
+        trace_cursor_ = (trace_cursor_ + 1) % kMaxTraceEvents;
+    }
+}
+
+void FrameProfiler::new_frame() {
+    const Clock::time_point now = Clock::now();
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const std::unique_ptr<ThreadBuffer>& buf : buffers_) {
+        {
+            std::lock_guard<std::mutex> buf_lock(buf->mutex);
+            merge_scratch_.swap(buf->events);
+        }
+        for (const TraceEvent& ev : merge_scratch_) {
+            if (ev.scope < 0 || static_cast<std::size_t>(ev.scope) >= scopes_.size()) continue;
+            ScopeData& s = scopes_[static_cast<std::size_t>(ev.scope)];
+            s.frame_us += static_cast<double>(ev.dur_ns) / 1000.0;
+            ++s.frame_calls;
+            push_trace(ev);
+        }
+        merge_scratch_.clear();
+    }
+    if (frame_open_) {
+        const std::size_t slot = frame_cursor_;
+        frame_history_us_[slot] = static_cast<float>(std::chrono::duration<double, std::micro>(now - frame_start_).count());
+        for (ScopeData& s : scopes_) {
+            s.history_us[slot]    = static_cast<float>(s.frame_us);
+            s.history_calls[slot] = s.frame_calls;
+        }
+        frame_cursor_ = (frame_cursor_ + 1) % kHistoryFrames;
+        frame_count_  = std::min(frame_count_ + 1, kHistoryFrames);
+    }
+    for (ScopeData& s : scopes_) {
+        s.frame_us    = 0.0;
+        s.frame_calls = 0;
+    }
+    frame_start_ = now;
+    frame_open_  = true;
+}
+
+FrameProfiler::ScopeStats FrameProfiler::summarize(const char* name,
+                                                   const std::vector<float>& history_us,
+                                                   const std::vector<std::uint32_t>* calls,
+                                                   std::size_t count,
+                                                   std::size_t last) {
+    ScopeStats out;
+    out.name = name ? name : "";
+    if (count == 0) return out;
+    std::vector<float> samples(history_us.begin(), history_us.begin() + static_cast<std::ptrdiff_t>(count));
+    double sum = 0.0;
+    double call_sum = 0.0;
+    for (std::size_t i = 0; i < count; ++i) {
+        sum += samples[i];
+        if (calls) call_sum += (*calls)[i];
+    }
+    out.avg_ms  = sum / static_cast<double>(count) / 1000.0;
+    out.last_ms = history_us[last] / 1000.0;
+    out.calls   = calls ? call_sum / static_cast<double>(count) : 1.0;
+    out.p95_ms  = percentile_of(samples, 0.95) / 1000.0;
+    out.p99_ms  = percentile_of(samples, 0.99) / 1000.0;
+    return out;
+}
+
+std::vector<FrameProfiler::ScopeStats> FrameProfiler::snapshot() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<ScopeStats> out;
+    if (frame_count_ == 0) return out;
+    // The ring fills from slot 0, so until it wraps the first frame_count_ slots are the valid ones.
+    const std::size_t last = (frame_cursor_ + kHistoryFrames - 1) % kHistoryFrames;
+    out.reserve(scopes_.size() + 1);
+    out.push_back(summarize("Frame", frame_history_us_, nullptr, frame_count_, last));
+    for (const ScopeData& s : scopes_) {
+        ScopeStats stats = summarize(s.name, s.history_us, &s.history_calls, frame_count_, last);
+        if (stats.calls <= 0.0) continue;
+        out.push_back(std::move(stats));
+    }
+    return out;
+}
+
+std::size_t FrameProfiler::frames_recorded() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return frame_count_;
+}
+
+bool FrameProfiler::dump_chrome_trace(const std::string& path) const {
+    nlohmann::json events = nlohmann::json::array();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const std::size_t n = trace_.size();
+        for (std::size_t k = 0; k < n; ++k) {
+            const TraceEvent& ev = trace_[(trace_cursor_ + k) % n];
+            events.push_back({
+                { "name", scopes_[static_cast<std::size_t>(ev.scope)].name },
+                { "cat",  "frame" },
+                { "ph",   "X" },
+                { "ts",   static_cast<double>(ev.ts_ns) / 1000.0 },
+                { "dur",  static_cast<double>(ev.dur_ns) / 1000.0 },
+                { "pid",  0 },
+                { "tid",  ev.tid },
+            });
+        }
+    }
+    std::error_code ec;
+    const std::filesystem::path p(path);
+    if (p.has_parent_path()) std::filesystem::create_directories(p.parent_path(), ec);
+    std::ofstream out(path);
+    if (!out) {
+        std::cerr << "[FrameProfiler] Failed to open " << path << "\n";
+        return false;
+    }
+    out << nlohmann::json{ { "traceEvents", std::move(events) }, { "displayTimeUnit", "ms" } }.dump();
+    std::cout << "[FrameProfiler] Wrote trace to " << path << "\n";
+    return static_cast<bool>(out);
+}
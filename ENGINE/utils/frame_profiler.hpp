@@ -0,0 +1,126 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Per-frame scope timings. Each thread appends finished scopes to its own
+// buffer, so scopes recorded from worker threads do not contend with each
+// other. new_frame() drains every buffer, sums the time per scope for the
+// frame and commits those totals into a fixed ring per scope so the dev
+// overlay can show rolling averages and tail percentiles. Every scope instance
+// is also kept as a trace event (bounded ring) for dump_chrome_trace(), which
+// writes the Chrome/Perfetto trace-event format.
+//
+// Instrument code with PROFILE_SCOPE("Name") and mark frames with
+// PROFILE_FRAME(). Both expand to nothing unless VIBBLE_FRAME_PROFILER is
+// defined (CMake option ENABLE_FRAME_PROFILER, off by default).
+class FrameProfiler {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr std::size_t kHistoryFrames = 240;
+    static constexpr std::size_t kMaxTraceEvents = 1 << 16;
+
+    struct ScopeStats {
+        std::string name;
+        double      avg_ms   = 0.0;
+        double      p95_ms   = 0.0;
+        double      p99_ms   = 0.0;
+        double      last_ms  = 0.0;
+        double      calls    = 0.0;   // average calls per frame
+};
+
+    class Scope {
+    public:
+        explicit Scope(int id) : id_(id), start_(Clock::now()) {}
+        ~Scope() { FrameProfiler::instance().record(id_, start_, Clock::now()); }
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        int id_;
+        Clock::time_point start_;
+    };
+
+    static FrameProfiler& instance();
+
+    // Returns a stable id for the name; the pointer must outlive the profiler (string literal).
+    int register_scope(const char* name);
+    void record(int id, Clock::time_point start, Clock::time_point end);
+
+    // Closes the current frame (committing per-scope totals) and opens the next.
+    void new_frame();
+
+    // Frame total first, then scopes in registration order. Scopes with no
+    // samples in the history window are skipped.
+    std::vector<ScopeStats> snapshot() const;
+
+    // Writes the retained trace events as {"traceEvents":[...]}; returns false on I/O failure.
+    bool dump_chrome_trace(const std::string& path) const;
+
+    std::size_t frames_recorded() const;
+
+private:
+    FrameProfiler();
+
+    struct ScopeData {
+        const char* name = nullptr;
+        double      frame_us    = 0.0;
+        std::uint32_t frame_calls = 0;
+        std::vector<float> history_us;      // kHistoryFrames ring, indexed by frame
+        std::vector<std::uint32_t> history_calls;
+};
+
+    struct TraceEvent {
+        int           scope = -1;
+        std::uint32_t tid   = 0;
+        std::int64_t  ts_ns  = 0;
+        std::int64_t  dur_ns = 0;
+};
+
+    // Scopes a thread finished since the last new_frame(). Only the owning
+    // thread appends and only new_frame() drains, so the lock is uncontended
+    // outside the merge.
+    struct ThreadBuffer {
+        std::uint32_t tid = 0;
+        std::mutex    mutex;
+        std::vector<TraceEvent> events;
+};
+
+    static ScopeStats summarize(const char* name, const std::vector<float>& history_us,
+                                const std::vector<std::uint32_t>* calls, std::size_t count, std::size_t last);
+    ThreadBuffer& thread_buffer();
+    void push_trace(const TraceEvent& ev);
+
+    mutable std::mutex mutex_;
+    Clock::time_point epoch_;
+    Clock::time_point frame_start_;
+    bool frame_open_ = false;
+    std::vector<ScopeData> scopes_;
+    std::vector<float> frame_history_us_;
+    std::size_t frame_cursor_ = 0;
+    std::size_t frame_count_  = 0;
+    std::vector<TraceEvent> trace_;
+    std::size_t trace_cursor_ = 0;
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers_;
+    std::vector<TraceEvent> merge_scratch_;
+};
+
+#if defined(VIBBLE_FRAME_PROFILER)
+#define VIBBLE_PROFILE_CONCAT_INNER(a, b) a##b
+#define VIBBLE_PROFILE_CONCAT(a, b) VIBBLE_PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_SCOPE(name)                                                                          \
+    static const int VIBBLE_PROFILE_CONCAT(vibble_prof_id_, __LINE__) =                              \
+        FrameProfiler::instance().register_scope(name);                                              \
+    FrameProfiler::Scope VIBBLE_PROFILE_CONCAT(vibble_prof_scope_, __LINE__)(VIBBLE_PROFILE_CONCAT(vibble_prof_id_, __LINE__))
+#define PROFILE_FRAME() FrameProfiler::instance().new_frame()
+#else
+#define PROFILE_SCOPE(name) ((void)0)
+#define PROFILE_FRAME() ((void)0)
+#endif
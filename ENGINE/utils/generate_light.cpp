@@ -1,5 +1,6 @@
 #include "generate_light.hpp"
 #include "cache_manager.hpp"
+#include "light_kernel.hpp"
 #include <SDL.h>
 #include <SDL_image.h>
 #include <nlohmann/json.hpp>
@@ -53,7 +54,7 @@ SDL_Texture* GenerateLight::generate(SDL_Renderer* renderer,
 	const SDL_Color col = light.color;
 	const int intensity = std::clamp(light.intensity, 0, 255);
 	const int flare     = std::clamp(light.flare, 0, 100);
-	const int size = std::max(1, radius * 2);
+	const int size = LightKernel::size_for(radius);
 	SDL_Surface* surf = SDL_CreateRGBSurfaceWithFormat(0, size, size, 32, SDL_PIXELFORMAT_RGBA32);
 	if (!surf) {
 		std::cerr << "[GenerateLight] Failed to create surface: " << SDL_GetError() << "\n";
@@ -64,76 +65,25 @@ SDL_Texture* GenerateLight::generate(SDL_Renderer* renderer,
 		SDL_FreeSurface(surf);
 		return nullptr;
 	}
-	Uint32* pixels = static_cast<Uint32*>(surf->pixels);
-	SDL_PixelFormat* fmt = surf->format;
-        float falloff_norm = std::clamp(static_cast<float>(falloff) / 100.0f, 0.0f, 1.0f);
-        float falloff_ratio = 1.0f - falloff_norm;
-        float fade_exponent = 0.6f + 3.4f * falloff_norm;
-        float white_core_ratio  = 0.2f + falloff_ratio * 0.6f;
-        float white_core_radius = static_cast<float>(radius) * white_core_ratio;
 	std::mt19937 rng(std::random_device{}());
 	std::uniform_real_distribution<float> angle_dist(0.0f, 2.0f * float(M_PI));
 	std::uniform_real_distribution<float> spread_dist(0.2f, 0.6f);
 	std::uniform_int_distribution<int>    ray_count_dist(4, 7);
 	const int ray_count = ray_count_dist(rng);
-	std::vector<std::pair<float, float>> rays;
+	std::vector<LightRay> rays;
 	rays.reserve(ray_count);
 	for (int i = 0; i < ray_count; ++i) {
-		rays.emplace_back(angle_dist(rng), spread_dist(rng));
-	}
-	auto put_pixel = [&](int x, int y, Uint8 r, Uint8 g, Uint8 b, Uint8 a) {
-		pixels[y * size + x] = SDL_MapRGBA(fmt, r, g, b, a);
-};
-        float radius_f = static_cast<float>(radius);
-        float radius_sq = radius_f * radius_f;
-        float inv_radius = 1.0f / radius_f;
-        for (int y = 0; y < size; ++y) {
-                for (int x = 0; x < size; ++x) {
-                        float dx = x - radius + 0.5f;
-                        float dy = y - radius + 0.5f;
-                        float dist_sq = dx * dx + dy * dy;
-                        if (dist_sq > radius_sq) {
-                                        put_pixel(x, y, 0, 0, 0, 0);
-                                        continue;
-                        }
-                        float dist = std::sqrt(dist_sq);
-			float angle = std::atan2(dy, dx);
-			float ray_boost = 1.0f;
-			for (const auto& rs : rays) {
-					float ray_angle = rs.first;
-					float spread    = rs.second;
-					float diff = std::fabs(angle - ray_angle);
-					diff = std::fmod(diff + 2.0f * float(M_PI), 2.0f * float(M_PI));
-					if (diff > float(M_PI)) diff = 2.0f * float(M_PI) - diff;
-					if (diff < spread) {
-								float f = 1.0f - (diff / spread);
-								ray_boost += f * 0.05f;
-					}
-			}
-			ray_boost = std::clamp(ray_boost, 1.0f, 1.1f);
-                        float base_gradient = std::max(0.0f, 1.0f - (dist * inv_radius));
-                        float alpha_ratio  = std::pow(base_gradient, fade_exponent);
-			alpha_ratio = std::clamp(alpha_ratio * ray_boost, 0.0f, 1.0f);
-			Uint8 alpha = static_cast<Uint8>(std::min(255.0f, intensity * alpha_ratio * 1.6f));
-			SDL_Color final_color;
-			if (dist <= white_core_radius) {
-					final_color.r = static_cast<Uint8>((255 + col.r) / 2);
-					final_color.g = static_cast<Uint8>((255 + col.g) / 2);
-					final_color.b = static_cast<Uint8>((255 + col.b) / 2);
-					final_color.a = alpha;
-			} else {
-					float t = (dist - white_core_radius) / std::max(1e-6f, (radius - white_core_radius));
-					Uint8 core_r = static_cast<Uint8>((255 + col.r) / 2);
-					Uint8 core_g = static_cast<Uint8>((255 + col.g) / 2);
-					Uint8 core_b = static_cast<Uint8>((255 + col.b) / 2);
-					final_color.r = static_cast<Uint8>((1.0f - t) * core_r + t * col.r);
-					final_color.g = static_cast<Uint8>((1.0f - t) * core_g + t * col.g);
-					final_color.b = static_cast<Uint8>((1.0f - t) * core_b + t * col.b);
-					final_color.a = alpha;
-			}
-			put_pixel(x, y, final_color.r, final_color.g, final_color.b, final_color.a);
-		}
+		LightRay ray;
+		ray.angle  = angle_dist(rng);
+		ray.spread = spread_dist(rng);
+		rays.push_back(ray);
 	}
+	LightKernelParams params;
+	params.radius    = radius;
+	params.falloff   = falloff;
+	params.intensity = intensity;
+	params.color     = col;
+	LightKernel::render(params, rays, static_cast<Uint8*>(surf->pixels), surf->pitch);
 	SDL_UnlockSurface(surf);
 	SDL_Texture* tex = SDL_CreateTextureFromSurface(renderer, surf);
 	if (!tex) {
@@ -0,0 +1,120 @@
+#include "job_pool.hpp"
+
+#include <algorithm>
+#include <exception>
+#include <iostream>
+
+JobPool::JobPool(unsigned threads) {
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    slices_ = std::make_unique<Slice[]>(threads);
+    workers_.reserve(threads - 1);
+    for (unsigned i = 1; i < threads; ++i) {
+        workers_.emplace_back([this, i]() { worker_main(i); });
+    }
+}
+
+JobPool::~JobPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    wake_.notify_all();
+    for (std::thread& t : workers_) {
+        if (t.joinable()) t.join();
+    }
+}
+
+JobPool& JobPool::shared() {
+    static JobPool pool;
+    return pool;
+}
+
+void JobPool::parallel_for(std::size_t count, std::size_t grain, const RangeFn& body) {
+    if (count == 0) {
+        return;
+    }
+    grain = std::max<std::size_t>(1, grain);
+    const unsigned threads = thread_count();
+    if (threads == 1 || count <= grain) {
+        body(0, count);
+        return;
+    }
+
+    const std::size_t per = count / threads;
+    const std::size_t extra = count % threads;
+    std::size_t begin = 0;
+    for (unsigned i = 0; i < threads; ++i) {
+        const std::size_t len = per + (i < extra ? 1 : 0);
+        slices_[i].next.store(begin, std::memory_order_relaxed);
+        slices_[i].end = begin + len;
+        begin += len;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        body_  = &body;
+        grain_ = grain;
+        busy_  = threads - 1;
+        ++generation_;
+    }
+    wake_.notify_all();
+
+    run_slices(0);
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_.wait(lock, [this]() { return busy_ == 0; });
+    body_ = nullptr;
+}
+
+void JobPool::worker_main(unsigned index) {
+    std::uint64_t seen = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            wake_.wait(lock, [&]() { return stop_ || generation_ != seen; });
+            if (stop_) {
+                return;
+            }
+            seen = generation_;
+        }
+        run_slices(index);
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            --busy_;
+        }
+        done_.notify_one();
+    }
+}
+
+bool JobPool::take_chunk(Slice& slice, std::size_t& begin, std::size_t& end) {
+    if (slice.next.load(std::memory_order_relaxed) >= slice.end) {
+        return false;
+    }
+    begin = slice.next.fetch_add(grain_, std::memory_order_relaxed);
+    if (begin >= slice.end) {
+        return false;
+    }
+    end = std::min(begin + grain_, slice.end);
+    return true;
+}
+
+void JobPool::run_slices(unsigned self) {
+    const unsigned threads = thread_count();
+    const RangeFn& body = *body_;
+    for (unsigned k = 0; k < threads; ++k) {
+        Slice& slice = slices_[(self + k) % threads];
+        std::size_t begin = 0;
+        std::size_t end = 0;
+        while (take_chunk(slice, begin, end)) {
+            try {
+                body(begin, end);
+            } catch (const std::exception& e) {
+                std::cerr << "[JobPool] Job threw: " << e.what() << "\n";
+            } catch (...) {
+                std::cerr << "[JobPool] Job threw an unknown exception\n";
+            }
+        }
+    }
+}
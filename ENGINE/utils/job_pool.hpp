@@ -0,0 +1,62 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Persistent worker pool for data-parallel loops that run every frame, where
+// spawning threads per call (as the light kernel does for one-off bakes)
+// would cost more than the work.
+//
+// parallel_for splits [0, count) into one contiguous slice per participating
+// thread (the caller included). Each thread takes grain-sized chunks from the
+// front of its own slice and, once that is drained, steals chunks from the
+// other slices, so uneven per-item cost still balances. The call returns when
+// every item has run. Bodies must not call parallel_for themselves.
+class JobPool {
+public:
+    using RangeFn = std::function<void(std::size_t begin, std::size_t end)>;
+
+    // 0 threads means one per hardware thread.
+    explicit JobPool(unsigned threads = 0);
+    ~JobPool();
+
+    JobPool(const JobPool&) = delete;
+    JobPool& operator=(const JobPool&) = delete;
+
+    static JobPool& shared();
+
+    // Threads that take part in a parallel_for, counting the caller.
+    unsigned thread_count() const { return static_cast<unsigned>(workers_.size()) + 1u; }
+
+    void parallel_for(std::size_t count, std::size_t grain, const RangeFn& body);
+
+private:
+    struct alignas(64) Slice {
+        std::atomic<std::size_t> next{0};
+        std::size_t end = 0;
+};
+
+    void worker_main(unsigned index);
+    void run_slices(unsigned self);
+    bool take_chunk(Slice& slice, std::size_t& begin, std::size_t& end);
+
+    std::vector<std::thread> workers_;
+    std::unique_ptr<Slice[]> slices_;
+
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+    std::uint64_t generation_ = 0;
+    unsigned busy_ = 0;
+    bool stop_ = false;
+
+    const RangeFn* body_ = nullptr;
+    std::size_t grain_ = 1;
+};
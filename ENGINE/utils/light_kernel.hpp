@@ -0,0 +1,33 @@
+#pragma once
+
+#include <SDL.h>
+#include <vector>
+
+// One flare ray of a generated light: pixels within `spread` radians of
+// `angle` get up to +5% alpha per ray (total boost capped at +10%).
+struct LightRay {
+    float angle  = 0.0f;
+    float spread = 0.0f;
+};
+
+struct LightKernelParams {
+    int       radius    = 0;
+    int       falloff   = 0;     // 0..100
+    int       intensity = 0;     // 0..255
+    SDL_Color color{ 255, 255, 255, 255 };
+};
+
+// Pixel kernel behind GenerateLight. Rows are independent and are split over
+// worker threads; per pixel the ray boost comes from a 1D angular table and
+// the alpha curve from a falloff table instead of per-ray fmod and pow, and
+// pixels are written as packed R,G,B,A bytes (SDL_PIXELFORMAT_RGBA32).
+// Output does not depend on the worker count.
+namespace LightKernel {
+    // Side length of the square light image for a radius.
+    int size_for(int radius);
+
+    // Fills size_for(radius) rows of `pitch` bytes starting at `rgba`.
+    // workers == 0 picks one per hardware thread.
+    void render(const LightKernelParams& params, const std::vector<LightRay>& rays,
+                Uint8* rgba, int pitch, unsigned workers = 0);
+}
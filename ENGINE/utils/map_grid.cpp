@@ -68,26 +68,101 @@ MapGrid::Point* MapGrid::get_nearest_point(SDL_Point p) {
     return nullptr;
 }
 
-MapGrid::Point* MapGrid::get_rnd_point_in_area(const Area& area, std::mt19937& rng) {
-    if (free_count_ <= 0) return nullptr;
-    std::vector<int> candidates;
-    candidates.reserve(grid_.size());
+void MapGrid::rasterize(const Area& area, std::vector<std::uint8_t>& inside) const {
+    inside.assign(grid_.size(), 0);
+    const std::vector<SDL_Point>& pts = area.get_points();
+    const std::size_t n = pts.size();
+    if (n == 0 || grid_.empty()) return;
+    if (n < 3) {
+        for (std::size_t i = 0; i < grid_.size(); ++i) {
+            inside[i] = area.contains_point(grid_[i].pos) ? 1 : 0;
+        }
+        return;
+    }
+
+    auto [minx, miny, maxx, maxy] = area.get_bounds();
+    const int row0 = std::max(0, (miny - origin_.y) / spacing_ - 1);
+    const int row1 = std::min(rows_ - 1, (maxy - origin_.y) / spacing_ + 1);
+    auto col_at_or_after = [&](double x) {
+        return std::clamp(static_cast<int>(std::ceil((x - origin_.x) / spacing_)), 0, cols_);
+};
+
+    // One pass per row: sorted edge crossings give the spans whose cells pass
+    // the even-odd test. Cells within a unit of a crossing are settled with
+    // contains_point so rounding at the boundary matches it exactly.
+    std::vector<double> xs;
+    for (int iy = row0; iy <= row1; ++iy) {
+        const int y = origin_.y + iy * spacing_;
+        if (y < miny || y > maxy) continue;
+        xs.clear();
+        for (std::size_t i = 0, j = n - 1; i < n; j = i++) {
+            const double yi = pts[i].y;
+            const double yj = pts[j].y;
+            if ((yi > y) == (yj > y)) continue;
+            xs.push_back((pts[j].x - pts[i].x) * (y - yi) / (yj - yi) + pts[i].x);
+        }
+        std::sort(xs.begin(), xs.end());
+        std::uint8_t* row = inside.data() + static_cast<std::size_t>(iy) * cols_;
+        for (std::size_t k = 0; k + 1 < xs.size(); k += 2) {
+            const int c0 = col_at_or_after(std::max<double>(xs[k], minx));
+            const int c1 = col_at_or_after(std::min<double>(xs[k + 1], maxx + 1));
+            for (int ix = c0; ix < c1; ++ix) row[ix] = 1;
+        }
+        for (double x : xs) {
+            const int c0 = col_at_or_after(x - 1.0);
+            const int c1 = col_at_or_after(x + 1.0);
+            for (int ix = c0; ix <= std::min(c1, cols_ - 1); ++ix) {
+                row[ix] = area.contains_point(grid_[idx(ix, iy)].pos) ? 1 : 0;
+            }
+        }
+    }
+}
+
+MapGrid::AreaCells& MapGrid::cells_for(const Area& area) {
+    const std::vector<SDL_Point>& pts = area.get_points();
+    auto same_outline = [&pts](const AreaCells& c) {
+        return c.outline.size() == pts.size() &&
+               std::equal(pts.begin(), pts.end(), c.outline.begin(),
+                          [](const SDL_Point& a, const SDL_Point& b) { return a.x == b.x && a.y == b.y; });
+};
+    for (auto& c : area_cells_) {
+        if (same_outline(c)) return c;
+    }
+    if (area_cells_.size() >= kMaxAreaCaches) area_cells_.erase(area_cells_.begin());
+
+    AreaCells cells;
+    cells.outline = pts;
+    std::vector<std::uint8_t> inside;
+    rasterize(area, inside);
+    cells.slot.assign(grid_.size(), kOutside);
     for (int i = 0; i < static_cast<int>(grid_.size()); ++i) {
-        if (!grid_[i].occupied && area.contains_point(grid_[i].pos)) {
-            candidates.push_back(i);
+        if (!inside[i]) continue;
+        if (grid_[i].occupied) {
+            cells.slot[i] = kTaken;
+        } else {
+            cells.slot[i] = static_cast<int>(cells.free.size());
+            cells.free.push_back(i);
         }
     }
-    if (candidates.empty()) return nullptr;
-    std::uniform_int_distribution<int> pick(0, static_cast<int>(candidates.size()) - 1);
-    return &grid_[candidates[pick(rng)]];
+    area_cells_.push_back(std::move(cells));
+    return area_cells_.back();
+}
+
+MapGrid::Point* MapGrid::get_rnd_point_in_area(const Area& area, std::mt19937& rng) {
+    if (free_count_ <= 0) return nullptr;
+    const AreaCells& cells = cells_for(area);
+    if (cells.free.empty()) return nullptr;
+    std::uniform_int_distribution<int> pick(0, static_cast<int>(cells.free.size()) - 1);
+    return &grid_[cells.free[pick(rng)]];
 }
 
 std::vector<MapGrid::Point*> MapGrid::get_all_points_in_area(const Area& area) const {
     std::vector<Point*> out;
-    out.reserve(grid_.size());
+    std::vector<std::uint8_t> inside;
+    rasterize(area, inside);
     for (int i = 0; i < static_cast<int>(grid_.size()); ++i) {
         const auto& pt = grid_[i];
-        if (!pt.occupied && area.contains_point(pt.pos)) out.push_back(const_cast<Point*>(&pt));
+        if (inside[i] && !pt.occupied) out.push_back(const_cast<Point*>(&pt));
     }
     return out;
 }
@@ -96,7 +171,24 @@ void MapGrid::set_occupied(Point* pt, bool occ) {
     if (!pt) return;
     const bool was = pt->occupied;
     pt->occupied = occ;
-    if (was != occ) free_count_ += occ ? -1 : 1;
+    if (was == occ) return;
+    free_count_ += occ ? -1 : 1;
+    const std::ptrdiff_t i = pt - grid_.data();
+    if (i < 0 || i >= static_cast<std::ptrdiff_t>(grid_.size())) return;
+    for (auto& c : area_cells_) {
+        int& s = c.slot[i];
+        if (s == kOutside) continue;
+        if (occ) {
+            const int last = c.free.back();
+            c.free[s] = last;
+            c.slot[last] = s;
+            c.free.pop_back();
+            s = kTaken;
+        } else {
+            s = static_cast<int>(c.free.size());
+            c.free.push_back(static_cast<int>(i));
+        }
+    }
 }
 
 MapGrid::Point* MapGrid::point_at(SDL_Point p) {
@@ -2,6 +2,7 @@
 
 #include <vector>
 #include <random>
+#include <cstdint>
 #include <SDL.h>
 #include "utils/area.hpp"
 
@@ -20,10 +21,16 @@ public:
 
     Point* get_nearest_point(SDL_Point p);
 
+    // Uniform pick among the free grid points inside area. The first call for
+    // an area rasterizes it onto the grid and caches its free cells; later
+    // calls are O(1) and set_occupied keeps every cached list current.
     Point* get_rnd_point_in_area(const Area& area, std::mt19937& rng);
 
+    // Free grid points inside area, in row-major grid order.
     std::vector<Point*> get_all_points_in_area(const Area& area) const;
 
+    // Only mark points through here (or set_occupied_at) so the per-area
+    // free lists stay in sync with Point::occupied.
     void set_occupied(Point* pt, bool occ = true);
 
     void set_occupied_at(SDL_Point p, bool occ = true);
@@ -42,6 +49,22 @@ private:
     int free_count_ = 0;
     std::vector<Point> grid_;
 
+    // Free in-area cells of one area, matched by the area's vertices since
+    // areas are passed by reference and may be rebuilt between calls.
+    // slot[i] is cell i's position in free, or kOutside / kTaken.
+    struct AreaCells {
+        std::vector<SDL_Point> outline;
+        std::vector<int> free;
+        std::vector<int> slot;
+};
+    static constexpr int kOutside = -1;
+    static constexpr int kTaken   = -2;
+    static constexpr std::size_t kMaxAreaCaches = 8;
+    std::vector<AreaCells> area_cells_;
+
+    void rasterize(const Area& area, std::vector<std::uint8_t>& inside) const;
+    AreaCells& cells_for(const Area& area);
+
     inline bool in_bounds_idx(int ix, int iy) const {
         return ix >= 0 && ix < cols_ && iy >= 0 && iy < rows_;
     }
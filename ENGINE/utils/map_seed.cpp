@@ -0,0 +1,26 @@
+#include "map_seed.hpp"
+
+#include <random>
+
+namespace {
+std::uint64_t splitmix64(std::uint64_t x) {
+    x += 0x9e3779b97f4a7c15ull;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+    return x ^ (x >> 31);
+}
+}
+
+std::uint32_t map_seed::random() {
+    return static_cast<std::uint32_t>(std::random_device{}());
+}
+
+std::uint32_t map_seed::derive(std::uint32_t seed, std::string_view stream, std::uint64_t index) {
+    std::uint64_t h = 0xcbf29ce484222325ull;
+    for (char c : stream) {
+        h ^= static_cast<unsigned char>(c);
+        h *= 0x100000001b3ull;
+    }
+    const std::uint64_t mixed = splitmix64(splitmix64(seed ^ h) + index);
+    return static_cast<std::uint32_t>(mixed ^ (mixed >> 32));
+}
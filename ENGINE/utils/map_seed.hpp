@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+// Seeds for map generation. Everything that draws random numbers while a map
+// is built (room placement, area shapes, trails, spawn planning and spawning)
+// is seeded from one map seed, so the same seed rebuilds the same map. Each
+// consumer takes its own sub-seed via derive() so adding draws in one place
+// does not shift every stream after it.
+namespace map_seed {
+    // Non-deterministic seed for maps that do not pin one.
+    std::uint32_t random();
+
+    // Independent sub-seed for a named stream, e.g. derive(seed, "room", 3).
+    std::uint32_t derive(std::uint32_t seed, std::string_view stream, std::uint64_t index = 0);
+}
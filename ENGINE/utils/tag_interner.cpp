@@ -0,0 +1,74 @@
+#include "tag_interner.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <iostream>
+
+TagInterner& TagInterner::instance() {
+    static TagInterner interner;
+    return interner;
+}
+
+TagId TagInterner::intern(const std::string& tag) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = ids_.find(tag);
+    if (it != ids_.end()) {
+        return it->second;
+    }
+    if (names_.size() >= kMaxInternedTags) {
+        if (!overflow_reported_) {
+            std::cerr << "[TagInterner] Tag table full (" << kMaxInternedTags
+                      << "); '" << tag << "' falls back to string matching\n";
+            overflow_reported_ = true;
+        }
+        return kInvalidTagId;
+    }
+    const TagId id = static_cast<TagId>(names_.size());
+    std::string lower = tag;
+    std::transform(lower.begin(), lower.end(), lower.begin(), [](unsigned char ch) {
+        return static_cast<char>(std::tolower(ch));
+    });
+    names_.push_back(tag);
+    lower_names_.push_back(std::move(lower));
+    ids_.emplace(tag, id);
+    return id;
+}
+
+TagId TagInterner::find(const std::string& tag) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = ids_.find(tag);
+    return it == ids_.end() ? kInvalidTagId : it->second;
+}
+
+std::string TagInterner::name(TagId id) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (id >= names_.size()) {
+        return std::string{};
+    }
+    return names_[id];
+}
+
+std::size_t TagInterner::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return names_.size();
+}
+
+TagMask TagInterner::known_mask() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    TagMask out;
+    for (std::size_t i = 0; i < names_.size(); ++i) {
+        out.set(i);
+    }
+    return out;
+}
+
+TagMask TagInterner::mask_matching_substring(const std::string& needle_lower) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    TagMask out;
+    for (std::size_t i = 0; i < lower_names_.size(); ++i) {
+        if (lower_names_[i].find(needle_lower) != std::string::npos) {
+            out.set(i);
+        }
+    }
+    return out;
+}
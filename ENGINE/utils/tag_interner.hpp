@@ -0,0 +1,83 @@
+#pragma once
+
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using TagId = std::uint16_t;
+
+constexpr std::size_t kMaxInternedTags = 256;
+constexpr TagId kInvalidTagId = std::numeric_limits<TagId>::max();
+
+using TagMask = std::bitset<kMaxInternedTags>;
+
+// Process-wide table mapping tag strings to small dense ids so tag sets can be
+// matched with bitmask ANDs instead of string compares. Strings are interned
+// verbatim; callers that want case-insensitive matching normalize first.
+class TagInterner {
+public:
+    static TagInterner& instance();
+
+    // Returns kInvalidTagId once the table holds kMaxInternedTags entries.
+    TagId intern(const std::string& tag);
+    TagId find(const std::string& tag) const;
+    std::string name(TagId id) const;
+    std::size_t size() const;
+
+    // Sets the bit for every tag in the range. Returns false when at least one
+    // tag could not be interned, in which case callers must fall back to strings.
+    template <typename Range>
+    bool build_mask(const Range& tags, TagMask& out) {
+        out.reset();
+        bool complete = true;
+        for (const auto& tag : tags) {
+            const TagId id = intern(tag);
+            if (id == kInvalidTagId) {
+                complete = false;
+                continue;
+            }
+            out.set(id);
+        }
+        return complete;
+    }
+
+    // Lookup-only counterpart of build_mask for filters built from user input:
+    // sets the bit of every tag already in the table and never adds entries.
+    // Returns how many tags were not found.
+    template <typename Range>
+    std::size_t find_mask(const Range& tags, TagMask& out) const {
+        out.reset();
+        std::size_t missing = 0;
+        for (const auto& tag : tags) {
+            const TagId id = find(tag);
+            if (id == kInvalidTagId) {
+                ++missing;
+                continue;
+            }
+            out.set(id);
+        }
+        return missing;
+    }
+
+    // A bit for every id handed out so far.
+    TagMask known_mask() const;
+
+    // Mask of every interned tag whose lowercase name contains needle_lower.
+    TagMask mask_matching_substring(const std::string& needle_lower) const;
+
+private:
+    TagInterner() = default;
+    TagInterner(const TagInterner&) = delete;
+    TagInterner& operator=(const TagInterner&) = delete;
+
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, TagId> ids_;
+    std::vector<std::string> names_;
+    std::vector<std::string> lower_names_;
+    bool overflow_reported_ = false;
+};
@@ -0,0 +1,279 @@
+// Headless map-generation benchmark. Loads a map directory's map_info.json and
+// runs the same GenerateRooms::build the engine runs (room layout and room
+// spawning, trails, map-boundary spawning) without a window or renderer, then
+// prints per-stage wall time and asset counts. The first run also fires rays
+// from every room centre and times TrailGeometry::compute_edge_point against
+// the original one-pixel march it replaced.
+//
+// Usage: mapgen_bench [map_dir] [--seed N] [--runs N] [--workers N] [--verbose]
+// Run from the repository root (asset definitions are read from SRC/). Every
+// run uses the same seed. Without --workers the first run spawns rooms on one
+// thread and later runs on every hardware thread. The layout digest of each
+// run is printed and the bench exits non-zero if any run differs from the
+// first, or if more than 1%
+// of edge points land over 2 px from the march.
+
+#include "asset/Asset.hpp"
+#include "asset/asset_library.hpp"
+#include "map_generation/generate_rooms.hpp"
+#include "map_generation/room.hpp"
+#include "map_generation/trail_geometry.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct EdgeResult {
+    std::size_t rays   = 0;
+    std::size_t off    = 0;
+    int worst_px       = 0;
+    double march_ms    = 0.0;
+    double analytic_ms = 0.0;
+};
+
+struct RunResult {
+    GenerateRooms::BuildStats stats;
+    std::size_t room_assets  = 0;
+    std::size_t trail_assets = 0;
+    std::uint64_t digest     = 0;
+    EdgeResult edges;
+};
+
+class Digest {
+public:
+    void add(std::int64_t v) {
+        std::uint64_t x = static_cast<std::uint64_t>(v);
+        for (int i = 0; i < 8; ++i) {
+            hash_ ^= (x & 0xffu);
+            hash_ *= 0x100000001b3ull;
+            x >>= 8;
+        }
+    }
+    void add(const std::string& s) {
+        for (unsigned char c : s) {
+            hash_ ^= c;
+            hash_ *= 0x100000001b3ull;
+        }
+        add(static_cast<std::int64_t>(s.size()));
+    }
+    std::uint64_t value() const { return hash_; }
+
+private:
+    std::uint64_t hash_ = 0xcbf29ce484222325ull;
+};
+
+bool load_map_info(const std::string& path, nlohmann::json& out) {
+    std::ifstream in(path);
+    if (!in) {
+        std::fprintf(stderr, "[mapgen_bench] Failed to open %s\n", path.c_str());
+        return false;
+    }
+    try {
+        in >> out;
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "[mapgen_bench] Bad JSON in %s: %s\n", path.c_str(), e.what());
+        return false;
+    }
+    return true;
+}
+
+// compute_edge_point as it was before Area::ray_hit_distance: step out one
+// pixel at a time until the area stops containing the sample.
+SDL_Point march_edge_point(const SDL_Point& center, const SDL_Point& toward, const Area* area) {
+    const double dx = toward.x - center.x;
+    const double dy = toward.y - center.y;
+    const double len = std::hypot(dx, dy);
+    if (len <= 0.0) return center;
+    SDL_Point edge = center;
+    for (int i = 1; i <= 2000; ++i) {
+        const SDL_Point p{ static_cast<int>(std::lround(center.x + dx / len * i)),
+                           static_cast<int>(std::lround(center.y + dy / len * i)) };
+        if (!area->contains_point(p)) break;
+        edge = p;
+    }
+    return edge;
+}
+
+// Rays from each room centre toward every other room and around a full turn.
+EdgeResult compare_edge_points(const std::vector<std::unique_ptr<Room>>& rooms) {
+    constexpr int kTurnRays = 360;
+    std::vector<std::pair<const Room*, SDL_Point>> rays;
+    for (const auto& room : rooms) {
+        if (!room || !room->room_area || room->type == "trail") continue;
+        const SDL_Point c = room->room_area->get_center();
+        for (const auto& other : rooms) {
+            if (!other || other == room || !other->room_area || other->type == "trail") continue;
+            rays.emplace_back(room.get(), other->room_area->get_center());
+        }
+        for (int k = 0; k < kTurnRays; ++k) {
+            const double a = 2.0 * M_PI * k / kTurnRays;
+            rays.emplace_back(room.get(), SDL_Point{ c.x + static_cast<int>(std::lround(4000.0 * std::cos(a))),
+                                                     c.y + static_cast<int>(std::lround(4000.0 * std::sin(a))) });
+        }
+    }
+    EdgeResult result;
+    result.rays = rays.size();
+    std::vector<SDL_Point> marched(rays.size());
+    std::vector<SDL_Point> analytic(rays.size());
+    auto t0 = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < rays.size(); ++i) {
+        const Area* area = rays[i].first->room_area.get();
+        marched[i] = march_edge_point(area->get_center(), rays[i].second, area);
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < rays.size(); ++i) {
+        const Area* area = rays[i].first->room_area.get();
+        analytic[i] = TrailGeometry::compute_edge_point(area->get_center(), rays[i].second, area);
+    }
+    auto t2 = std::chrono::steady_clock::now();
+    result.march_ms    = std::chrono::duration<double, std::milli>(t1 - t0).count();
+    result.analytic_ms = std::chrono::duration<double, std::milli>(t2 - t1).count();
+    for (std::size_t i = 0; i < rays.size(); ++i) {
+        const int d = std::max(std::abs(marched[i].x - analytic[i].x), std::abs(marched[i].y - analytic[i].y));
+        result.worst_px = std::max(result.worst_px, d);
+        if (d > 2) ++result.off;
+    }
+    return result;
+}
+
+// One full generation from a fresh copy of map_info.json (rooms write back
+// into their room data while they are built).
+bool run_once(const std::string& map_dir, AssetLibrary& library, std::uint32_t seed, unsigned workers, bool edges, RunResult& result) {
+    const std::string info_path = map_dir + "/map_info.json";
+    nlohmann::json info;
+    if (!load_map_info(info_path, info)) return false;
+
+    const double map_radius = info.value("map_radius", 0.0);
+    const int center = static_cast<int>(map_radius);
+    auto section = [&info](const char* key) -> nlohmann::json& {
+        nlohmann::json& j = info[key];
+        if (!j.is_object()) j = nlohmann::json::object();
+        return j;
+};
+    nlohmann::json& assets_data   = section("map_assets_data");
+    nlohmann::json& boundary_data = section("map_boundary_data");
+    nlohmann::json& rooms_data    = section("rooms_data");
+    nlohmann::json& trails_data   = section("trails_data");
+
+    GenerateRooms generator(load_layer_specs(info), center, center, map_dir, info_path, seed);
+    generator.set_spawn_workers(workers);
+    std::vector<std::unique_ptr<Room>> rooms = generator.build(&library, map_radius, boundary_data, rooms_data, trails_data, assets_data);
+    result.stats = generator.last_build_stats();
+
+    Digest digest;
+    for (const auto& room : rooms) {
+        digest.add(room->room_name);
+        digest.add(room->type);
+        if (room->room_area) {
+            for (const SDL_Point& p : room->room_area->get_points()) {
+                digest.add(p.x);
+                digest.add(p.y);
+            }
+        }
+        std::size_t& count = (room->type == "trail") ? result.trail_assets : result.room_assets;
+        count += room->assets.size();
+        for (const auto& asset : room->assets) {
+            if (!asset) continue;
+            digest.add(asset->info ? asset->info->name : std::string{});
+            digest.add(asset->pos.x);
+            digest.add(asset->pos.y);
+            digest.add(asset->flipped ? 1 : 0);
+        }
+    }
+    result.digest = digest.value();
+    if (edges) result.edges = compare_edge_points(rooms);
+    return true;
+}
+
+}
+
+int main(int argc, char** argv) {
+    std::string map_dir = "MAPS/FORREST";
+    std::uint32_t seed = 1;
+    int runs = 3;
+    int workers = -1;
+    bool verbose = false;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = static_cast<std::uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--runs") == 0 && i + 1 < argc) {
+            runs = std::max(1, std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--workers") == 0 && i + 1 < argc) {
+            workers = std::max(0, std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--verbose") == 0) {
+            verbose = true;
+        } else {
+            map_dir = argv[i];
+        }
+    }
+
+    // Generation logs every spawn; keep the report readable unless asked.
+    std::ostringstream sink;
+    std::streambuf* cout_buf = std::cout.rdbuf();
+    if (!verbose) std::cout.rdbuf(sink.rdbuf());
+
+    const auto lib_start = std::chrono::steady_clock::now();
+    AssetLibrary library;
+    const double lib_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - lib_start).count();
+    std::printf("map %s  seed %u  asset library %zu infos in %.2f ms\n", map_dir.c_str(), seed, library.all().size(), lib_ms);
+
+    int failures = 0;
+    std::uint64_t first_digest = 0;
+    for (int r = 0; r < runs; ++r) {
+        sink.str(std::string{});
+        RunResult result;
+        const unsigned run_workers = (workers >= 0) ? static_cast<unsigned>(workers) : (r == 0 ? 1u : 0u);
+        if (!run_once(map_dir, library, seed, run_workers, r == 0, result)) {
+            std::cout.rdbuf(cout_buf);
+            return 1;
+        }
+        const GenerateRooms::BuildStats& s = result.stats;
+        std::printf("run %d  layout %8.2f ms  room spawn %8.2f ms (%u threads)  trails %8.2f ms  trail spawn %8.2f ms  boundary %8.2f ms"
+                    "  | rooms %zu trails %zu  assets room %zu trail %zu (boundary %zu)  digest %016llx\n",
+                    r + 1,
+                    s.rooms_ms - s.rooms_spawn_ms,
+                    s.rooms_spawn_ms,
+                    s.spawn_workers,
+                    s.trails_ms - s.trails_spawn_ms,
+                    s.trails_spawn_ms,
+                    s.boundary_ms,
+                    s.rooms,
+                    s.trails,
+                    result.room_assets,
+                    result.trail_assets,
+                    s.boundary_assets,
+                    static_cast<unsigned long long>(result.digest));
+        if (r == 0) {
+            const EdgeResult& e = result.edges;
+            std::printf("edge points  %zu rays  march %8.2f ms  analytic %8.2f ms  | %zu over 2 px (worst %d px)\n",
+                        e.rays, e.march_ms, e.analytic_ms, e.off, e.worst_px);
+            if (e.off * 100 > e.rays) {
+                std::fprintf(stderr, "[mapgen_bench] %zu of %zu edge points differ from the march by more than 2 px\n", e.off, e.rays);
+                ++failures;
+            }
+            first_digest = result.digest;
+        } else if (result.digest != first_digest) {
+            ++failures;
+        }
+    }
+    std::cout.rdbuf(cout_buf);
+    if (failures > 0) {
+        std::fprintf(stderr, "[mapgen_bench] %d run(s) differ from the first with seed %u\n", failures, seed);
+        return 1;
+    }
+    return 0;
+}
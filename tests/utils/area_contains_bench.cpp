@@ -0,0 +1,221 @@
+// Micro-benchmark for Area point-in-polygon queries. Builds the room polygons of
+// MAPS/FORREST the same way the map generator does, then compares the original
+// per-point loop against Area::contains_point and Area::contains_points.
+//
+// Usage: area_contains_bench [map_info.json] [--quick]
+// Exits non-zero if contains_point and contains_points disagree, or if either
+// disagrees with the reference loop for a point that is not exactly on an edge
+// (the reference divides by dy + 1e-12, so on-edge results may legitimately
+// differ from the exact edge-table test). Also checks that ray_hit_distance
+// stays correct after apply_offset moves an Area whose ray index is warm.
+
+#include "utils/area.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Original Area::contains_point body, kept as the baseline.
+bool reference_contains(const Area& area, const SDL_Point& pt) {
+    const auto& points = area.get_points();
+    const size_t n = points.size();
+    if (n == 1) {
+        return pt.x == points[0].x && pt.y == points[0].y;
+    }
+    if (n < 3) return false;
+    auto [minx, miny, maxx, maxy] = area.get_bounds();
+    if (pt.x < minx || pt.x > maxx || pt.y < miny || pt.y > maxy) {
+        return false;
+    }
+    bool inside = false;
+    const double x = pt.x;
+    const double y = pt.y;
+    for (size_t i = 0, j = n - 1; i < n; j = i++) {
+        const double xi = points[i].x;
+        const double yi = points[i].y;
+        const double xj = points[j].x;
+        const double yj = points[j].y;
+        const bool intersect = ((yi > y) != (yj > y)) && (x < (xj - xi) * (y - yi) / (yj - yi + 1e-12) + xi);
+        if (intersect) inside = !inside;
+    }
+    return inside;
+}
+
+bool on_boundary(const Area& area, const SDL_Point& pt) {
+    const auto& points = area.get_points();
+    const size_t n = points.size();
+    for (size_t i = 0, j = n - 1; i < n; j = i++) {
+        const long long ax = points[j].x, ay = points[j].y;
+        const long long bx = points[i].x, by = points[i].y;
+        const long long cross = (bx - ax) * (pt.y - ay) - (by - ay) * (pt.x - ax);
+        if (cross != 0) continue;
+        if (pt.x >= std::min(ax, bx) && pt.x <= std::max(ax, bx) &&
+            pt.y >= std::min(ay, by) && pt.y <= std::max(ay, by)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::vector<Area> load_room_areas(const std::string& path) {
+    std::vector<Area> areas;
+    std::ifstream in(path);
+    if (!in) {
+        std::fprintf(stderr, "[area_contains_bench] Failed to open %s\n", path.c_str());
+        return areas;
+    }
+    nlohmann::json data;
+    try {
+        in >> data;
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "[area_contains_bench] Bad JSON in %s: %s\n", path.c_str(), e.what());
+        return areas;
+    }
+
+    const int map_radius = static_cast<int>(data.value("map_radius", 5000.0));
+    const int map_size = map_radius * 2;
+    const SDL_Point center{ map_radius, map_radius };
+    if (data.contains("rooms_data") && data["rooms_data"].is_object()) {
+        for (const auto& [name, room] : data["rooms_data"].items()) {
+            const int w = room.value("max_width", 1000);
+            const int h = room.value("max_height", 1000);
+            const std::string geometry = room.value("geometry", std::string("Square"));
+            const int smooth = room.value("edge_smoothness", 2);
+            try {
+                areas.emplace_back(name, center, w, h, geometry, smooth, map_size, map_size);
+            } catch (const std::exception& e) {
+                std::fprintf(stderr, "[area_contains_bench] Skipping room %s: %s\n", name.c_str(), e.what());
+            }
+        }
+    }
+    // The map boundary is the largest polygon the generator tests against.
+    areas.emplace_back("map_boundary", center, map_size, map_size, "Circle", 100, map_size, map_size);
+    return areas;
+}
+
+// Warms the ray index of a many-vertex circle from one origin, shifts the
+// circle and queries again from the same origin. Every hit must match a fresh
+// Area built from the shifted points, which has no cached index.
+int check_ray_after_offset() {
+    std::mt19937 shape_rng(7);
+    Area moved("ray_offset", SDL_Point{ 1000, 1000 }, 2000, 2000, "Circle", 100, 20000, 20000, shape_rng);
+    const double origin_x = 1000.0;
+    const double origin_y = 1000.0;
+    constexpr int kDirections = 64;
+    for (int i = 0; i < kDirections; ++i) {
+        const double a = 2.0 * 3.14159265358979323846 * i / kDirections;
+        moved.ray_hit_distance(origin_x, origin_y, std::cos(a), std::sin(a));
+    }
+    moved.apply_offset(5000, 0);
+    const Area fresh("ray_offset_fresh", moved.get_points());
+
+    int mismatches = 0;
+    for (int i = 0; i < kDirections; ++i) {
+        const double a = 2.0 * 3.14159265358979323846 * i / kDirections;
+        const double got = moved.ray_hit_distance(origin_x, origin_y, std::cos(a), std::sin(a));
+        const double want = fresh.ray_hit_distance(origin_x, origin_y, std::cos(a), std::sin(a));
+        if (std::fabs(got - want) > 1e-6) {
+            std::fprintf(stderr, "[area_contains_bench] ray %d after offset: got %.3f, want %.3f\n", i, got, want);
+            ++mismatches;
+        }
+    }
+    std::printf("ray_hit_distance after apply_offset: %d mismatches\n", mismatches);
+    return mismatches;
+}
+
+template <typename Fn>
+double time_ms(Fn&& fn) {
+    const auto start = std::chrono::steady_clock::now();
+    fn();
+    const auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+}
+
+int main(int argc, char** argv) {
+    std::string path = "MAPS/FORREST/map_info.json";
+    bool quick = false;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--quick") == 0) {
+            quick = true;
+        } else {
+            path = argv[i];
+        }
+    }
+
+    std::vector<Area> areas = load_room_areas(path);
+    if (areas.empty()) {
+        return 1;
+    }
+
+    const std::size_t samples = quick ? 20000 : 1000000;
+    const int rounds = quick ? 1 : 10;
+    std::mt19937 rng(1234);
+
+    int mismatches = 0;
+    for (const Area& area : areas) {
+        auto [minx, miny, maxx, maxy] = area.get_bounds();
+        const int pad_x = (maxx - minx) / 4 + 1;
+        const int pad_y = (maxy - miny) / 4 + 1;
+        std::uniform_int_distribution<int> dx(minx - pad_x, maxx + pad_x);
+        std::uniform_int_distribution<int> dy(miny - pad_y, maxy + pad_y);
+        std::vector<SDL_Point> pts(samples);
+        for (auto& p : pts) {
+            p = SDL_Point{ dx(rng), dy(rng) };
+        }
+
+        std::vector<std::uint8_t> expected(samples);
+        std::vector<std::uint8_t> single(samples);
+        std::vector<std::uint8_t> batched;
+
+        const double ref_ms = time_ms([&] {
+            for (int r = 0; r < rounds; ++r)
+                for (std::size_t i = 0; i < samples; ++i) expected[i] = reference_contains(area, pts[i]) ? 1 : 0;
+        });
+        const double single_ms = time_ms([&] {
+            for (int r = 0; r < rounds; ++r)
+                for (std::size_t i = 0; i < samples; ++i) single[i] = area.contains_point(pts[i]) ? 1 : 0;
+        });
+        const double batch_ms = time_ms([&] {
+            for (int r = 0; r < rounds; ++r) area.contains_points(pts.data(), pts.size(), batched);
+        });
+
+        int area_mismatches = 0;
+        int boundary_diffs = 0;
+        for (std::size_t i = 0; i < samples; ++i) {
+            if (single[i] != batched[i]) {
+                ++area_mismatches;
+            } else if (single[i] != expected[i]) {
+                if (on_boundary(area, pts[i])) {
+                    ++boundary_diffs;
+                } else {
+                    ++area_mismatches;
+                }
+            }
+        }
+        mismatches += area_mismatches;
+
+        std::printf("%-14s %4zu edges  reference %8.2f ms  contains_point %8.2f ms  contains_points %8.2f ms  on-edge diffs %d  mismatches %d\n",
+                    area.get_name().c_str(),
+                    area.get_points().size(),
+                    ref_ms,
+                    single_ms,
+                    batch_ms,
+                    boundary_diffs,
+                    area_mismatches);
+    }
+    mismatches += check_ray_after_offset();
+    return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,177 @@
+// Golden-image tests for the GenerateLight pixel kernel. The reference below is
+// the original per-pixel loop (atan2, per-ray fmod and pow for every pixel);
+// LightKernel must reproduce it to within table-interpolation error, and must
+// produce identical bytes for any worker count.
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest/doctest.h"
+
+#include "utils/light_kernel.hpp"
+
+#include <SDL.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+namespace {
+
+constexpr float kPi = 3.14159265358979323846f;
+
+// Original GenerateLight::generate body, writing RGBA32 bytes directly.
+std::vector<Uint8> reference_light(const LightKernelParams& p, const std::vector<LightRay>& rays) {
+    const int radius    = p.radius;
+    const int falloff   = std::clamp(p.falloff, 0, 100);
+    const int intensity = std::clamp(p.intensity, 0, 255);
+    const SDL_Color col = p.color;
+    const int size = std::max(1, radius * 2);
+    std::vector<Uint8> out(static_cast<std::size_t>(size) * size * 4, 0);
+    float falloff_norm = std::clamp(static_cast<float>(falloff) / 100.0f, 0.0f, 1.0f);
+    float falloff_ratio = 1.0f - falloff_norm;
+    float fade_exponent = 0.6f + 3.4f * falloff_norm;
+    float white_core_ratio  = 0.2f + falloff_ratio * 0.6f;
+    float white_core_radius = static_cast<float>(radius) * white_core_ratio;
+    float radius_f = static_cast<float>(radius);
+    float radius_sq = radius_f * radius_f;
+    float inv_radius = 1.0f / radius_f;
+    for (int y = 0; y < size; ++y) {
+        for (int x = 0; x < size; ++x) {
+            float dx = x - radius + 0.5f;
+            float dy = y - radius + 0.5f;
+            float dist_sq = dx * dx + dy * dy;
+            if (dist_sq > radius_sq) continue;
+            float dist = std::sqrt(dist_sq);
+            float angle = std::atan2(dy, dx);
+            float ray_boost = 1.0f;
+            for (const auto& rs : rays) {
+                float diff = std::fabs(angle - rs.angle);
+                diff = std::fmod(diff + 2.0f * kPi, 2.0f * kPi);
+                if (diff > kPi) diff = 2.0f * kPi - diff;
+                if (diff < rs.spread) {
+                    ray_boost += (1.0f - (diff / rs.spread)) * 0.05f;
+                }
+            }
+            ray_boost = std::clamp(ray_boost, 1.0f, 1.1f);
+            float base_gradient = std::max(0.0f, 1.0f - (dist * inv_radius));
+            float alpha_ratio  = std::pow(base_gradient, fade_exponent);
+            alpha_ratio = std::clamp(alpha_ratio * ray_boost, 0.0f, 1.0f);
+            Uint8 alpha = static_cast<Uint8>(std::min(255.0f, intensity * alpha_ratio * 1.6f));
+            Uint8 core_r = static_cast<Uint8>((255 + col.r) / 2);
+            Uint8 core_g = static_cast<Uint8>((255 + col.g) / 2);
+            Uint8 core_b = static_cast<Uint8>((255 + col.b) / 2);
+            Uint8* px = &out[(static_cast<std::size_t>(y) * size + x) * 4];
+            if (dist <= white_core_radius) {
+                px[0] = core_r;
+                px[1] = core_g;
+                px[2] = core_b;
+            } else {
+                float t = (dist - white_core_radius) / std::max(1e-6f, (radius - white_core_radius));
+                px[0] = static_cast<Uint8>((1.0f - t) * core_r + t * col.r);
+                px[1] = static_cast<Uint8>((1.0f - t) * core_g + t * col.g);
+                px[2] = static_cast<Uint8>((1.0f - t) * core_b + t * col.b);
+            }
+            px[3] = alpha;
+        }
+    }
+    return out;
+}
+
+std::vector<Uint8> kernel_light(const LightKernelParams& p, const std::vector<LightRay>& rays, unsigned workers) {
+    const int size = LightKernel::size_for(p.radius);
+    std::vector<Uint8> out(static_cast<std::size_t>(size) * size * 4, 0xCD);
+    LightKernel::render(p, rays, out.data(), size * 4, workers);
+    return out;
+}
+
+LightKernelParams make_params(int radius, int falloff, int intensity, SDL_Color color) {
+    LightKernelParams p;
+    p.radius    = radius;
+    p.falloff   = falloff;
+    p.intensity = intensity;
+    p.color     = color;
+    return p;
+}
+
+const std::vector<LightRay>& fixed_rays() {
+    static const std::vector<LightRay> rays = {
+        { 0.30f, 0.45f }, { 1.90f, 0.25f }, { 2.05f, 0.55f },
+        { 3.60f, 0.20f }, { 5.10f, 0.38f }, { 6.20f, 0.59f },
+    };
+    return rays;
+}
+
+struct Diff {
+    int max_channel = 0;
+    std::size_t differing = 0;
+};
+
+Diff compare(const std::vector<Uint8>& a, const std::vector<Uint8>& b) {
+    Diff d;
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        const int delta = std::abs(static_cast<int>(a[i]) - static_cast<int>(b[i]));
+        d.max_channel = std::max(d.max_channel, delta);
+        if (delta != 0) ++d.differing;
+    }
+    return d;
+}
+
+} // namespace
+
+TEST_CASE("Light kernel matches the original per-pixel loop") {
+    const LightKernelParams cases[] = {
+        make_params(1,   50, 200, SDL_Color{ 255, 200, 120, 255 }),
+        make_params(7,    0, 255, SDL_Color{ 255, 255, 255, 255 }),
+        make_params(40,  35, 180, SDL_Color{ 255, 180,  90, 255 }),
+        make_params(96, 100, 255, SDL_Color{  80, 140, 255, 255 }),
+        make_params(150, 70,  64, SDL_Color{   0, 255,  40, 255 }),
+    };
+    for (const LightKernelParams& p : cases) {
+        CAPTURE(p.radius);
+        CAPTURE(p.falloff);
+        const std::vector<Uint8> expected = reference_light(p, fixed_rays());
+        const std::vector<Uint8> actual   = kernel_light(p, fixed_rays(), 1);
+        REQUIRE(expected.size() == actual.size());
+        const Diff d = compare(expected, actual);
+        CHECK(d.max_channel <= 1);
+        CHECK(d.differing * 100 <= expected.size());
+    }
+}
+
+TEST_CASE("Light kernel handles lights without rays and degenerate radii") {
+    const std::vector<LightRay> no_rays;
+    for (int radius : { 0, 1, 2, 33 }) {
+        CAPTURE(radius);
+        const LightKernelParams p = make_params(radius, 20, 255, SDL_Color{ 255, 255, 255, 255 });
+        const std::vector<Uint8> actual = kernel_light(p, no_rays, 1);
+        if (radius == 0) {
+            CHECK(actual == std::vector<Uint8>(4, 0));
+            continue;
+        }
+        CHECK(compare(reference_light(p, no_rays), actual).max_channel <= 1);
+    }
+}
+
+TEST_CASE("Light kernel output does not depend on the worker count") {
+    const LightKernelParams p = make_params(130, 45, 220, SDL_Color{ 255, 160, 60, 255 });
+    const std::vector<Uint8> single = kernel_light(p, fixed_rays(), 1);
+    for (unsigned workers : { 2u, 3u, 8u, 0u }) {
+        CAPTURE(workers);
+        CHECK(kernel_light(p, fixed_rays(), workers) == single);
+    }
+}
+
+TEST_CASE("Light kernel respects the row pitch") {
+    const LightKernelParams p = make_params(20, 50, 200, SDL_Color{ 255, 220, 180, 255 });
+    const int size  = LightKernel::size_for(p.radius);
+    const int pitch = size * 4 + 12;
+    std::vector<Uint8> padded(static_cast<std::size_t>(pitch) * size, 0xAB);
+    LightKernel::render(p, fixed_rays(), padded.data(), pitch, 4);
+    const std::vector<Uint8> tight = kernel_light(p, fixed_rays(), 1);
+    for (int y = 0; y < size; ++y) {
+        CAPTURE(y);
+        const Uint8* row = padded.data() + static_cast<std::size_t>(y) * pitch;
+        CHECK(std::equal(row, row + size * 4, tight.begin() + static_cast<std::ptrdiff_t>(y) * size * 4));
+        CHECK(std::all_of(row + size * 4, row + pitch, [](Uint8 b) { return b == 0xAB; }));
+    }
+}